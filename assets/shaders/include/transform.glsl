@@ -0,0 +1,7 @@
+// model-view-projection matrix, uploaded row major as sb::Matrix4
+uniform mat4 mvp;
+
+vec4 transform(vec3 position)
+{
+    return vec4(position.xyz, 1.0) * mvp;
+}
@@ -0,0 +1,21 @@
+#version 330 core
+
+// permutations: VERTEX_COLOR, TEXTURED
+
+out vec4 fragColor;
+
+in vec4 vertex_color;
+in vec2 texture_coords;
+
+#ifdef TEXTURED
+uniform sampler2D texture_data;
+#endif
+
+void main()
+{
+#ifdef TEXTURED
+    fragColor = texture(texture_data, texture_coords) * vertex_color;
+#else
+    fragColor = vertex_color;
+#endif
+}
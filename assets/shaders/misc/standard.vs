@@ -0,0 +1,29 @@
+#version 330 core
+
+// permutations: VERTEX_COLOR, TEXTURED
+
+#include "include/transform.glsl"
+
+layout (location = 0) in vec3 position;
+layout (location = 2) in vec3 color;
+layout (location = 3) in vec2 uv_coords;
+
+out vec4 vertex_color;
+out vec2 texture_coords;
+
+void main()
+{
+    gl_Position = transform(position);
+
+#ifdef VERTEX_COLOR
+    vertex_color = vec4(color, 1.0);
+#else
+    vertex_color = vec4(1.0);
+#endif
+
+#ifdef TEXTURED
+    texture_coords = uv_coords;
+#else
+    texture_coords = vec2(0.0);
+#endif
+}
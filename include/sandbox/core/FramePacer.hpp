@@ -0,0 +1,94 @@
+/** @file FramePacer.hpp
+ *  @brief Frame rate limiter for the main loop of a window.
+ *
+ *  With a swap interval (GLX_EXT_swap_control or GLX_MESA_swap_control),
+ *  the buffer swap waits for the vertical blank and the pacer does not wait.
+ *  Otherwise, frames start at absolute deadlines, one period apart, so the
+ *  errors do not accumulate: the pacer sleeps until shortly before the
+ *  deadline, by the overshoot measured on the previous sleeps, and spins
+ *  for the rest.
+ *
+ *  While the window is not focused, frames are throttled to a low rate
+ *  instead of spinning.
+ *
+ *  Example:
+ *  FramePacer pacer(&window);
+ *  if (!pacer.setSwapInterval(1))
+ *      pacer.setTargetFPS(60);
+ *  while (running)
+ *  {
+ *      if (!pacer.wait())
+ *          continue;
+ *      ...
+ *  }
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+#include <sandbox/core/Window.hpp>
+
+namespace sb
+{
+    class FramePacer
+    {
+    public:
+
+        /*!
+            @brief Constructor.
+
+            @param window Window whose frames are paced. Its OpenGL context must be current.
+            @param target_fps Frame rate of the software pacing. If 0, frames are not limited.
+        */
+        FramePacer(Window* window, real target_fps = 0);
+
+        /*!
+            @brief Set the number of vertical blanks between buffer swaps.
+
+            @param interval Swap interval: 0 disables vsync, 1 swaps at the refresh rate.
+            @return False if the extensions are not available: frames are paced in software.
+        */
+        bool setSwapInterval(int interval);
+
+        //! Return the swap interval set, 0 if none.
+        int swapInterval() const;
+
+        //! Set the frame rate of the software pacing. If 0, frames are not limited.
+        void setTargetFPS(real fps);
+
+        //! Set the frame rate while the window is not focused. Default is 10.
+        void setIdleFPS(real fps);
+
+        /*!
+            @brief Wait for the start of the next frame.
+
+            @return False if the window is not focused: the frame should be skipped.
+        */
+        bool wait();
+
+        //! Return the average delay of the wake ups after a sleep, in nanoseconds.
+        ulong overshoot() const;
+
+    private:
+
+        //! Sleep and spin until the deadline (system time, in nanoseconds).
+        void waitUntil(ulong deadline);
+
+        //! Paced window.
+        Window* _window;
+
+        //! Swap interval set through GLX.
+        int _swap_interval;
+
+        //! Frame periods in nanoseconds, 0 if not limited.
+        ulong _period;
+        ulong _idle_period;
+
+        //! Deadline of the next frame, 0 if not set.
+        ulong _deadline;
+
+        //! Exponential average of the sleep overshoot, in nanoseconds.
+        double _overshoot;
+    };
+}
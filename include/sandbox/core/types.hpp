@@ -7,10 +7,11 @@
 
 namespace sb
 {
-    using uint  = unsigned int;
-    using ulong = unsigned long;
-    using uchar = unsigned char;
-    using byte  = uchar;
+    using ushort = unsigned short;
+    using uint   = unsigned int;
+    using ulong  = unsigned long;
+    using uchar  = unsigned char;
+    using byte   = uchar;
 
 #ifdef __DOUBLE_PRECISION
     using real = double;
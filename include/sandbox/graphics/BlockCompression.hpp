@@ -0,0 +1,65 @@
+/** @file BlockCompression.hpp
+ *  @brief CPU encoder for BC1, BC3 and BC5 compressed textures.
+ *
+ *  Block compressed formats split the image in 4x4 pixel blocks and store
+ *  each block in a fixed number of bytes, so the GPU samples them directly:
+ *  - BC1 (GL_COMPRESSED_RGB_S3TC_DXT1_EXT): RGB, 8 bytes per block (4 bits per pixel)
+ *  - BC3 (GL_COMPRESSED_RGBA_S3TC_DXT5_EXT): RGBA, 16 bytes per block (8 bits per pixel)
+ *  - BC5 (GL_COMPRESSED_RG_RGTC2): two independent channels, 16 bytes per block,
+ *    suited for tangent space normal maps (z is reconstructed in the shader)
+ *
+ *  Endpoints are the bounding box of the block colors, slightly inset,
+ *  and each pixel is assigned to the nearest palette entry by projection
+ *  on the endpoints axis. Bounding box and projections are computed with SSE2.
+ *
+ *  References
+ *  https://registry.khronos.org/OpenGL/extensions/EXT/EXT_texture_compression_s3tc.txt
+ *  https://registry.khronos.org/OpenGL/extensions/ARB/ARB_texture_compression_rgtc.txt
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace sb
+{
+    //! Return true if the format is one of the supported block compressed formats.
+    bool isCompressed(uint format);
+
+    //! Return the size in bytes of a 4x4 block of the compressed format.
+    uint blockSize(uint format);
+
+    //! Return the size in bytes of an image in the compressed format.
+    size_t compressedSize(uint width, uint height, uint format);
+
+    //! Encode a block of 16 RGBA pixels (row by row) as BC1. Alpha is ignored.
+    void encodeBC1(const uchar* block, uchar* dst);
+
+    //! Encode one channel of a block of 16 RGBA pixels (row by row) as BC4. It is the alpha block of BC3 and each half of BC5.
+    void encodeBC4(const uchar* block, uint channel, uchar* dst);
+
+    //! Encode a block of 16 RGBA pixels (row by row) as BC3.
+    void encodeBC3(const uchar* block, uchar* dst);
+
+    //! Encode the red and green channels of a block of 16 RGBA pixels (row by row) as BC5.
+    void encodeBC5(const uchar* block, uchar* dst);
+
+    /*!
+        @brief Compress an image.
+
+        Images whose size is not a multiple of 4 are padded by replicating the border pixels.
+
+        @param pixels Pixel values, row by row.
+        @param width Width of the image in pixels.
+        @param height Height of the image in pixels.
+        @param channels Number of channels (3 = RGB, 4 = RGBA).
+        @param row_size Size in bytes of a row of pixels, including padding.
+        @param format Compressed format (see 'isCompressed').
+
+        @return Compressed blocks, row by row.
+    */
+    std::vector<uchar> compress(const uchar* pixels, uint width, uint height, uint channels, uint row_size, uint format);
+}
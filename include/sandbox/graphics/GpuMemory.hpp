@@ -0,0 +1,72 @@
+/** @file GpuMemory.hpp
+ *  @brief Account the video memory allocated by the engine.
+ *
+ *  GL does not report how much memory its objects use. Each resource
+ *  computes the size of its own storage (eg. a texture sums all its
+ *  mipmap levels) and registers it here, split by category.
+ *
+ *  Sizes are estimates of the driver allocations: RGB8 textures are
+ *  counted as RGBA8, since drivers pad them to 4 bytes per pixel.
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+#include <cstddef>
+#include <atomic>
+
+namespace sb
+{
+    class GpuMemory
+    {
+    public:
+
+        //! Texture storage, mipmaps included.
+        static const uint TEXTURES = 0;
+
+        //! Static vertex and element buffers.
+        static const uint BUFFERS = 1;
+
+        //! Streaming buffers, all the frames in flight included.
+        static const uint STREAMING = 2;
+
+        //! Number of categories.
+        static const uint CATEGORIES = 3;
+
+        //! Register a new allocation.
+        static void allocate(uint category, size_t bytes);
+
+        //! Register a released allocation.
+        static void release(uint category, size_t bytes);
+
+        //! Return the memory currently allocated in a category, in bytes.
+        static size_t used(uint category);
+
+        //! Return the memory currently allocated, in bytes.
+        static size_t used();
+
+        //! Return the highest memory ever allocated, in bytes.
+        static size_t peak();
+
+        /*!
+            @brief Compute the size of a 2D texture storage.
+
+            @param width Width of the first level in pixels.
+            @param height Height of the first level in pixels.
+            @param num_levels Number of mipmap levels.
+            @param internal_format Sized internal format (eg. GL_RGBA8) or compressed format.
+
+            @return Size of all the levels in bytes.
+        */
+        static size_t textureSize(uint width, uint height, uint num_levels, int internal_format);
+
+    private:
+
+        //! Memory allocated in each category.
+        static std::atomic<size_t> _used[CATEGORIES];
+
+        //! Highest total memory allocated.
+        static std::atomic<size_t> _peak;
+    };
+}
@@ -0,0 +1,111 @@
+/** @file Overlay.hpp
+ *  @brief Performance overlay drawn over the window content.
+ *
+ *  The overlay shows the frame rate and frame time percentiles of the
+ *  rolling window of a FrameStats, the RenderStats counters of the last
+ *  frame and a graph of the recent frame times (green within 60 fps,
+ *  yellow within 30 fps, red beyond).
+ *
+ *  Text uses a built-in 5x7 bitmap font (digits, uppercase letters and a
+ *  few symbols): glyph rows are drawn as colored quads, so the whole overlay
+ *  is a single streamed draw call, without textures.
+ *
+ *  Example:
+ *  Overlay overlay(&window);
+ *  while (running)
+ *  {
+ *      if (input.isKeyPressed(KEY_F1))
+ *          overlay.toggle();
+ *      ...
+ *      overlay.draw(frame_stats);
+ *      RenderStats::frame();
+ *  }
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+#include <sandbox/core/Window.hpp>
+#include <sandbox/graphics/Shader.hpp>
+#include <sandbox/graphics/StreamBuffer.hpp>
+#include <sandbox/graphics/VAO.hpp>
+#include <sandbox/utils/FrameStats.hpp>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace sb
+{
+    class Overlay
+    {
+    public:
+
+        /*!
+            @brief Constructor. Create the GL objects: the OpenGL context must be current.
+
+            @param window Window where the overlay is drawn.
+        */
+        Overlay(Window* window);
+
+        Overlay(const Overlay&) = delete;
+        Overlay& operator=(const Overlay&) = delete;
+
+        //! Show or hide the overlay. Default is visible.
+        void setVisible(bool visible);
+
+        //! Return true if the overlay is visible.
+        bool visible() const;
+
+        //! Switch the overlay visibility.
+        void toggle();
+
+        //! Set the size of a font pixel, in screen pixels. Default is 2.
+        void setScale(uint scale);
+
+        /*!
+            @brief Draw the overlay, if visible, over the current frame.
+
+            The overlay draw call is counted by RenderStats, like the others.
+
+            @param stats Frame times to show.
+        */
+        void draw(const utils::FrameStats& stats);
+
+    private:
+
+        //! Vertex of the overlay quads: position in pixels from the top-left corner and color.
+        struct Vertex
+        {
+            float x;
+            float y;
+            uint color;
+        };
+
+        //! Add a rectangle. Color is RGBA, red in the lowest byte.
+        void rect(float x, float y, float width, float height, uint color);
+
+        //! Add a line of text. Lowercase letters are drawn uppercase, unknown characters as spaces.
+        void text(float x, float y, std::string_view str, uint color);
+
+        //! Window where the overlay is drawn.
+        Window* _window;
+
+        //! True if the overlay is drawn.
+        bool _visible;
+
+        //! Size of a font pixel.
+        uint _scale;
+
+        //! Quads of the current frame, two triangles each.
+        std::vector<Vertex> _vertices;
+
+        //! Frame times of the graph, reused between frames.
+        std::vector<ulong> _frames;
+
+        //! Program, streamed vertices and their layout.
+        std::unique_ptr<Shader> _shader;
+        StreamBuffer _buffer;
+        std::unique_ptr<VAO> _vao;
+    };
+}
@@ -0,0 +1,103 @@
+/** @file RenderStats.hpp
+ *  @brief Count the GL work issued by the engine each frame.
+ *
+ *  VAO, Shader, Texture and the buffers increment the counters of the
+ *  current frame; frame() closes it, so the totals of the last complete
+ *  frame can be read (eg. by Overlay) while the next one is counted.
+ *
+ *  Counters are plain integers: like every GL call, they must be updated
+ *  by the thread which owns the context.
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+
+namespace sb
+{
+    class RenderStats
+    {
+    public:
+
+        //! Draw calls.
+        static const uint DRAW_CALLS = 0;
+
+        //! Triangles drawn, instances included.
+        static const uint TRIANGLES = 1;
+
+        //! Changes of the program in use.
+        static const uint PROGRAM_SWITCHES = 2;
+
+        //! Changes of the texture bound to a unit.
+        static const uint TEXTURE_SWITCHES = 3;
+
+        //! Uniform values set. Names without a location in the program are not counted.
+        static const uint UNIFORM_UPLOADS = 4;
+
+        //! Bytes copied into vertex, element and pixel buffers.
+        static const uint BUFFER_BYTES = 5;
+
+        //! Number of counters.
+        static const uint COUNTERS = 6;
+
+        //! Add a value to a counter of the current frame.
+        static void add(uint counter, ulong value = 1)
+        {
+            _current[counter] += value;
+        }
+
+        //! Register the program in use: counted only if it changes.
+        static void useProgram(uint program)
+        {
+            if (program != _program)
+                ++_current[PROGRAM_SWITCHES];
+            _program = program;
+        }
+
+        //! Register the texture bound to a unit, made active first (glActiveTexture): counted only if it changes.
+        static void bindTexture(uint unit, uint texture)
+        {
+            if (unit >= TEXTURE_UNITS || texture != _textures[unit])
+                ++_current[TEXTURE_SWITCHES];
+            if (unit < TEXTURE_UNITS)
+                _textures[unit] = texture;
+            _active_unit = unit;
+        }
+
+        //! Register the texture bound to the active unit without selecting one (eg. to upload its pixels).
+        static void bindTexture(uint texture)
+        {
+            bindTexture(_active_unit, texture);
+        }
+
+        //! Register a deleted texture: GL unbinds it from every unit, and its name can be reused.
+        static void deleteTexture(uint texture);
+
+        //! Close the current frame: its totals become the last ones and the counters restart from 0.
+        static void frame();
+
+        //! Return a counter of the last complete frame.
+        static ulong last(uint counter);
+
+        //! Return a counter of the current frame, so far.
+        static ulong current(uint counter);
+
+        //! Return the display name of a counter.
+        static const char* name(uint counter);
+
+    private:
+
+        //! Texture units whose bindings are tracked.
+        static const uint TEXTURE_UNITS = 32;
+
+        //! Counters of the current frame and of the last complete one.
+        static ulong _current[COUNTERS];
+        static ulong _last[COUNTERS];
+
+        //! Program in use, textures bound and active unit, to count the changes only.
+        static uint _program;
+        static uint _textures[TEXTURE_UNITS];
+        static uint _active_unit;
+    };
+}
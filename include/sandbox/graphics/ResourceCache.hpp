@@ -0,0 +1,119 @@
+/** @file ResourceCache.hpp
+ *  @brief Share GPU resources loaded from identical assets.
+ *
+ *  Resources are returned as shared handles: the GL object is deleted
+ *  when the last handle is released, and the cache only keeps weak
+ *  references, so it never extends the lifetime of a resource.
+ *
+ *  Requests are resolved in two steps:
+ *  - the canonical path of the asset (plus the loading parameters) is looked up first,
+ *    so repeated requests of the same file do not touch the disk;
+ *  - otherwise, the file content is hashed and looked up, so identical files
+ *    in different folders share the same GL object.
+ *
+ *  Vertex data has no path: VAOs are looked up by content hash only.
+ *
+ *  The cache must be used by the thread owning the GL context.
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/graphics/Texture.hpp>
+#include <sandbox/graphics/Shader.hpp>
+#include <sandbox/graphics/VAO.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace sb
+{
+    class ResourceCache
+    {
+    public:
+
+        /*!
+            @brief Get a texture, loading it on first use.
+
+            Parameters are the same of the Texture constructor.
+            Textures which fail to load are returned (with their placeholder) but not cached.
+        */
+        std::shared_ptr<Texture> texture(const std::string& filename, int format = GL_RGB, bool flip = false, int wrap_s_mode = GL_REPEAT, int wrap_t_mode = GL_REPEAT, int min_filter_mode = GL_LINEAR_MIPMAP_LINEAR, int max_filter_mode = GL_LINEAR);
+
+        /*!
+            @brief Get a shader program, compiling it on first use.
+
+            @param vertex_shader_filename Complete path to the vertex shader text file.
+            @param fragment_shader_filename Complete path to the fragment shader text file.
+
+            @return Shared handle to the program. Null if not valid.
+        */
+        std::shared_ptr<Shader> shader(const std::string& vertex_shader_filename, const std::string& fragment_shader_filename);
+
+        /*!
+            @brief Get a VAO, uploading the model data on first use.
+
+            Parameters are the same of the VAO constructor.
+        */
+        std::shared_ptr<VAO> vao(const void* vertices, size_t size, const VertexLayout& layout, const std::vector<uint>& indices = {});
+
+        /*!
+            @brief Get a VAO, uploading the model data on first use.
+
+            Parameters are the same of the VAO constructor.
+        */
+        std::shared_ptr<VAO> vao(const std::vector<real>& vertices, const std::vector<uint>& indices = {}, uint stride = 3);
+
+        //! Remove the entries of the resources which have been released.
+        void purge();
+
+        //! Return the number of textures alive.
+        uint textures() const;
+
+        //! Return the number of shader programs alive.
+        uint shaders() const;
+
+        //! Return the number of VAOs alive.
+        uint vaos() const;
+
+    private:
+
+        /*!
+            @brief Build the path key of an asset.
+
+            @param filename Path to the asset file.
+            @param params Loading parameters, appended to the canonical path.
+
+            @return Canonical path of the file followed by the parameters.
+        */
+        static std::string pathKey(const std::string& filename, const std::string& params);
+
+        /*!
+            @brief Look up a resource by key, dropping the entry if it has been released.
+
+            @param resources Map of the cached resources.
+            @param key Key of the resource.
+
+            @return Shared handle to the resource. Null if not cached.
+        */
+        template <typename T>
+        static std::shared_ptr<T> find(std::unordered_map<ulong, std::weak_ptr<T>>& resources, ulong key);
+
+        //! Count the resources still alive.
+        template <typename T>
+        static uint alive(const std::unordered_map<ulong, std::weak_ptr<T>>& resources);
+
+        //! Content key of each requested path key.
+        std::unordered_map<std::string, ulong> _paths;
+
+        //! Textures, by content hash and loading parameters.
+        std::unordered_map<ulong, std::weak_ptr<Texture>> _textures;
+
+        //! Shader programs, by content hash of the sources.
+        std::unordered_map<ulong, std::weak_ptr<Shader>> _shaders;
+
+        //! VAOs, by content hash of the model data and layout.
+        std::unordered_map<ulong, std::weak_ptr<VAO>> _vaos;
+    };
+}
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <sandbox/math/Vector.hpp>
 #include <sandbox/math/Matrix.hpp>
 
@@ -19,6 +20,7 @@ namespace sb
             @brief Static constructor-like function.
 
             Return a pointer to a shader program if vertex/fragment shaders compile.
+            Files are memory mapped and their content is passed to the driver without copies.
 
             @param vertex_shader_filename Complete path to the vertex shader text file.
             @param fragment_shader_filename Complete path to the fragment shader text file.
@@ -26,6 +28,19 @@ namespace sb
             @return Pointer to a valid Shader object. Nullptr if not valid.
         */
         static Shader* create(const std::string& vertex_shader_filename, const std::string& fragment_shader_filename);
+
+        /*!
+            @brief Static constructor-like function.
+
+            Return a pointer to a shader program if vertex/fragment shaders compile.
+
+            @param vertex_shader_text GLSL source code of the vertex shader.
+            @param fragment_shader_text GLSL source code of the fragment shader.
+
+            @return Pointer to a valid Shader object. Nullptr if not valid.
+        */
+        static Shader* createFromSource(std::string_view vertex_shader_text, std::string_view fragment_shader_text);
+
         ~Shader();
 
         //! Return shader unique id.
@@ -53,6 +68,8 @@ namespace sb
         /*!
             @brief Set float uniform value. If named uniform does not exist, do nothing.
 
+            Value is uploaded in single precision.
+
             @param name Name of the uniform variable to be set.
             @param value New value of the named uniform.
         */
@@ -64,7 +81,17 @@ namespace sb
             @param name Name of the uniform variable to be set.
             @param v New vector of the named uniform.
         */
-        void setVector(const std::string& name, const Vector& v) const;
+        void setVector(const std::string& name, const VectorT<float>& v) const;
+
+        /*!
+            @brief Set vector uniform value. If named uniform does not exist, do nothing.
+
+            Values are narrowed and uploaded in single precision.
+
+            @param name Name of the uniform variable to be set.
+            @param v New vector of the named uniform.
+        */
+        void setVector(const std::string& name, const VectorT<double>& v) const;
 
         /*!
             @brief Set matrix uniform value. If named uniform does not exist, do nothing.
@@ -72,13 +99,75 @@ namespace sb
             @param name Name of the uniform variable to be set.
             @param m New matrix value of the named uniform.
         */
-        void setMatrix(const std::string& name, const Matrix& m) const;
+        void setMatrix(const std::string& name, const MatrixT<float>& m) const;
+
+        /*!
+            @brief Set matrix uniform value. If named uniform does not exist, do nothing.
+
+            Values are narrowed and uploaded in single precision.
+
+            @param name Name of the uniform variable to be set.
+            @param m New matrix value of the named uniform.
+        */
+        void setMatrix(const std::string& name, const MatrixT<double>& m) const;
 
     private:
 
+        friend class ShaderBatch;
+
         //! Default constructor.
         Shader() = default;
 
+        /*!
+            @brief Create a shader object and submit its source to the driver.
+
+            Compile status is not queried, so the call returns as soon as
+            the driver has accepted the work.
+
+            @param type Shader stage (eg. GL_VERTEX_SHADER, GL_FRAGMENT_SHADER).
+            @param source GLSL source code of the stage.
+
+            @return Unique id of the shader object.
+        */
+        static uint compile(uint type, std::string_view source);
+
+        /*!
+            @brief Query the compile status of a shader object and log its info log on failure.
+
+            @param shader Unique id of the shader object.
+            @param stage Human readable name of the stage, used in the log message.
+
+            @return True if the shader compiled successfully.
+        */
+        static bool compiled(uint shader, const std::string& stage);
+
+        /*!
+            @brief Query the link status of a program object and log its info log on failure.
+
+            @param program Unique id of the program object.
+
+            @return True if the program linked successfully.
+        */
+        static bool linked(uint program);
+
+        /*!
+            @brief Upload a vector uniform in single precision.
+
+            @param name Name of the uniform variable to be set.
+            @param value New vector of the named uniform.
+        */
+        template <typename T>
+        void uploadVector(const std::string& name, const VectorT<T>& value) const;
+
+        /*!
+            @brief Upload a matrix uniform in single precision.
+
+            @param name Name of the uniform variable to be set.
+            @param value New matrix value of the named uniform.
+        */
+        template <typename T>
+        void uploadMatrix(const std::string& name, const MatrixT<T>& value) const;
+
         //! Unique id of the shader program.
         uint _shader_program{0};
     };
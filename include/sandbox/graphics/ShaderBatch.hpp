@@ -0,0 +1,102 @@
+/** @file ShaderBatch.hpp
+ *  @brief Submit many shader programs at once and collect them later.
+ *
+ *  Shader::create compiles and links a program synchronously: every
+ *  status query stalls the calling thread until the driver is done.
+ *  A batch issues all the compile and link commands up front and defers
+ *  the status queries, so the driver can work in background while the
+ *  application loads other assets.
+ *
+ *  When GL_KHR_parallel_shader_compile is available, the driver is asked
+ *  to use all its compiler threads and the completion status of each
+ *  program can be polled without blocking.
+ *
+ *  References
+ *  https://registry.khronos.org/OpenGL/extensions/KHR/KHR_parallel_shader_compile.txt
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/graphics/Shader.hpp>
+#include <string>
+#include <vector>
+
+namespace sb
+{
+    class ShaderBatch
+    {
+    public:
+
+        //! Handle to a program submitted to the batch.
+        using Handle = uint;
+
+        //! Constructor. Enable driver side parallel compilation, if supported.
+        ShaderBatch();
+
+        //! Destructor. Delete all the programs which have not been retrieved.
+        ~ShaderBatch();
+
+        ShaderBatch(const ShaderBatch&) = delete;
+        ShaderBatch& operator=(const ShaderBatch&) = delete;
+
+        /*!
+            @brief Submit a vertex/fragment shader program.
+
+            Shader sources are loaded from disk, then compile and link
+            commands are issued without waiting for the result.
+
+            @param vertex_shader_filename Complete path to the vertex shader text file.
+            @param fragment_shader_filename Complete path to the fragment shader text file.
+
+            @return Handle to retrieve the program once linked.
+        */
+        Handle add(const std::string& vertex_shader_filename, const std::string& fragment_shader_filename);
+
+        /*!
+            @brief Check whether a program has been linked, without blocking.
+
+            If parallel compilation is not supported, the driver cannot be
+            polled and the program is always reported as ready.
+
+            @param handle Handle returned by 'add'.
+        */
+        bool ready(Handle handle) const;
+
+        //! Check whether all the submitted programs have been linked, without blocking.
+        bool ready() const;
+
+        /*!
+            @brief Retrieve a submitted program.
+
+            Blocks the calling thread if the program has not been linked yet.
+            Compile and link errors are written in the log.
+            Each handle can be retrieved only once.
+
+            @param handle Handle returned by 'add'.
+
+            @return Pointer to a valid Shader object. Nullptr if not valid.
+        */
+        Shader* get(Handle handle);
+
+        //! Return the number of submitted programs.
+        uint size() const;
+
+    private:
+
+        //! GL objects of a submitted program.
+        struct Program
+        {
+            uint vertex_shader{0};
+            uint fragment_shader{0};
+            uint program{0};
+            bool retrieved{false};
+        };
+
+        //! Submitted programs, indexed by handle.
+        std::vector<Program> _programs;
+
+        //! True if completion status can be polled (GL_KHR_parallel_shader_compile).
+        bool _parallel{false};
+    };
+}
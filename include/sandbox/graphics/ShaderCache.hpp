@@ -0,0 +1,69 @@
+/** @file ShaderCache.hpp
+ *  @brief Lazily compiled shader permutations.
+ *
+ *  Shader programs are requested by source files and define sets.
+ *  Each requested variant is preprocessed and compiled the first time
+ *  it is used; later requests return the same program.
+ *  Programs are keyed by the expanded sources, which start with the
+ *  requested defines: only requests with the same define set (or the
+ *  same sources, eg. through different paths) share a program.
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/graphics/Shader.hpp>
+#include <sandbox/graphics/ShaderPreprocessor.hpp>
+#include <unordered_map>
+
+namespace sb
+{
+    class ShaderCache
+    {
+    public:
+
+        /*!
+            @brief Constructor.
+
+            @param include_dir Root folder used to resolve include directives.
+        */
+        ShaderCache(const std::string& include_dir = "assets/shaders");
+
+        //! Destructor. Delete all the compiled programs.
+        ~ShaderCache();
+
+        /*!
+            @brief Get a shader program variant, compiling it on first use.
+
+            The order of the defines does not matter.
+            The cache keeps the ownership of the returned object.
+
+            @param vertex_shader_filename Complete path to the vertex shader text file.
+            @param fragment_shader_filename Complete path to the fragment shader text file.
+            @param defines List of defines, as "NAME" or "NAME=VALUE".
+
+            @return Pointer to a valid Shader object. Nullptr if not valid.
+        */
+        Shader* get(const std::string& vertex_shader_filename, const std::string& fragment_shader_filename, const std::vector<std::string>& defines = {});
+
+        //! Return the number of variants requested so far.
+        uint variants() const;
+
+        //! Return the number of programs compiled so far.
+        uint programs() const;
+
+        //! Delete all the compiled programs.
+        void clear();
+
+    private:
+
+        //! Preprocessor used to expand the sources.
+        ShaderPreprocessor _preprocessor;
+
+        //! Programs indexed by requested variant (files and sorted defines).
+        std::unordered_map<std::string, Shader*> _variants;
+
+        //! Programs indexed by the hash of the expanded sources.
+        std::unordered_map<ulong, Shader*> _programs;
+    };
+}
@@ -0,0 +1,70 @@
+/** @file ShaderPreprocessor.hpp
+ *  @brief Expand include directives and inject defines in GLSL sources.
+ *
+ *  GLSL has no native include mechanism. The preprocessor replaces each
+ *  '#include "path"' line with the content of the referenced file, which
+ *  is resolved relative to an include directory (assets/shaders by default).
+ *  Each file is expanded at most once per source, so include guards are
+ *  not needed and cyclic includes are harmless.
+ *
+ *  A set of defines can be injected right after the '#version' directive
+ *  to produce permutations of the same source code (eg. TEXTURED, INSTANCED).
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+#include <string>
+#include <vector>
+#include <set>
+
+namespace sb
+{
+    class ShaderPreprocessor
+    {
+    public:
+
+        /*!
+            @brief Constructor.
+
+            @param include_dir Root folder used to resolve include directives.
+        */
+        ShaderPreprocessor(const std::string& include_dir = "assets/shaders");
+
+        /*!
+            @brief Load and expand a GLSL source file.
+
+            Defines are given as "NAME" or "NAME=VALUE" and are written as
+            '#define NAME VALUE' after the '#version' directive, in the given order.
+
+            @param filename Complete path to the shader text file.
+            @param defines List of defines to inject.
+
+            @return Expanded source code. Empty string if the file cannot be read.
+        */
+        std::string process(const std::string& filename, const std::vector<std::string>& defines = {}) const;
+
+        //! Return the root folder used to resolve include directives.
+        const std::string& includeDir() const;
+
+    private:
+
+        /*!
+            @brief Recursively expand the include directives of a source code.
+
+            @param source Source code to expand.
+            @param included Paths of the files already expanded.
+            @param depth Current recursion depth. It is also used as source string number in '#line' directives.
+
+            @return Expanded source code.
+        */
+        std::string expand(const std::string& source, std::set<std::string>& included, uint depth) const;
+
+        //! Maximum include nesting level.
+        static const uint MAX_INCLUDE_DEPTH = 32;
+
+        //! Root folder used to resolve include directives.
+        std::string _include_dir;
+    };
+}
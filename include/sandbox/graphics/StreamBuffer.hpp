@@ -0,0 +1,114 @@
+/** @file StreamBuffer.hpp
+ *  @brief GPU buffer to stream per-frame vertex, index or instance data.
+ *
+ *  The buffer is split in a ring of regions, one per frame in flight
+ *  (three by default). Each frame the application writes its dynamic data
+ *  in the current region, while the GPU may still be reading the regions
+ *  of the previous frames. A fence is inserted at the end of each frame and
+ *  a region is reused only once the GPU has signaled it: no reallocation
+ *  and no implicit synchronization happens in the driver.
+ *
+ *  When GL_ARB_buffer_storage is available, the storage is immutable and
+ *  mapped once for its whole lifetime (persistent and coherent mapping),
+ *  so writing is a plain memory copy. Otherwise (or if the mapping fails),
+ *  data is uploaded with glBufferSubData and the storage is orphaned each
+ *  time the ring wraps.
+ *
+ *  Typical frame:
+ *  - beginFrame()
+ *  - offset = write(data, size, alignment)
+ *  - draw the VAO using offset
+ *  - endFrame()
+ *
+ *  References
+ *  https://registry.khronos.org/OpenGL/extensions/ARB/ARB_buffer_storage.txt
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace sb
+{
+    class StreamBuffer
+    {
+    public:
+
+        //! Offset returned when data does not fit in the current region.
+        static const size_t INVALID_OFFSET = static_cast<size_t>(-1);
+
+        /*!
+            @brief Constructor.
+
+            @param frame_size Size in bytes of the data which can be written each frame.
+            @param frames Number of frames in flight, that is the number of regions in the ring.
+        */
+        StreamBuffer(size_t frame_size, uint frames = 3);
+
+        //! Destructor.
+        ~StreamBuffer();
+
+        StreamBuffer(const StreamBuffer&) = delete;
+        StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+        /*!
+            @brief Start writing in the next region of the ring.
+
+            Blocks the calling thread only if the GPU is still reading
+            the region, that is if the CPU is more than 'frames' frames ahead.
+        */
+        void beginFrame();
+
+        /*!
+            @brief Copy data into the current region.
+
+            @param data Pointer to the data to copy.
+            @param size Size of the data in bytes.
+            @param alignment Alignment of the returned offset. Use the vertex stride to draw vertices, 4 for 32-bit indices.
+
+            @return Offset in bytes from the beginning of the buffer. INVALID_OFFSET if the region is full.
+        */
+        size_t write(const void* data, size_t size, size_t alignment = 4);
+
+        //! Insert the fence which protects the current region until the GPU has consumed it.
+        void endFrame();
+
+        //! Return the binding index of the buffer object.
+        uint id() const;
+
+        //! Return the size in bytes of each region.
+        size_t frameSize() const;
+
+        //! Return the number of bytes still available in the current region.
+        size_t available() const;
+
+        //! Return true if the buffer is persistently mapped (GL_ARB_buffer_storage).
+        bool persistent() const;
+
+    private:
+
+        //! Binding index of the buffer object.
+        uint _buffer{0};
+
+        //! Persistently mapped memory. Nullptr when buffer storage is not supported or the mapping failed.
+        byte* _mapped{nullptr};
+
+        //! Size in bytes of each region.
+        size_t _frame_size{0};
+
+        //! Number of regions.
+        uint _frames{0};
+
+        //! Region currently written.
+        uint _frame{0};
+
+        //! Absolute write position in bytes.
+        size_t _head{0};
+
+        //! One fence per region, set at the end of the frame which wrote it.
+        std::vector<void*> _fences;
+    };
+}
@@ -1,12 +1,28 @@
 /** @file Texture.hpp
  *  @brief Load image files and create GL texture objects.
- * 
+ *
+ *  Textures are allocated as immutable storage (glTexStorage2D) when
+ *  GL_ARB_texture_storage is available, with the whole mipmap chain
+ *  if the minification filter requires it.
+ *
+ *  Images can be compressed at load time in BC1, BC3 or BC5 format
+ *  (see BlockCompression), passing the compressed format as pixel format.
+ *  In that case the mipmap chain is computed on the CPU.
+ *
+ *  Cooked '.sbtex' files (see TextureFile) are memory mapped and their
+ *  precomputed mipmap levels are uploaded as they are, without decoding.
+ *
+ *  A texture can also be created empty and filled later by a TextureLoader:
+ *  until then, it is bound as a 1x1 placeholder.
+ *
  *  @author Marco Carletti
 */
 #pragma once
 
 #include <string>
+#include <vector>
 #include <sandbox/core/opengl.hpp>
+#include <sandbox/core/types.hpp>
 
 namespace sb
 {
@@ -18,15 +34,39 @@ namespace sb
             @brief Constructor.
 
             Create an OpenGL texture object from an image file.
+            Cooked '.sbtex' files are loaded with their own pixel format and mipmaps:
+            'format' and 'flip' are ignored (the flip is chosen when the file is cooked, with 'texture_cooker --flip').
 
             @param filename Path to the image file to load.
-            @param format Pixel format (eg. GL_RGB, GL_RGBA).
+            @param format Pixel format (eg. GL_RGB, GL_RGBA, GL_COMPRESSED_RGB_S3TC_DXT1_EXT).
+            @param flip Flip the image vertically.
+            @param wrap_s_mode Wrapping mode along the horizontal axis (eg. GL_REPEAT, GL_CLAMP_TO_EDGE).
+            @param wrap_t_mode Wrapping mode along the vertical axis.
+            @param min_filter_mode Minifying filter (eg. GL_LINEAR_MIPMAP_LINEAR).
+            @param max_filter_mode Magnifying filter (eg. GL_LINEAR, GL_NEAREST).
         */
         Texture(const std::string& filename, int format = GL_RGB, bool flip = false, int wrap_s_mode = GL_REPEAT, int wrap_t_mode = GL_REPEAT, int min_filter_mode = GL_LINEAR_MIPMAP_LINEAR, int max_filter_mode = GL_LINEAR);
 
+        /*!
+            @brief Constructor.
+
+            Create a 1x1 placeholder texture object, to be filled by a TextureLoader.
+            The placeholder itself is never compressed.
+
+            @param format Pixel format (eg. GL_RGB, GL_RGBA, GL_COMPRESSED_RGB_S3TC_DXT1_EXT).
+            @param wrap_s_mode Wrapping mode along the horizontal axis (eg. GL_REPEAT, GL_CLAMP_TO_EDGE).
+            @param wrap_t_mode Wrapping mode along the vertical axis.
+            @param min_filter_mode Minifying filter (eg. GL_LINEAR_MIPMAP_LINEAR).
+            @param max_filter_mode Magnifying filter (eg. GL_LINEAR, GL_NEAREST).
+        */
+        Texture(int format = GL_RGB, int wrap_s_mode = GL_REPEAT, int wrap_t_mode = GL_REPEAT, int min_filter_mode = GL_LINEAR_MIPMAP_LINEAR, int max_filter_mode = GL_LINEAR);
+
         //! Destructor. Unbind current image and delete this texture object.
         ~Texture();
 
+        Texture(const Texture&) = delete;
+        Texture& operator=(const Texture&) = delete;
+
         //! Return the width of the texture in pixels.
         uint width() const;
 
@@ -36,11 +76,99 @@ namespace sb
         //! Return the number of channels of the texture.
         uint channels() const;
 
+        //! Return true once the image has been uploaded, false while the placeholder is bound.
+        bool resident() const;
+
+        //! Return the video memory used by the texture storage, in bytes.
+        size_t memory() const;
+
+        //! Return the number of top mipmap levels which are not resident (see TextureResidency).
+        uint droppedLevels() const;
+
         //! Activate and bind this texture object to texture target location.
         void bind(uint loc = 0) const;
 
     private:
 
+        friend class TextureLoader;
+        friend class TextureAtlas;
+        friend class TextureResidency;
+
+        /*!
+            @brief Create a new texture object with immutable storage.
+
+            The previous texture object, if any, is deleted.
+            The size of the storage is registered in GpuMemory.
+            The created texture object is left bound.
+
+            @param width Width of the first level in pixels.
+            @param height Height of the first level in pixels.
+            @param num_levels Number of mipmap levels.
+            @param internal_format Sized internal format (eg. GL_RGB8).
+        */
+        void allocate(uint width, uint height, uint num_levels, int internal_format);
+
+        /*!
+            @brief Create a new texture object and fill its first level.
+
+            Mipmaps are generated if the minification filter requires them.
+
+            @param width Width of the image in pixels.
+            @param height Height of the image in pixels.
+            @param pixels Pointer to the pixel values or, if a pixel unpack buffer is bound, offset in the buffer.
+        */
+        void create(uint width, uint height, const void* pixels);
+
+        /*!
+            @brief Create a new texture object from compressed levels.
+
+            @param width Width of the first level in pixels.
+            @param height Height of the first level in pixels.
+            @param levels Compressed blocks of each level, in the texture format.
+        */
+        void createCompressed(uint width, uint height, const std::vector<std::vector<uchar>>& levels);
+
+        /*!
+            @brief Create a new texture object without its top mipmap levels.
+
+            The first resident level is uploaded, the smaller ones are generated.
+
+            @param width Width of the image in pixels.
+            @param height Height of the image in pixels.
+            @param dropped_levels Number of top levels to skip.
+            @param pixels First resident level, rows aligned to 4 bytes or, if a pixel unpack buffer is bound, offset in the buffer.
+        */
+        void createLevels(uint width, uint height, uint dropped_levels, const void* pixels);
+
+        /*!
+            @brief Drop top mipmap levels without reloading the image.
+
+            The resident levels which are kept are copied on the GPU into a new, smaller
+            texture object (glCopyImageSubData, or a framebuffer blit for uncompressed
+            formats). Compressed textures without GL 4.3 are reloaded from their file.
+
+            @param dropped_levels Number of top levels to skip, more than the dropped ones.
+
+            @return True if the levels have been dropped.
+        */
+        bool drop(uint dropped_levels);
+
+        /*!
+            @brief Load the image file and upload it, without its top mipmap levels.
+
+            Cooked files are uploaded from their stored levels, other images are decoded.
+            The texture object is replaced: it is used for the first upload and,
+            for cooked files, to restore the top levels of a texture.
+
+            @param dropped_levels Number of top levels to skip. 0 uploads the whole image.
+
+            @return True if the file has been loaded.
+        */
+        bool load(uint dropped_levels);
+
+        //! Return the number of mipmap levels required by the minification filter.
+        uint levels(uint width, uint height) const;
+
         //! Unique index of the texture object.
         uint _texture_id{0};
 
@@ -50,7 +178,43 @@ namespace sb
         //! Height of the texture in pixels.
         uint _height{0};
 
-        //! Number of channels of the texture (1 = GRAYSCALE, 3 = RGB, 4 = RGBA).
+        //! Number of channels of the decoded image (3 = RGB, 4 = RGBA).
         uint _num_channels{0};
+
+        //! Pixel format (GL_RGB, GL_RGBA or a compressed format).
+        int _format{GL_RGB};
+
+        //! Wrapping mode along s and t coordinates.
+        int _wrap_s_mode{GL_REPEAT}, _wrap_t_mode{GL_REPEAT};
+
+        //! Interpolation mode when zooming out and in.
+        int _min_filter_mode{GL_LINEAR_MIPMAP_LINEAR}, _max_filter_mode{GL_LINEAR};
+
+        //! True once the image has been uploaded.
+        bool _resident{false};
+
+        //! Path of the image file, used to reload mipmap levels.
+        std::string _filename;
+
+        //! True if the image is flipped vertically when decoded.
+        bool _flip{false};
+
+        //! Number of top mipmap levels which are not resident.
+        uint _dropped_levels{0};
+
+        //! Number of resident mipmap levels.
+        uint _resident_levels{0};
+
+        //! True while a TextureLoader has an upload of this texture queued.
+        bool _loading{false};
+
+        //! Video memory used by the texture storage, in bytes.
+        size_t _memory{0};
+
+        //! Value of the bind clock at the last bind, to find the least recently used textures.
+        mutable ulong _last_bound{0};
+
+        //! Incremented at each bind of any texture.
+        static ulong _bind_clock;
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,83 @@
+/** @file TextureArray.hpp
+ *  @brief Pack many same-size images in a single GL_TEXTURE_2D_ARRAY.
+ *
+ *  All the layers of an array texture are bound with a single call, so
+ *  objects using different images of the same set (eg. the materials of a
+ *  level) can be drawn without rebinding textures in between, or even in a
+ *  single instanced draw call which selects the layer per instance.
+ *
+ *  In GLSL, the array is sampled with a 'sampler2DArray' and the layer
+ *  index as third texture coordinate: texture(data, vec3(uv, layer)).
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/opengl.hpp>
+#include <sandbox/core/types.hpp>
+#include <string>
+#include <vector>
+
+namespace sb
+{
+    class TextureArray
+    {
+    public:
+
+        /*!
+            @brief Constructor.
+
+            Load the image files as layers of an array texture, in the given order.
+            Images must have the same size of the first one: the others are skipped
+            (and their layer left undefined).
+
+            @param filenames Paths to the image files to load.
+            @param format Pixel format (eg. GL_RGB, GL_RGBA).
+        */
+        TextureArray(const std::vector<std::string>& filenames, int format = GL_RGB, bool flip = false, int wrap_s_mode = GL_REPEAT, int wrap_t_mode = GL_REPEAT, int min_filter_mode = GL_LINEAR_MIPMAP_LINEAR, int max_filter_mode = GL_LINEAR);
+
+        //! Destructor. Delete the texture object.
+        ~TextureArray();
+
+        TextureArray(const TextureArray&) = delete;
+        TextureArray& operator=(const TextureArray&) = delete;
+
+        //! Return the width of each layer in pixels.
+        uint width() const;
+
+        //! Return the height of each layer in pixels.
+        uint height() const;
+
+        //! Return the number of layers.
+        uint layers() const;
+
+        /*!
+            @brief Return the layer index of an image file.
+
+            @param filename Path to the image file, as given to the constructor.
+
+            @return Layer index. -1 if the file is not part of the array.
+        */
+        int layer(const std::string& filename) const;
+
+        //! Activate and bind this texture object to texture target location.
+        void bind(uint loc = 0) const;
+
+    private:
+
+        //! Unique index of the texture object.
+        uint _texture_id{0};
+
+        //! Width of each layer in pixels.
+        uint _width{0};
+
+        //! Height of each layer in pixels.
+        uint _height{0};
+
+        //! Video memory used by all the layers, in bytes.
+        size_t _memory{0};
+
+        //! Image files, indexed by layer.
+        std::vector<std::string> _filenames;
+    };
+}
@@ -0,0 +1,148 @@
+/** @file TextureAtlas.hpp
+ *  @brief Pack images of different sizes in a single texture.
+ *
+ *  Images are placed with a skyline bottom-left packer: the atlas keeps
+ *  the top profile of the packed images and each new image is placed
+ *  where it ends lowest, leftmost on ties. Images are padded by
+ *  replicating their border pixels, so bilinear filtering does not bleed
+ *  between neighbours.
+ *
+ *  Each image gets a region with its texture coords in the atlas. The UV
+ *  remap table stores a (scale, offset) pair per region, to be uploaded as
+ *  uniform array and applied in the shader: uv_atlas = uv * scale + offset.
+ *
+ *  Typical usage:
+ *  - add all the images
+ *  - build the atlas texture
+ *  - bind it once for all the objects using its images
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/graphics/Texture.hpp>
+#include <string>
+#include <vector>
+
+namespace sb
+{
+    class TextureAtlas
+    {
+    public:
+
+        //! Placement of an image in the atlas.
+        struct Region
+        {
+            //! Position and size of the image in pixels.
+            uint x{0}, y{0}, width{0}, height{0};
+
+            //! Texture coords of the image corners in the atlas.
+            float u0{0.f}, v0{0.f}, u1{0.f}, v1{0.f};
+        };
+
+        /*!
+            @brief Constructor.
+
+            @param width Width of the atlas in pixels.
+            @param height Height of the atlas in pixels.
+            @param format Pixel format (eg. GL_RGB, GL_RGBA).
+            @param padding Border added around each image in pixels.
+        */
+        TextureAtlas(uint width, uint height, int format = GL_RGBA, uint padding = 2, int wrap_s_mode = GL_CLAMP_TO_EDGE, int wrap_t_mode = GL_CLAMP_TO_EDGE, int min_filter_mode = GL_LINEAR, int max_filter_mode = GL_LINEAR);
+
+        /*!
+            @brief Load an image file and pack it in the atlas.
+
+            @param filename Path to the image file to load.
+            @param flip Flip the image vertically.
+
+            @return Region index. -1 if the file cannot be loaded or the atlas is full.
+        */
+        int add(const std::string& filename, bool flip = false);
+
+        /*!
+            @brief Pack an image in the atlas.
+
+            @param pixels Tightly packed pixel values, row by row, with the atlas number of channels.
+            @param width Width of the image in pixels.
+            @param height Height of the image in pixels.
+
+            @return Region index. -1 if the atlas is full.
+        */
+        int add(const uchar* pixels, uint width, uint height);
+
+        //! Upload the packed images to the atlas texture. It can be called again after adding more images.
+        void build();
+
+        //! Return the atlas texture.
+        const Texture& texture() const;
+
+        //! Return the placement of an image.
+        const Region& region(uint i) const;
+
+        //! Return the number of packed images.
+        uint size() const;
+
+        //! Return the region index of an image file. -1 if the file is not part of the atlas.
+        int find(const std::string& filename) const;
+
+        //! Return the UV remap table: (scale u, scale v, offset u, offset v) for each region.
+        std::vector<float> remapTable() const;
+
+        //! Return the fraction of the atlas area covered by the packed images, padding included.
+        float occupancy() const;
+
+        //! Activate and bind the atlas texture to texture target location.
+        void bind(uint loc = 0) const;
+
+    private:
+
+        //! Horizontal segment of the skyline.
+        struct Segment
+        {
+            uint x{0}, y{0}, width{0};
+        };
+
+        /*!
+            @brief Find the lowest position for a rectangle and update the skyline.
+
+            @param width Width of the rectangle in pixels.
+            @param height Height of the rectangle in pixels.
+            @param x Horizontal position of the rectangle.
+            @param y Vertical position of the rectangle.
+
+            @return False if the rectangle does not fit.
+        */
+        bool pack(uint width, uint height, uint& x, uint& y);
+
+        //! Texture which receives the packed images.
+        Texture _texture;
+
+        //! Width of the atlas in pixels.
+        uint _width{0};
+
+        //! Height of the atlas in pixels.
+        uint _height{0};
+
+        //! Border added around each image in pixels.
+        uint _padding{0};
+
+        //! Number of channels of the atlas.
+        uint _num_channels{0};
+
+        //! Pixel values of the atlas, kept to rebuild the texture.
+        std::vector<uchar> _pixels;
+
+        //! Top profile of the packed images, sorted by x.
+        std::vector<Segment> _skyline;
+
+        //! Placement of each packed image.
+        std::vector<Region> _regions;
+
+        //! Image file of each region, empty for images added from memory.
+        std::vector<std::string> _filenames;
+
+        //! Area covered by the packed images, in pixels.
+        ulong _used_area{0};
+    };
+}
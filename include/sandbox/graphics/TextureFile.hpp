@@ -0,0 +1,191 @@
+/** @file TextureFile.hpp
+ *  @brief Cooked texture container, ready to be uploaded without decoding.
+ *
+ *  A '.sbtex' file stores an image together with its whole mipmap chain,
+ *  so loading it requires neither image decoding nor mipmap generation.
+ *  The file is memory mapped and each level is uploaded straight from the
+ *  mapping.
+ *
+ *  Layout (little endian):
+ *  - header: magic "SBTX", version, pixel format, width, height, number of levels, channels
+ *  - level table: width, height, offset and size of each level
+ *  - level data, each level starting at a 16 bytes boundary, rows aligned to 4 bytes
+ *    (that is the default GL_UNPACK_ALIGNMENT) or 4x4 blocks for compressed formats
+ *    (see BlockCompression)
+ *
+ *  Files are created from JPEG/PNG images by the 'texture_cooker' tool.
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+#include <sandbox/utils/MappedFile.hpp>
+#include <string>
+#include <vector>
+
+namespace sb
+{
+    class TextureFile
+    {
+    public:
+
+        //! Description of a mipmap level.
+        struct Level
+        {
+            //! Width of the level in pixels.
+            uint width{0};
+
+            //! Height of the level in pixels.
+            uint height{0};
+
+            //! Position of the level data from the beginning of the file.
+            ulong offset{0};
+
+            //! Size of the level data in bytes.
+            ulong size{0};
+        };
+
+        //! Extension of the cooked texture files.
+        static const std::string EXTENSION;
+
+        //! Constructor. Create an empty container.
+        TextureFile() = default;
+
+        //! Destructor. Unmap the file, if any.
+        ~TextureFile();
+
+        TextureFile(const TextureFile&) = delete;
+        TextureFile& operator=(const TextureFile&) = delete;
+
+        /*!
+            @brief Map a cooked texture file and validate its content.
+
+            Files whose channels do not match the pixel format, or whose levels do not
+            halve the previous ones, do not have the size of their format or lie outside
+            the file are rejected: the levels can then be uploaded as they are.
+
+            @param filename Path to the '.sbtex' file.
+
+            @return True if the file is a valid texture container.
+        */
+        bool open(const std::string& filename);
+
+        //! Unmap the file.
+        void close();
+
+        //! Return the pixel format of the levels (eg. GL_RGB, GL_RGBA, GL_COMPRESSED_RG_RGTC2).
+        uint format() const;
+
+        //! Return the number of channels of the image.
+        uint channels() const;
+
+        //! Return the width of the first level in pixels.
+        uint width() const;
+
+        //! Return the height of the first level in pixels.
+        uint height() const;
+
+        //! Return the number of stored levels.
+        uint levels() const;
+
+        //! Return the description of a level.
+        const Level& level(uint i) const;
+
+        //! Return a pointer to the data of a level.
+        const uchar* data(uint i) const;
+
+        /*!
+            @brief Write an image and its mipmap chain to a cooked texture file.
+
+            Mipmaps are computed with a 2x2 box filter, down to 1x1.
+
+            @param filename Path to the '.sbtex' file.
+            @param pixels Tightly packed pixel values, row by row.
+            @param width Width of the image in pixels.
+            @param height Height of the image in pixels.
+            @param channels Number of channels (3 = RGB, 4 = RGBA).
+            @param mipmaps If false, store the first level only.
+            @param format Compressed format of the stored levels. If 0, levels are stored uncompressed.
+
+            @return True if the file has been written.
+        */
+        static bool write(const std::string& filename, const uchar* pixels, uint width, uint height, uint channels, bool mipmaps = true, uint format = 0);
+
+        /*!
+            @brief Compute the mipmap chain of an image, laid out as in the file.
+
+            @param pixels Tightly packed pixel values, row by row.
+            @param width Width of the image in pixels.
+            @param height Height of the image in pixels.
+            @param channels Number of channels (3 = RGB, 4 = RGBA).
+            @param num_levels Number of levels to compute.
+            @param format Compressed format of the levels. If 0, rows are just padded to 4 bytes.
+
+            @return Content of each level.
+        */
+        static std::vector<std::vector<uchar>> buildLevels(const uchar* pixels, uint width, uint height, uint channels, uint num_levels, uint format = 0);
+
+        //! Return the size in bytes of a row of pixels, padded to 4 bytes.
+        static uint rowSize(uint width, uint channels);
+
+    private:
+
+        //! File header, as stored on disk.
+        struct Header
+        {
+            char magic[4]{'S', 'B', 'T', 'X'};
+            uint version{VERSION};
+            uint format{0};
+            uint width{0};
+            uint height{0};
+            uint levels{0};
+            uint channels{0};
+            uint reserved{0};
+        };
+
+        //! Current version of the file layout.
+        static const uint VERSION = 1;
+
+        //! Alignment of the level data in bytes.
+        static const uint LEVEL_ALIGNMENT = 16;
+
+        /*!
+            @brief Write a list of levels to a cooked texture file.
+
+            @param filename Path to the '.sbtex' file.
+            @param format Pixel format of the levels.
+            @param channels Number of channels of the image.
+            @param levels Size of each level.
+            @param data Content of each level, already laid out as in the file.
+
+            @return True if the file has been written.
+        */
+        static bool write(const std::string& filename, uint format, uint channels, const std::vector<Level>& levels, const std::vector<std::vector<uchar>>& data);
+
+        /*!
+            @brief Halve an image with a 2x2 box filter.
+
+            Odd sizes are handled by clamping the sampled pixels to the border.
+
+            @param src Source pixels, rows padded as in the file.
+            @param width Width of the source image in pixels.
+            @param height Height of the source image in pixels.
+            @param channels Number of channels.
+            @param dst Destination pixels, rows padded as in the file.
+        */
+        static void downsample(const uchar* src, uint width, uint height, uint channels, uchar* dst);
+
+        //! Mapped file content.
+        utils::MappedFile _file;
+
+        //! Pixel format of the levels.
+        uint _format{0};
+
+        //! Number of channels of the image.
+        uint _channels{0};
+
+        //! Description of each level.
+        std::vector<Level> _levels;
+    };
+}
@@ -0,0 +1,141 @@
+/** @file TextureLoader.hpp
+ *  @brief Load textures in background, without stalling the render loop.
+ *
+ *  Image files are read asynchronously, all at once (see AsyncFileReader),
+ *  and decoded by a pool of worker threads as soon as their data arrives.
+ *  Decoded images are uploaded by 'update', which must be called by the
+ *  thread owning the GL context (eg. once per frame): pixels are copied
+ *  into a pixel unpack buffer, so the transfer to the texture storage is
+ *  performed by the driver asynchronously.
+ *
+ *  Textures with a compressed format are also compressed by the workers,
+ *  together with their mipmap chain.
+ *
+ *  Cooked '.sbtex' files need no decoding: they are uploaded by 'update'
+ *  straight from their mapping.
+ *
+ *  Until its image is resident, a texture binds a 1x1 placeholder.
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/graphics/Texture.hpp>
+#include <sandbox/utils/ThreadPool.hpp>
+#include <sandbox/utils/AsyncFileReader.hpp>
+#include <string>
+#include <vector>
+#include <mutex>
+
+namespace sb
+{
+    class TextureLoader
+    {
+    public:
+
+        /*!
+            @brief Constructor.
+
+            @param num_threads Number of decoding threads. If 0, use the number of hardware threads.
+        */
+        TextureLoader(uint num_threads = 2);
+
+        //! Destructor. Wait for the running decodes and discard the images not yet uploaded.
+        ~TextureLoader();
+
+        /*!
+            @brief Queue an image file to be decoded in background.
+
+            The texture must outlive the loader, or the call to 'update' which uploads it.
+
+            @param texture Placeholder texture which will receive the image.
+            @param filename Path to the image file to load.
+            @param flip Flip the image vertically.
+        */
+        void load(Texture& texture, const std::string& filename, bool flip = false);
+
+        /*!
+            @brief Queue a reload of a resident texture with fewer dropped mipmap levels.
+
+            The image file is read and decoded again in background, and only the
+            resident levels are uploaded: until then, the texture keeps its current levels.
+
+            @param texture Texture loaded from an image file (see TextureResidency).
+            @param dropped_levels Number of top levels to skip.
+        */
+        void restore(Texture& texture, uint dropped_levels);
+
+        /*!
+            @brief Upload the decoded images to their textures.
+
+            Must be called by the thread owning the GL context.
+
+            @param max_uploads Maximum number of textures uploaded by this call, to bound the frame time.
+
+            @return Number of textures made resident.
+        */
+        uint update(uint max_uploads = static_cast<uint>(-1));
+
+        //! Return the number of textures not yet resident.
+        uint pending() const;
+
+    private:
+
+        //! Image decoded by a worker thread, waiting to be uploaded.
+        struct Image
+        {
+            Texture* texture{nullptr};
+            uchar* pixels{nullptr};
+            uint width{0};
+            uint height{0};
+
+            //! Compressed resident levels, or the first resident level of restored uncompressed textures.
+            std::vector<std::vector<uchar>> levels;
+
+            //! Path of the cooked texture file, empty for decoded images.
+            std::string cooked_filename;
+
+            //! Number of top levels which are not uploaded.
+            uint dropped_levels{0};
+        };
+
+        /*!
+            @brief Read an image file and queue its decoding.
+
+            @param texture Texture which will receive the image. Its filename and flip are used.
+            @param dropped_levels Number of top levels to skip.
+        */
+        void queue(Texture& texture, uint dropped_levels);
+
+        /*!
+            @brief Decode an image file and queue it for upload. Executed by a worker thread.
+
+            @param target Texture which will receive the image.
+            @param filename Path to the image file, for error messages.
+            @param file Content of the image file.
+            @param flip Flip the image vertically.
+            @param channels Number of channels of the decoded image.
+            @param format Pixel format of the texture. Compressed formats are compressed here.
+            @param dropped_levels Number of top levels to skip.
+        */
+        void decode(Texture* target, const std::string& filename, const std::vector<uchar>& file, bool flip, int channels, uint format, uint dropped_levels);
+
+        //! Decoded images, waiting to be uploaded.
+        std::vector<Image> _decoded;
+
+        //! Mutex which protects the decoded images.
+        std::mutex _mutex;
+
+        //! Number of queued textures not yet resident.
+        uint _pending{0};
+
+        //! Pixel unpack buffer used for uploads.
+        uint _pbo{0};
+
+        //! File reads in flight. Their callbacks are delivered by 'update'.
+        utils::AsyncFileReader _reader;
+
+        //! Decoding threads. Declared last, so they are joined first.
+        utils::ThreadPool _pool;
+    };
+}
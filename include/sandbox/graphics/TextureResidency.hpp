@@ -0,0 +1,118 @@
+/** @file TextureResidency.hpp
+ *  @brief Keep the textures within a video memory budget by dropping their top mipmap levels.
+ *
+ *  Textures registered here lose (or get back) their top mipmap levels:
+ *  halving both sides of the base level saves three quarters of the texture
+ *  memory, while distant objects sample the smaller levels anyway.
+ *
+ *  Dropped levels are released on the GPU, copying the other levels into a
+ *  smaller texture object, so memory is recovered within the frame.
+ *  Restored levels are read and decoded again in background by a
+ *  TextureLoader: the texture keeps its current levels until they are uploaded.
+ *
+ *  Each frame the application requests the resolution it needs for each
+ *  texture, from the screen coverage of the object using it (see 'coverage').
+ *  Then 'update':
+ *  - while over budget, drops one level of the least recently bound texture
+ *  - queues the restore of one level of the textures requested at a higher
+ *    resolution, if it fits in the budget
+ *  At most a few textures are changed each call, to spread the cost over frames.
+ *  Textures with a load in progress are left untouched.
+ *
+ *  Only textures with an image file (not atlases or placeholders) can be managed.
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/graphics/Texture.hpp>
+#include <sandbox/graphics/TextureLoader.hpp>
+#include <sandbox/graphics/Camera.hpp>
+#include <sandbox/core/types.hpp>
+#include <unordered_map>
+
+namespace sb
+{
+    class TextureResidency
+    {
+    public:
+
+        /*!
+            @brief Constructor.
+
+            @param loader Loader which restores the dropped levels. It must outlive this object.
+            @param budget Video memory available for the managed textures, in bytes.
+        */
+        TextureResidency(TextureLoader& loader, size_t budget);
+
+        //! Set the video memory available for the managed textures, in bytes.
+        void setBudget(size_t budget);
+
+        //! Return the video memory available for the managed textures, in bytes.
+        size_t budget() const;
+
+        //! Return the video memory used by the managed textures, in bytes.
+        size_t used() const;
+
+        //! Start managing a texture. It must outlive this object or be removed.
+        void add(Texture& texture);
+
+        //! Stop managing a texture. Its resident levels are left unchanged.
+        void remove(Texture& texture);
+
+        /*!
+            @brief Request the resolution needed for a texture in the current frame.
+
+            Multiple requests in the same frame keep the highest resolution.
+            Textures not requested keep their levels, unless memory is needed.
+
+            @param texture Managed texture.
+            @param coverage Size in pixels of the object on screen (see 'coverage').
+        */
+        void request(const Texture& texture, real coverage);
+
+        /*!
+            @brief Drop mipmap levels or queue their restore, then clear the requests.
+
+            Restores are uploaded by the 'update' of the loader.
+
+            @param max_changes Maximum number of textures changed.
+
+            @return Number of textures whose levels have been dropped or queued for restore.
+        */
+        uint update(uint max_changes = 4);
+
+        /*!
+            @brief Estimate the size on screen of a bounding sphere.
+
+            @param camera Camera rendering the object.
+            @param center Center of the bounding sphere in world coordinates.
+            @param radius Radius of the bounding sphere.
+            @param viewport_height Height of the viewport in pixels.
+
+            @return Diameter of the projected sphere in pixels.
+        */
+        static real coverage(const Camera& camera, const Vector3& center, real radius, uint viewport_height);
+
+    private:
+
+        //! Residency state of a managed texture.
+        struct Entry
+        {
+            //! Highest screen coverage requested in the current frame, 0 if not requested.
+            real coverage{0};
+        };
+
+        //! Return the number of top levels a texture can drop without losing resolution on screen.
+        static uint droppable(const Texture& texture, real coverage);
+
+        //! Loader which restores the dropped levels.
+        TextureLoader* _loader;
+
+        //! Video memory available for the managed textures, in bytes.
+        size_t _budget{0};
+
+        //! Managed textures.
+        std::unordered_map<Texture*, Entry> _textures;
+    };
+}
@@ -6,6 +6,8 @@
 #pragma once
 
 #include <sandbox/math/Vector.hpp>
+#include <sandbox/graphics/VertexLayout.hpp>
+#include <sandbox/graphics/StreamBuffer.hpp>
 
 namespace sb
 {
@@ -23,6 +25,7 @@ namespace sb
             Additional per-vertex information must be added in a specific order, that is
             "position > normal > color > texture": if color is needed, also normal must be included.
             According to the per-vertex data, stride must be set as needed.
+            Data is always uploaded in single precision, whatever the engine precision is.
 
             Example:
             - position-only: per_vertex_data = {x, y, z}, stride = 3
@@ -36,14 +39,71 @@ namespace sb
         */
         VAO(const std::vector<real>& vertices, const std::vector<uint>& indices = {}, uint stride = 3);
 
+        /*!
+            @brief Constructor.
+
+            Model data to be rendered, stored as interleaved vertices described by a layout.
+            Vertices could use any attribute format supported by VertexLayout
+            (eg. half float texture coords, packed normals).
+
+            @param vertices Pointer to the interleaved per-vertex data.
+            @param size Size of the per-vertex data in bytes. It must be a multiple of the layout stride.
+            @param layout Description of the vertex attributes.
+            @param indices If set, enables EBO (Elements Buffer Object).
+        */
+        VAO(const void* vertices, size_t size, const VertexLayout& layout, const std::vector<uint>& indices = {});
+
+        /*!
+            @brief Constructor.
+
+            Dynamic model data, streamed every frame in a StreamBuffer.
+            The VAO does not own the buffer, which must outlive it.
+            Vertices and indices can be written in the same buffer:
+            draw calls take the offsets returned by StreamBuffer::write.
+
+            @param buffer Buffer which receives the per-frame data.
+            @param layout Description of the vertex attributes.
+            @param indexed If true, the buffer is also bound as elements buffer.
+        */
+        VAO(const StreamBuffer& buffer, const VertexLayout& layout, bool indexed = false);
+
         //! Destructor.
         ~VAO();
 
         //! Draw call which binds the VAO object to the GPU.
         void draw() const;
 
+        /*!
+            @brief Draw a range of vertices.
+
+            @param first Index of the first vertex. For streamed data, it is the write offset divided by the layout stride.
+            @param count Number of vertices.
+            @param instances Number of instances.
+        */
+        void draw(uint first, uint count, uint instances = 1) const;
+
+        /*!
+            @brief Draw a range of 32-bit indices.
+
+            @param offset Offset in bytes of the first index in the elements buffer.
+            @param count Number of indices.
+            @param base_vertex Value added to each index. For streamed data, it is the vertices write offset divided by the layout stride.
+            @param instances Number of instances.
+        */
+        void drawIndexed(size_t offset, uint count, int base_vertex = 0, uint instances = 1) const;
+
     private:
 
+        /*!
+            @brief Create the GL objects and upload the model data.
+
+            @param vertices Pointer to the interleaved per-vertex data.
+            @param size Size of the per-vertex data in bytes.
+            @param layout Description of the vertex attributes.
+            @param indices If set, enables EBO (Elements Buffer Object).
+        */
+        void init(const void* vertices, size_t size, const VertexLayout& layout, const std::vector<uint>& indices);
+
         //! Binding index of the vertex array object.
         uint _vao{0};
 
@@ -58,5 +118,8 @@ namespace sb
 
         //! Number of faces.
         uint _num_elements{0};
+
+        //! Size of the owned vertex and element buffers in bytes.
+        size_t _memory{0};
     };
 }
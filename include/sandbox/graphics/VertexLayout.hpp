@@ -0,0 +1,135 @@
+/** @file VertexLayout.hpp
+ *  @brief Description of the per-vertex attributes stored in a vertex buffer.
+ *
+ *  A layout lists the vertex attributes in the order they are interleaved
+ *  in memory. Each attribute has its own shader location, number of components
+ *  and storage type, so that compact formats can be used where full floats
+ *  are not needed:
+ *  - GL_HALF_FLOAT for texture coordinates;
+ *  - normalized GL_BYTE/GL_SHORT for normals and tangents;
+ *  - normalized GL_UNSIGNED_BYTE for colors;
+ *  - GL_INT_2_10_10_10_REV to pack a normal in 4 bytes.
+ *
+ *  Example (position float, normal packed, uv half = 20 bytes per vertex):
+ *  @code
+ *  VertexLayout layout;
+ *  layout.add(0, 3, GL_FLOAT)
+ *        .add(1, 4, GL_INT_2_10_10_10_REV, true)
+ *        .add(3, 2, GL_HALF_FLOAT);
+ *  @endcode
+ *
+ *  References
+ *  https://www.khronos.org/opengl/wiki/Vertex_Specification_Best_Practices
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+#include <vector>
+#include <cstddef>
+
+namespace sb
+{
+    //! Single vertex attribute.
+    struct VertexAttribute
+    {
+        //! Shader location of the attribute.
+        uint location{0};
+
+        //! Number of components (1 to 4).
+        uint components{0};
+
+        //! OpenGL storage type (eg. GL_FLOAT, GL_HALF_FLOAT, GL_SHORT).
+        uint type{0};
+
+        //! If true, integer values are mapped to [0, 1] (unsigned) or [-1, 1] (signed).
+        bool normalized{false};
+
+        //! Offset in bytes from the beginning of the vertex.
+        uint offset{0};
+    };
+
+    class VertexLayout
+    {
+    public:
+
+        //! Constructor. Create an empty layout.
+        VertexLayout() = default;
+
+        /*!
+            @brief Append an attribute to the vertex.
+
+            Attributes are aligned to 4 bytes, as required by most GPUs.
+            Packed types (GL_INT_2_10_10_10_REV, GL_UNSIGNED_INT_2_10_10_10_REV)
+            always have 4 components.
+
+            @param location Shader location of the attribute.
+            @param components Number of components (1 to 4).
+            @param type OpenGL storage type.
+            @param normalized Map integer values to [0, 1] or [-1, 1].
+
+            @return Reference to this layout, to chain calls.
+        */
+        VertexLayout& add(uint location, uint components, uint type, bool normalized = false);
+
+        /*!
+            @brief Layout used by the stride-based VAO constructor.
+
+            Attributes are floats in the order "position > normal > color > texture"
+            (locations 0, 1, 2, 3) and only those fitting in the stride are enabled.
+
+            @param stride Number of floats per vertex.
+        */
+        static VertexLayout fromStride(uint stride);
+
+        //! Return the size of a vertex in bytes.
+        uint stride() const;
+
+        //! Return the list of attributes.
+        const std::vector<VertexAttribute>& attributes() const;
+
+        /*!
+            @brief Configure and enable the attribute pointers.
+
+            Vertex array object and vertex buffer must be bound.
+
+            @param base_offset Offset in bytes of the first vertex in the bound buffer.
+        */
+        void apply(size_t base_offset = 0) const;
+
+        /*!
+            @brief Size in bytes of an attribute.
+
+            @param type OpenGL storage type.
+            @param components Number of components.
+        */
+        static uint size(uint type, uint components);
+
+    private:
+
+        //! List of attributes, sorted by offset.
+        std::vector<VertexAttribute> _attributes;
+
+        //! Size of a vertex in bytes.
+        uint _stride{0};
+    };
+
+    //! Convert a float to a 16-bit half float (round to nearest even).
+    ushort packHalf(float v);
+
+    //! Convert a float in [-1, 1] to a normalized signed byte.
+    signed char packSnorm8(float v);
+
+    //! Convert a float in [0, 1] to a normalized unsigned byte.
+    uchar packUnorm8(float v);
+
+    //! Convert a float in [-1, 1] to a normalized signed short.
+    short packSnorm16(float v);
+
+    //! Convert a float in [0, 1] to a normalized unsigned short.
+    ushort packUnorm16(float v);
+
+    //! Pack four floats in [-1, 1] as GL_INT_2_10_10_10_REV (x in the lowest bits).
+    uint packSnorm2_10_10_10(float x, float y, float z, float w = 0.f);
+}
@@ -0,0 +1,60 @@
+/** @file MappedMatrix.hpp
+ *  @brief Matrix which uses a binary matrix file in place.
+ *
+ *  The file (see serialize.hpp) is mapped copy-on-write: opening it costs a
+ *  system call regardless of its size, elements are paged in from the page
+ *  cache on first access, and elements can be modified without changing the
+ *  file. It can be passed by reference wherever a Matrix is expected;
+ *  copies are regular matrices in memory.
+ *
+ *  The mapped elements are not owned by the base Matrix, which never frees
+ *  them. The mapping is released by the MappedMatrix destructor only, which
+ *  is not virtual: a MappedMatrix must not be deleted through a Matrix pointer.
+ *
+ *  The file is mapped directly from disk, so archives mounted in the
+ *  VirtualFileSystem are not searched: use Matrix::load for packed files.
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/math/Matrix.hpp>
+#include <string>
+
+namespace sb
+{
+    template <typename T>
+    class MappedMatrixT : public MatrixT<T>
+    {
+    public:
+
+        /*!
+            @brief Constructor. Map a binary matrix file.
+
+            The elements must be stored in the precision of the matrix, no conversion is done.
+
+            @param filename Path to the file.
+        */
+        MappedMatrixT(const std::string& filename);
+
+        MappedMatrixT(const MappedMatrixT<T>&) = delete;
+        MappedMatrixT<T>& operator=(const MappedMatrixT<T>&) = delete;
+
+        //! Destructor. Unmap the file, discarding the modified elements.
+        ~MappedMatrixT();
+
+        //! Return true if the file has been mapped. Otherwise the matrix is empty (size 0).
+        bool isOpen() const;
+
+    private:
+
+        //! Start of the mapping (ie. the file header).
+        void* _mapping{nullptr};
+
+        //! Size of the mapping in bytes.
+        size_t _mapping_size{0};
+    };
+
+    //! Mapped matrix of real numbers, in the engine default precision.
+    using MappedMatrix = MappedMatrixT<real>;
+}
@@ -1,16 +1,22 @@
 /** @file Matrix.hpp
  *  @brief MxN matrix class.
  * 
+ *  The scalar type is a template parameter (float or double), so that
+ *  simulation code can run in double precision in any build.
+ *  'Matrix' is the alias in the engine default precision (see 'real').
+ * 
  *  @author Marco Carletti
 */
 #pragma once
 
 #include <sandbox/math/Vector.hpp>
-#include <sstream>
+#include <iosfwd>
+#include <string>
 
 namespace sb
 {
-    class Matrix
+    template <typename T>
+    class MatrixT
     {
     public:
 
@@ -23,7 +29,7 @@ namespace sb
             @param rows The number of rows of the matrix. It must be grater than 0.
             @param cols The number of rows of the matrix. It must be grater than 0.
         */
-        Matrix(const uint rows, const uint cols);
+        MatrixT(const uint rows, const uint cols);
 
         /*!
             @brief Constructor.
@@ -36,22 +42,55 @@ namespace sb
             @param rows The number of rows of the matrix.
             @param cols The number of rows of the matrix.
         */
-        Matrix(const std::vector<real>& v, const uint rows = 0, const uint cols = 0);
+        MatrixT(const std::vector<T>& v, const uint rows = 0, const uint cols = 0);
 
         //! Copy constructor.
-        Matrix(const Matrix& m);
+        MatrixT(const MatrixT<T>& m);
 
-        //! Destructor.
-        ~Matrix();
+        //! Destructor. Free the elements, unless they are not owned (see MappedMatrix).
+        ~MatrixT();
 
         //! Constructor of the identity matrix.
-        static Matrix identity(const uint size);
+        static MatrixT<T> identity(const uint size);
 
-        //! String representation of the matrix.
+        //! String representation of the matrix: one row per line, elements separated by spaces.
         std::string toString() const;
 
+        /*!
+            @brief Write the matrix as text (see serialize.hpp).
+
+            @param stream Output stream.
+            @param separator Character between the elements of a row (eg. ',' for CSV).
+        */
+        void write(std::ostream& stream, char separator = ' ') const;
+
+        /*!
+            @brief Read a matrix written as text, one row per line (see serialize.hpp).
+
+            @param stream Input stream.
+            @param separator Character between the elements of a row (eg. ',' for CSV). Blanks are separators too.
+            @return The matrix. Empty (size 0) if the text is not a valid matrix.
+        */
+        static MatrixT<T> read(std::istream& stream, char separator = ' ');
+
+        /*!
+            @brief Save the matrix to a binary file (see serialize.hpp).
+
+            @param filename Path to the file.
+            @return True if the file has been written.
+        */
+        bool save(const std::string& filename) const;
+
+        /*!
+            @brief Load a matrix from a binary file. Elements stored in the other precision are converted.
+
+            @param filename Path to the file.
+            @return The matrix. Empty (size 0) if the file cannot be read.
+        */
+        static MatrixT<T> load(const std::string& filename);
+
         //! Get data pointer.
-        const real* data() const;
+        const T* data() const;
 
         //! Return number of rows.
         uint rows() const;
@@ -63,7 +102,7 @@ namespace sb
         uint size() const;
 
         //! Return the matrix diagonal as a vector.
-        Vector diag() const;
+        VectorT<T> diag() const;
 
         /*!
             @brief Get a copy of the i-th row.
@@ -71,7 +110,7 @@ namespace sb
             @param i Index of the row. It must be between 0 and number of rows.
             @return A copy to the i-th row.
         */
-        Vector row(const uint i) const;
+        VectorT<T> row(const uint i) const;
 
         /*!
             @brief Get a copy of the i-th column.
@@ -79,7 +118,7 @@ namespace sb
             @param i Index of the column. It must be between 0 and number of columns.
             @return A copy to the i-th column.
         */
-        Vector col(const uint i) const;
+        VectorT<T> col(const uint i) const;
 
         /*!
             @brief Get a reference to the i-th element, selected row major.
@@ -87,7 +126,7 @@ namespace sb
             @param i Index of the element. It must be between 0 and the matrix total size.
             @return A reference to the i-th element.
         */
-        real& operator[](const uint i);
+        T& operator[](const uint i);
 
         /*!
             @brief Get a reference to the ij-th element.
@@ -96,7 +135,7 @@ namespace sb
             @param j Col index of the element. It must be between 0 and the matrix column size.
             @return A reference to the ij-th element.
         */
-        real& operator()(const uint i, const uint j);
+        T& operator()(const uint i, const uint j);
 
         /*!
             @brief Get a copy to the i-th element, selected row major.
@@ -104,7 +143,7 @@ namespace sb
             @param i Index of the element. It must be between 0 and the matrix total size.
             @return A copy of the i-th element.
         */
-        real at(const uint i) const;
+        T at(const uint i) const;
 
         /*!
             @brief Get a copy of the ij-th element.
@@ -113,7 +152,7 @@ namespace sb
             @param j Col index of the element. It must be between 0 and the matrix column size.
             @return A copy to the ij-th element.
         */
-        real at(const uint i, const uint j) const;
+        T at(const uint i, const uint j) const;
 
         /*!
             @brief Get a copy of the submatrix of size (rows, cols) which starts from ij-th element.
@@ -124,7 +163,7 @@ namespace sb
             @param cols Col size of the submatrix.
             @return The submatrix.
         */
-        Matrix get(const uint i, const uint j, const uint rows, const uint cols) const;
+        MatrixT<T> get(const uint i, const uint j, const uint rows, const uint cols) const;
 
         /*!
             @brief Sparse update of matrix values.
@@ -132,7 +171,7 @@ namespace sb
             @param indices Elements to be updated, row major.
             @param value New value, equal for all indices.
         */
-        void set(const std::vector<uint>& indices, real value);
+        void set(const std::vector<uint>& indices, T value);
 
         /*!
             @brief Sparse update of matrix values.
@@ -140,7 +179,7 @@ namespace sb
             @param indices Elements to be updated, row major.
             @param values New values relative to indices.
         */
-        void set(const std::vector<uint>& indices, const std::vector<real>& values);
+        void set(const std::vector<uint>& indices, const std::vector<T>& values);
 
         /*!
             @brief Update sub-matrix.
@@ -149,93 +188,93 @@ namespace sb
             @param j Col index of the top-left corner of the submatrix.
             @param m Matrix of new values.
         */
-        void set(const uint i, const uint j, const Matrix& m);
+        void set(const uint i, const uint j, const MatrixT<T>& m);
 
         //! Matrix per-value comparison.
-        bool operator==(const Matrix& m) const;
+        bool operator==(const MatrixT<T>& m) const;
 
         //! Assignment operator.
-        void operator=(const Matrix& m);
+        void operator=(const MatrixT<T>& m);
 
         //! Add a scalar to the Matrix elements.
-        Matrix operator+(const real& v) const;
+        MatrixT<T> operator+(const T& v) const;
 
         //! Add a scalar to the Matrix elements (inplace).
-        void operator+=(const real& v);
+        void operator+=(const T& v);
 
         //! Subtract a scalar to the Matrix elements.
-        Matrix operator-(const real& v) const;
+        MatrixT<T> operator-(const T& v) const;
 
         //! Subtract a scalar to the Matrix elements (inplace).
-        void operator-=(const real& v);
+        void operator-=(const T& v);
 
         //! Negate vector.
-        Matrix operator-() const;
+        MatrixT<T> operator-() const;
 
         //! Multiply each element by a scalar.
-        Matrix operator*(const real& v) const;
+        MatrixT<T> operator*(const T& v) const;
 
         //! Multiply each element by a scalar (inplace).
-        void operator*=(const real& v);
+        void operator*=(const T& v);
 
         //! Divide each element by a non-zero scalar.
-        Matrix operator/(const real& v) const;
+        MatrixT<T> operator/(const T& v) const;
 
         //! Divide each element by a non-zero scalar (inplace).
-        void operator/=(const real& v);
+        void operator/=(const T& v);
 
         //! Add two matrices element-wise.
-        Matrix operator+(const Matrix& m) const;
+        MatrixT<T> operator+(const MatrixT<T>& m) const;
 
         //! Add two matrices element-wise (inplace).
-        void operator+=(const Matrix& m);
+        void operator+=(const MatrixT<T>& m);
 
         //! Subtract two matrices element-wise.
-        Matrix operator-(const Matrix& m) const;
+        MatrixT<T> operator-(const MatrixT<T>& m) const;
 
         //! Subtract two matrices element-wise (inplace).
-        void operator-=(const Matrix& m);
+        void operator-=(const MatrixT<T>& m);
 
         //! Multiply two matrices element-wise.
-        Matrix operator*(const Matrix& m) const;
+        MatrixT<T> operator*(const MatrixT<T>& m) const;
 
         //! Multiply two matrices element-wise (inplace).
-        void operator*=(const Matrix& m);
+        void operator*=(const MatrixT<T>& m);
 
         //! Divide two matrices element-wise.
-        Matrix operator/(const Matrix& m) const;
+        MatrixT<T> operator/(const MatrixT<T>& m) const;
 
         //! Divide two matrices element-wise (inplace).
-        void operator/=(const Matrix& m);
+        void operator/=(const MatrixT<T>& m);
 
         //! Matrix multiplication.
-        Matrix matmul(const Matrix& m) const;
+        MatrixT<T> matmul(const MatrixT<T>& m) const;
 
         //! Compute the trace (ie. sum of diagonal values).
-        real trace() const;
+        T trace() const;
 
         //! Transpose the matrix.
-        Matrix t() const;
+        MatrixT<T> t() const;
 
         //! Compute the determinant.
-        real det() const;
+        T det() const;
 
         //! Compute the inverse matrix.
-        Matrix inv() const;
+        MatrixT<T> inv() const;
 
         //! Translate the matrix by a vector (inplace).
-        void translate(const Vector& v);
+        void translate(const VectorT<T>& v);
 
         //! Scale matrix (inplace).
-        void scale(const real& v);
+        void scale(const T& v);
 
         //! Scale matrix axes independently (inplace).
-        void scale(const Vector& v);
+        void scale(const VectorT<T>& v);
 
     protected:
 
         //! Constructor.
-        Matrix() = default;
+        MatrixT() = default;
 
         /*!
             @brief Compute matrix of cofactors relative to the row-col anchor value of a NxN matrix.
@@ -249,24 +288,24 @@ namespace sb
             @param col Current anchor row to be skipped.
             @param n Dimension of the square submatrix of cfs used to store the cofactors.
         */
-        void cofactors(Matrix& cfs, const uint row, const uint col, const uint n) const;
+        void cofactors(MatrixT<T>& cfs, const uint row, const uint col, const uint n) const;
 
         /*!
             @brief Compute the conjugate matrix.
             
             @param adj Output matrix of conjugate values.
         */
-        void adjoint(Matrix& adj) const;
+        void adjoint(MatrixT<T>& adj) const;
 
         /*!
             @brief Compute the determinant of square submatrix nxn.
             
             @param n Order (size) of the submatrix.
         */
-        real det(const uint n) const;
+        T det(const uint n) const;
 
         //! Data pointer.
-        real* _data{nullptr};
+        T* _data{nullptr};
 
         //! Number of rows of the matrix.
         uint _rows{0};
@@ -276,5 +315,11 @@ namespace sb
 
         //! Number of elements of the matrix.
         uint _size{0};
+
+        //! False if the elements are allocated elsewhere (eg. mapped from a file): they are not freed.
+        bool _owner{true};
     };
-}
+
+    //! MxN matrix of real numbers, in the engine default precision.
+    using Matrix = MatrixT<real>;
+}
\ No newline at end of file
@@ -9,7 +9,8 @@
 
 namespace sb
 {
-    class Matrix2 : public Matrix
+    template <typename T>
+    class Matrix2T : public MatrixT<T>
     {
     public:
 
@@ -18,22 +19,32 @@ namespace sb
 
             Allocate a 2x2 identity matrix of real numbers.
         */
-        Matrix2();
+        Matrix2T();
 
         /*!
             @brief Constructor.
 
             @param v Standard vector of real numbers. Size must be 2.
         */
-        Matrix2(const std::vector<real>& v);
+        Matrix2T(const std::vector<T>& v);
 
         //! Copy constructor from parent class.
-        Matrix2(const Matrix& m);
+        Matrix2T(const MatrixT<T>& m);
 
         //! Copy constructor.
-        Matrix2(const Matrix2& m);
+        Matrix2T(const Matrix2T<T>& m);
 
         //! Destructor.
-        ~Matrix2();
+        ~Matrix2T();
+
+    protected:
+
+        using MatrixT<T>::_data;
+        using MatrixT<T>::_rows;
+        using MatrixT<T>::_cols;
+        using MatrixT<T>::_size;
     };
+
+    //! 2x2 matrix of real numbers, in the engine default precision.
+    using Matrix2 = Matrix2T<real>;
 }
\ No newline at end of file
@@ -9,7 +9,8 @@
 
 namespace sb
 {
-    class Matrix3 : public Matrix
+    template <typename T>
+    class Matrix3T : public MatrixT<T>
     {
     public:
 
@@ -18,22 +19,32 @@ namespace sb
 
             Allocate a 3x3 identity matrix of real numbers.
         */
-        Matrix3();
+        Matrix3T();
 
         /*!
             @brief Constructor.
 
             @param v Standard vector of real numbers. Size must be 9.
         */
-        Matrix3(const std::vector<real>& v);
+        Matrix3T(const std::vector<T>& v);
 
         //! Copy constructor from parent class.
-        Matrix3(const Matrix& m);
+        Matrix3T(const MatrixT<T>& m);
 
         //! Copy constructor.
-        Matrix3(const Matrix3& m);
+        Matrix3T(const Matrix3T<T>& m);
 
         //! Destructor.
-        ~Matrix3();
+        ~Matrix3T();
+
+    protected:
+
+        using MatrixT<T>::_data;
+        using MatrixT<T>::_rows;
+        using MatrixT<T>::_cols;
+        using MatrixT<T>::_size;
     };
+
+    //! 3x3 matrix of real numbers, in the engine default precision.
+    using Matrix3 = Matrix3T<real>;
 }
\ No newline at end of file
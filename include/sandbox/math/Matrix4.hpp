@@ -9,7 +9,8 @@
 
 namespace sb
 {
-    class Matrix4 : public Matrix
+    template <typename T>
+    class Matrix4T : public MatrixT<T>
     {
     public:
 
@@ -18,22 +19,32 @@ namespace sb
 
             Allocate a 4x4 identity matrix of real numbers.
         */
-        Matrix4();
+        Matrix4T();
 
         /*!
             @brief Constructor.
 
             @param v Standard vector of real numbers. Size must be 16.
         */
-        Matrix4(const std::vector<real>& v);
+        Matrix4T(const std::vector<T>& v);
 
         //! Copy constructor from parent class.
-        Matrix4(const Matrix& m);
+        Matrix4T(const MatrixT<T>& m);
 
         //! Copy constructor.
-        Matrix4(const Matrix4& m);
+        Matrix4T(const Matrix4T<T>& m);
 
         //! Destructor.
-        ~Matrix4();
+        ~Matrix4T();
+
+    protected:
+
+        using MatrixT<T>::_data;
+        using MatrixT<T>::_rows;
+        using MatrixT<T>::_cols;
+        using MatrixT<T>::_size;
     };
+
+    //! 4x4 matrix of real numbers, in the engine default precision.
+    using Matrix4 = Matrix4T<real>;
 }
\ No newline at end of file
@@ -1,16 +1,23 @@
 /** @file Vector.hpp
  *  @brief N-dimensional vector class.
  * 
+ *  The scalar type is a template parameter (float or double), so that
+ *  simulation code can run in double precision in any build.
+ *  'Vector' is the alias in the engine default precision (see 'real').
+ * 
  *  @author Marco Carletti
 */
 #pragma once
 
 #include <sandbox/core/types.hpp>
+#include <iosfwd>
+#include <string>
 #include <vector>
 
 namespace sb
 {
-    class Vector
+    template <typename T>
+    class VectorT
     {
     public:
 
@@ -22,30 +29,30 @@ namespace sb
 
             @param size The number of elements the vector will store. It must be grater than 0.
         */
-        Vector(const uint size);
+        VectorT(const uint size);
 
         /*!
             @brief Constructor.
 
             @param v Standard vector of real numbers. Size must be greather than 0.
         */
-        Vector(const std::vector<real>& v);
+        VectorT(const std::vector<T>& v);
 
         /*!
             @brief Constructor. Initializes a Vector from braced-init-list.
 
             @param list Non empty list of real numbers.
         */
-        Vector(const std::initializer_list<real>& list);
+        VectorT(const std::initializer_list<T>& list);
 
         //! Copy constructor.
-        Vector(const Vector& v);
+        VectorT(const VectorT<T>& v);
 
         //! Destructor.
-        ~Vector();
+        ~VectorT();
 
         //! Get data pointer.
-        const real* data() const;
+        const T* data() const;
 
         /*! 
             @brief Get the number of elements.
@@ -54,13 +61,49 @@ namespace sb
         */
         uint size() const;
 
+        //! String representation of the vector: elements on a single line, separated by spaces.
+        std::string toString() const;
+
+        /*!
+            @brief Write the vector as a single line of text (see serialize.hpp).
+
+            @param stream Output stream.
+            @param separator Character between the elements (eg. ',' for CSV).
+        */
+        void write(std::ostream& stream, char separator = ' ') const;
+
+        /*!
+            @brief Read a vector written as text, as a single row or a single column.
+
+            @param stream Input stream.
+            @param separator Character between the elements (eg. ',' for CSV). Blanks are separators too.
+            @return The vector. Empty (size 0) if the text is not valid.
+        */
+        static VectorT<T> read(std::istream& stream, char separator = ' ');
+
+        /*!
+            @brief Save the vector to a binary file, as a matrix of a single row (see serialize.hpp).
+
+            @param filename Path to the file.
+            @return True if the file has been written.
+        */
+        bool save(const std::string& filename) const;
+
+        /*!
+            @brief Load a vector from a binary file of a single row or column.
+
+            @param filename Path to the file.
+            @return The vector. Empty (size 0) if the file cannot be read or it is not a vector.
+        */
+        static VectorT<T> load(const std::string& filename);
+
         /*!
             @brief Get a reference to the i-th element.
 
             @param i Index of the element. It must be between 0 and the vector size.
             @return A reference to the i-th element.
         */
-        real& operator[](const uint i);
+        T& operator[](const uint i);
 
         /*!
             @brief Get a reference to the i-th element.
@@ -68,7 +111,7 @@ namespace sb
             @param i Index of the element. It must be between 0 and the vector size.
             @return A reference to the i-th element.
         */
-        real& operator()(const uint i);
+        T& operator()(const uint i);
 
         /*!
             @brief Get a copy of the i-th element.
@@ -76,26 +119,26 @@ namespace sb
             @param i Index of the element. It must be between 0 and the vector size.
             @return A copy of the i-th element.
         */
-        real at(const uint i) const;
+        T at(const uint i) const;
 
         /*! 
             @brief Compute the L2 norm of the vector.
 
             @return Length of the vector as L2 norm.
         */
-        real norm() const;
+        T norm() const;
 
         //! Inplace vector normalization (ie. sum of values is 1).
         void normalize();
 
         //! Return normalized vector (ie. sum of values is 1).
-        static Vector normalize(const Vector& v);
+        static VectorT<T> normalize(const VectorT<T>& v);
 
         //! Inplace vector equalization (ie. values are scaled between 0 and 1).
         void equalize();
 
         //! Return equalized vector (ie. values are scaled between 0 and 1).
-        static Vector equalize(const Vector& v);
+        static VectorT<T> equalize(const VectorT<T>& v);
 
         /*!
             @brief Compute the dot product with the input vector.
@@ -103,7 +146,7 @@ namespace sb
             @param v Vector of the same size of the caller.
             @return Dot product as scalar (real).
         */
-        real dot(const Vector& v) const;
+        T dot(const VectorT<T>& v) const;
 
         /*!
             @brief Compute the angle with input vectors.
@@ -111,7 +154,7 @@ namespace sb
             @param v Vector of the same size of the caller.
             @return Angle between the vectors in radians.
         */
-        real angle(const Vector& v) const;
+        T angle(const VectorT<T>& v) const;
 
         /*!
             @brief Compute the cross product with the input vector.
@@ -121,74 +164,77 @@ namespace sb
             @param v Vector of size 3 to compute the product.
             @return Cross product as a vector.
         */
-        Vector cross(const Vector& v) const;
+        VectorT<T> cross(const VectorT<T>& v) const;
 
         //! Vector per-value comparison.
-        bool operator==(const Vector& v) const;
+        bool operator==(const VectorT<T>& v) const;
 
         //! Assignment operator.
-        void operator=(const Vector& v);
+        void operator=(const VectorT<T>& v);
 
         //! Add a scalar to the vector elements.
-        Vector operator+(const real& v) const;
+        VectorT<T> operator+(const T& v) const;
 
         //! Add a scalar to the vector elements (inplace).
-        void operator+=(const real& v);
+        void operator+=(const T& v);
 
         //! Subtract a scalar to the vector elements.
-        Vector operator-(const real& v) const;
+        VectorT<T> operator-(const T& v) const;
 
         //! Subtract a scalar to the vector elements (inplace).
-        void operator-=(const real& v);
+        void operator-=(const T& v);
 
         //! Negate vector.
-        Vector operator-() const;
+        VectorT<T> operator-() const;
 
         //! Multiply each element by a scalar.
-        Vector operator*(const real& v) const;
+        VectorT<T> operator*(const T& v) const;
 
         //! Multiply each element by a scalar (inplace).
-        void operator*=(const real& v);
+        void operator*=(const T& v);
 
         //! Divide each element by a non-zero scalar.
-        Vector operator/(const real& v) const;
+        VectorT<T> operator/(const T& v) const;
 
         //! Divide each element by a non-zero scalar (inplace).
-        void operator/=(const real& v);
+        void operator/=(const T& v);
 
         //! Add two vectors element-wise.
-        Vector operator+(const Vector& v) const;
+        VectorT<T> operator+(const VectorT<T>& v) const;
 
         //! Add two vectors element-wise (inplace).
-        void operator+=(const Vector& v);
+        void operator+=(const VectorT<T>& v);
 
         //! Subtract two vectors element-wise.
-        Vector operator-(const Vector& v) const;
+        VectorT<T> operator-(const VectorT<T>& v) const;
 
         //! Subtract two vectors element-wise (inplace).
-        void operator-=(const Vector& v);
+        void operator-=(const VectorT<T>& v);
 
         //! Multiply two vectors element-wise.
-        Vector operator*(const Vector& v) const;
+        VectorT<T> operator*(const VectorT<T>& v) const;
 
         //! Multiply two vectors element-wise (inplace).
-        void operator*=(const Vector& v);
+        void operator*=(const VectorT<T>& v);
 
         //! Divide two vectors element-wise.
-        Vector operator/(const Vector& v) const;
+        VectorT<T> operator/(const VectorT<T>& v) const;
 
         //! Divide two vectors element-wise (inplace).
-        void operator/=(const Vector& v);
+        void operator/=(const VectorT<T>& v);
 
     protected:
 
         //! Constructor.
-        Vector() = default;
+        VectorT() = default;
 
         //! Data pointer.
-        real* _data{nullptr};
+        T* _data{nullptr};
 
         //! Size of the vector.
         uint _size{0};
     };
+
+    //! N-dimensional vector of real numbers, in the engine default precision.
+    using Vector = VectorT<real>;
 }
\ No newline at end of file
@@ -9,7 +9,8 @@
 
 namespace sb
 {
-    class Vector2 : public Vector
+    template <typename T>
+    class Vector2T : public VectorT<T>
     {
     public:
 
@@ -19,29 +20,37 @@ namespace sb
             Allocate a vector of two real numbers.
             Elements are set to 0.
         */
-        Vector2();
+        Vector2T();
 
         /*!
             @brief Constructor.
 
             @param v Standard vector of real numbers. Size must be 2.
         */
-        Vector2(const std::vector<real>& v);
+        Vector2T(const std::vector<T>& v);
 
         /*!
             @brief Constructor. Initializes a Vector from braced-init-list.
 
             @param list Non empty list of real numbers.
         */
-        Vector2(const std::initializer_list<real>& list);
+        Vector2T(const std::initializer_list<T>& list);
 
         //! Copy constructor from parent class.
-        Vector2(const Vector& v);
+        Vector2T(const VectorT<T>& v);
 
         //! Copy constructor.
-        Vector2(const Vector2& v);
+        Vector2T(const Vector2T<T>& v);
 
         //! Destructor.
-        ~Vector2();
+        ~Vector2T();
+
+    protected:
+
+        using VectorT<T>::_data;
+        using VectorT<T>::_size;
     };
+
+    //! 2-dimensional vector of real numbers, in the engine default precision.
+    using Vector2 = Vector2T<real>;
 }
\ No newline at end of file
@@ -9,7 +9,8 @@
 
 namespace sb
 {
-    class Vector3 : public Vector
+    template <typename T>
+    class Vector3T : public VectorT<T>
     {
     public:
 
@@ -19,29 +20,37 @@ namespace sb
             Allocate a vector of three real numbers.
             Elements are set to 0.
         */
-        Vector3();
+        Vector3T();
 
         /*!
             @brief Constructor.
 
             @param v Standard vector of real numbers. Size must be 3.
         */
-        Vector3(const std::vector<real>& v);
+        Vector3T(const std::vector<T>& v);
 
         /*!
             @brief Constructor. Initializes a Vector from braced-init-list.
 
             @param list Non empty list of real numbers.
         */
-        Vector3(const std::initializer_list<real>& list);
+        Vector3T(const std::initializer_list<T>& list);
 
         //! Copy constructor from parent class.
-        Vector3(const Vector& v);
+        Vector3T(const VectorT<T>& v);
 
         //! Copy constructor.
-        Vector3(const Vector3& v);
+        Vector3T(const Vector3T<T>& v);
 
         //! Destructor.
-        ~Vector3();
+        ~Vector3T();
+
+    protected:
+
+        using VectorT<T>::_data;
+        using VectorT<T>::_size;
     };
+
+    //! 3-dimensional vector of real numbers, in the engine default precision.
+    using Vector3 = Vector3T<real>;
 }
\ No newline at end of file
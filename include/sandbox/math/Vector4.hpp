@@ -9,7 +9,8 @@
 
 namespace sb
 {
-    class Vector4 : public Vector
+    template <typename T>
+    class Vector4T : public VectorT<T>
     {
     public:
 
@@ -19,29 +20,37 @@ namespace sb
             Allocate a vector of four real numbers.
             Elements are set to 0.
         */
-        Vector4();
+        Vector4T();
 
         /*!
             @brief Constructor.
 
             @param v Standard vector of real numbers. Size must be 4.
         */
-        Vector4(const std::vector<real>& v);
+        Vector4T(const std::vector<T>& v);
 
         /*!
             @brief Constructor. Initializes a Vector from braced-init-list.
 
             @param list Non empty list of real numbers.
         */
-        Vector4(const std::initializer_list<real>& list);
+        Vector4T(const std::initializer_list<T>& list);
 
         //! Copy constructor from parent class.
-        Vector4(const Vector& v);
+        Vector4T(const VectorT<T>& v);
 
         //! Copy constructor.
-        Vector4(const Vector4& v);
+        Vector4T(const Vector4T<T>& v);
 
         //! Destructor.
-        ~Vector4();
+        ~Vector4T();
+
+    protected:
+
+        using VectorT<T>::_data;
+        using VectorT<T>::_size;
     };
+
+    //! 4-dimensional vector of real numbers, in the engine default precision.
+    using Vector4 = Vector4T<real>;
 }
\ No newline at end of file
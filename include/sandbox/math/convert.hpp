@@ -0,0 +1,69 @@
+/** @file convert.hpp
+ *  @brief Precision conversion between math types and GPU data.
+ * 
+ *  CPU math can run in double precision, while vertex buffers and
+ *  uniforms are always uploaded in single precision: double attributes
+ *  and uniforms are slow or unsupported on many drivers and double
+ *  the memory bandwidth. Narrowing uses SIMD instructions when available.
+ * 
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/math/Vector.hpp>
+#include <sandbox/math/Matrix.hpp>
+#include <cstddef>
+
+namespace sb
+{
+    /*!
+        @brief Convert an array of doubles to floats.
+
+        @param src Source array.
+        @param dst Destination array. It must be large enough to store n values.
+        @param n Number of values to convert.
+    */
+    void narrow(const double* src, float* dst, size_t n);
+
+    /*!
+        @brief Convert an array of floats to doubles.
+
+        @param src Source array.
+        @param dst Destination array. It must be large enough to store n values.
+        @param n Number of values to convert.
+    */
+    void widen(const float* src, double* dst, size_t n);
+
+    //! Return a single precision view of the data: no conversion is needed, buffer is not used.
+    inline const float* asFloat(const float* src, float* buffer, size_t n)
+    {
+        return src;
+    }
+
+    //! Return a single precision view of the data: values are narrowed into buffer.
+    inline const float* asFloat(const double* src, float* buffer, size_t n)
+    {
+        narrow(src, buffer, n);
+        return buffer;
+    }
+
+    //! Copy a vector converting it to a different precision.
+    template <typename U, typename T>
+    VectorT<U> cast(const VectorT<T>& v)
+    {
+        VectorT<U> res(v.size());
+        for (uint i = 0; i < v.size(); ++i)
+            res[i] = static_cast<U>(v.at(i));
+        return res;
+    }
+
+    //! Copy a matrix converting it to a different precision.
+    template <typename U, typename T>
+    MatrixT<U> cast(const MatrixT<T>& m)
+    {
+        MatrixT<U> res(m.rows(), m.cols());
+        for (uint i = 0; i < m.size(); ++i)
+            res[i] = static_cast<U>(m.at(i));
+        return res;
+    }
+}
@@ -12,6 +12,9 @@
 
 #include "projection.hpp"
 #include "transform.hpp"
+#include "convert.hpp"
+#include "serialize.hpp"
+#include "MappedMatrix.hpp"
 
 namespace sb
 {
@@ -24,4 +27,25 @@ namespace sb
     using vec2 = Vector2;
     using vec3 = Vector3;
     using vec4 = Vector4;
+
+    // explicit precision, independent from the engine default one
+    using matf = MatrixT<float>;
+    using mat2f = Matrix2T<float>;
+    using mat3f = Matrix3T<float>;
+    using mat4f = Matrix4T<float>;
+
+    using vecf = VectorT<float>;
+    using vec2f = Vector2T<float>;
+    using vec3f = Vector3T<float>;
+    using vec4f = Vector4T<float>;
+
+    using matd = MatrixT<double>;
+    using mat2d = Matrix2T<double>;
+    using mat3d = Matrix3T<double>;
+    using mat4d = Matrix4T<double>;
+
+    using vecd = VectorT<double>;
+    using vec2d = Vector2T<double>;
+    using vec3d = Vector3T<double>;
+    using vec4d = Vector4T<double>;
 }
\ No newline at end of file
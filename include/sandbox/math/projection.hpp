@@ -1,12 +1,16 @@
 /** @file projection.hpp
  *  @brief Coordinate system utilities.
  * 
+ *  Matrices are built in the engine default precision;
+ *  specify the scalar type explicitly for a different one (eg. perspective<double>(...)).
+ * 
  *  @author Marco Carletti
 */
 #pragma once
 
 #include <sandbox/math/Vector3.hpp>
 #include <sandbox/math/Matrix4.hpp>
+#include <type_traits>
 
 namespace sb
 {
@@ -20,7 +24,8 @@ namespace sb
         @param near The near edge of the view frustum.
         @param far The far edge of the view frustum.
     */
-    Matrix4 ortho(const real left, const real right, const real bottom, const real top, const real near, const real far);
+    template <typename T = real>
+    Matrix4T<T> ortho(const std::type_identity_t<T> left, const std::type_identity_t<T> right, const std::type_identity_t<T> bottom, const std::type_identity_t<T> top, const std::type_identity_t<T> near, const std::type_identity_t<T> far);
 
     /*!
         @brief Create a perspective projection matrix.
@@ -30,7 +35,8 @@ namespace sb
         @param near The near edge of the view frustum.
         @param far The far edge of the view frustum.
     */
-    Matrix4 perspective(const real fov, const real aspect, const real near, const real far);
+    template <typename T = real>
+    Matrix4T<T> perspective(const std::type_identity_t<T> fov, const std::type_identity_t<T> aspect, const std::type_identity_t<T> near, const std::type_identity_t<T> far);
 
     /*!
         @brief Create a look at matrix.
@@ -39,5 +45,6 @@ namespace sb
         @param center The position of the object to look at.
         @param up The up vector.
     */
-    Matrix4 lookAt(const Vector3& eye, const Vector3& center, const Vector3& up);
+    template <typename T = real>
+    Matrix4T<T> lookAt(const std::type_identity_t<Vector3T<T>>& eye, const std::type_identity_t<Vector3T<T>>& center, const std::type_identity_t<Vector3T<T>>& up);
 }
\ No newline at end of file
@@ -0,0 +1,112 @@
+/** @file serialize.hpp
+ *  @brief Text and binary serialization of matrix data.
+ *
+ *  Text: one row per line, elements separated by blanks or by a separator
+ *  character (eg. ',' for CSV). Numbers are written with std::to_chars in
+ *  the shortest form which reads back to the same value, and read with
+ *  std::from_chars. Streams are processed in chunks, so matrices of any
+ *  size are written and read without building the whole text in memory.
+ *
+ *  Binary: a 64 bytes header (see MatrixHeader) followed by the elements,
+ *  row major and little endian. The data starts 64 bytes into the file, so
+ *  a mapping of the file is aligned for both float and double elements and
+ *  can be used in place (see MappedMatrix).
+ *
+ *  These functions operate on raw data: see the read/write/load/save members
+ *  of Matrix and Vector.
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace sb
+{
+    //! Header of binary matrix files.
+    struct MatrixHeader
+    {
+        char magic[4]{'S', 'B', 'M', 'X'};
+        uint version{1};
+
+        //! Size of an element in bytes: 4 for float, 8 for double.
+        uint scalar_size{0};
+
+        uint rows{0};
+        uint cols{0};
+        uchar reserved[44]{};
+    };
+
+    /*!
+        @brief Append the text representation of a matrix to a string.
+
+        @param text Output string.
+        @param data Elements, row major.
+        @param rows Number of rows.
+        @param cols Number of columns.
+        @param separator Character between the elements of a row.
+    */
+    template <typename T>
+    void formatText(std::string& text, const T* data, uint rows, uint cols, char separator = ' ');
+
+    /*!
+        @brief Write a matrix as text to a stream.
+
+        @param stream Output stream.
+        @param data Elements, row major.
+        @param rows Number of rows.
+        @param cols Number of columns.
+        @param separator Character between the elements of a row.
+    */
+    template <typename T>
+    void writeText(std::ostream& stream, const T* data, uint rows, uint cols, char separator = ' ');
+
+    /*!
+        @brief Read a matrix from a text stream. Blank lines are skipped.
+
+        @param stream Input stream.
+        @param data Output elements, row major.
+        @param rows Output number of rows.
+        @param cols Output number of columns.
+        @param separator Character between the elements of a row. Blanks are separators too.
+        @return False if a value is not a number, if the rows have different lengths or if there is no data.
+    */
+    template <typename T>
+    bool readText(std::istream& stream, std::vector<T>& data, uint& rows, uint& cols, char separator = ' ');
+
+    /*!
+        @brief Write a binary matrix file.
+
+        @param filename Path to the file.
+        @param data Elements, row major.
+        @param rows Number of rows.
+        @param cols Number of columns.
+        @return True if the file has been written.
+    */
+    template <typename T>
+    bool writeBinary(const std::string& filename, const T* data, uint rows, uint cols);
+
+    /*!
+        @brief Read a binary matrix file. Elements stored in the other precision are converted.
+
+        @param filename Path to the file.
+        @param data Output elements, row major.
+        @param rows Output number of rows.
+        @param cols Output number of columns.
+        @return False if the file cannot be read or it is not a valid matrix file.
+    */
+    template <typename T>
+    bool readBinary(const std::string& filename, std::vector<T>& data, uint& rows, uint& cols);
+
+    /*!
+        @brief Check the header of a binary matrix file against its size.
+
+        @param header Header read from the file.
+        @param file_size Size of the file in bytes.
+        @return True if the header is valid and the file stores all the elements.
+    */
+    bool validHeader(const MatrixHeader& header, size_t file_size);
+}
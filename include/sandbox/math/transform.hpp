@@ -1,12 +1,16 @@
 /** @file transform.hpp
  *  @brief Cartesian space transformation utilities.
  * 
+ *  Scalar type is deduced from the input matrix or vector;
+ *  other arguments are converted to it.
+ * 
  *  @author Marco Carletti
 */
 #pragma once
 
 #include <sandbox/math/Vector.hpp>
 #include <sandbox/math/Matrix.hpp>
+#include <type_traits>
 
 namespace sb
 {
@@ -16,7 +20,8 @@ namespace sb
         @param m The matrix to translate.
         @param v The translation vector.
     */
-    Matrix translate(const Matrix& m, const Vector& v);
+    template <typename T>
+    MatrixT<T> translate(const MatrixT<T>& m, const std::type_identity_t<VectorT<T>>& v);
 
     /*!
         @brief Rotate a 2D or 3D matrix by an angle around an axis.
@@ -25,7 +30,8 @@ namespace sb
         @param angle The angle in radians.
         @param axis The rotation axis (ignored for 2D rotation).
     */
-    Matrix rotate(const Matrix& m, const real angle, const Vector& axis);
+    template <typename T>
+    MatrixT<T> rotate(const MatrixT<T>& m, const std::type_identity_t<T> angle, const std::type_identity_t<VectorT<T>>& axis);
 
     /*!
         @brief Rotate a 2D or 3D vector by an angle around an axis.
@@ -34,7 +40,8 @@ namespace sb
         @param angle The angle in radians.
         @param axis The rotation axis (ignored for 2D rotation).
     */
-    Vector rotate(const Vector& v, const real angle, const Vector& axis);
+    template <typename T>
+    VectorT<T> rotate(const VectorT<T>& v, const std::type_identity_t<T> angle, const std::type_identity_t<VectorT<T>>& axis);
 
     /*!
         @brief Scale a matrix by a scalar.
@@ -42,7 +49,8 @@ namespace sb
         @param m The matrix to scale.
         @param s The scale factor.
     */
-    Matrix scale(const Matrix& m, const real s);
+    template <typename T>
+    MatrixT<T> scale(const MatrixT<T>& m, const std::type_identity_t<T> s);
 
     /*!
         @brief Scale a matrix by a vector.
@@ -50,5 +58,6 @@ namespace sb
         @param m The matrix to scale.
         @param v The scale vector.
     */
-    Matrix scale(const Matrix& m, const Vector& v);
+    template <typename T>
+    MatrixT<T> scale(const MatrixT<T>& m, const std::type_identity_t<VectorT<T>>& v);
 }
\ No newline at end of file
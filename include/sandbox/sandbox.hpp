@@ -11,11 +11,29 @@
 #include <sandbox/core/keysymdef.hpp>
 #include <sandbox/core/Input.hpp>
 #include <sandbox/core/Window.hpp>
+#include <sandbox/core/FramePacer.hpp>
 #include <sandbox/graphics/Shader.hpp>
+#include <sandbox/graphics/ShaderBatch.hpp>
+#include <sandbox/graphics/ShaderCache.hpp>
+#include <sandbox/graphics/ShaderPreprocessor.hpp>
 #include <sandbox/graphics/VAO.hpp>
+#include <sandbox/graphics/VertexLayout.hpp>
+#include <sandbox/graphics/StreamBuffer.hpp>
+#include <sandbox/graphics/GpuMemory.hpp>
 #include <sandbox/graphics/Camera.hpp>
+#include <sandbox/graphics/RenderStats.hpp>
+#include <sandbox/graphics/Overlay.hpp>
 #include <sandbox/math/math.hpp>
 #include <sandbox/utils/Loader.hpp>
+#include <sandbox/utils/MappedFile.hpp>
+#include <sandbox/utils/ConfigINI.hpp>
 #include <sandbox/utils/Logger.hpp>
+#include <sandbox/utils/BinaryLog.hpp>
 #include <sandbox/utils/Timer.hpp>
+#include <sandbox/utils/Profiler.hpp>
+#include <sandbox/utils/FrameStats.hpp>
+#include <sandbox/utils/ThreadPool.hpp>
+#include <sandbox/utils/AsyncFileReader.hpp>
+#include <sandbox/utils/Archive.hpp>
+#include <sandbox/utils/VirtualFileSystem.hpp>
 #include <sandbox/utils/string.hpp>
\ No newline at end of file
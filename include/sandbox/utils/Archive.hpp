@@ -0,0 +1,172 @@
+/** @file Archive.hpp
+ *  @brief Read-only pack of asset files, memory mapped as a whole.
+ *
+ *  A '.sbpak' file stores many files in a single mapping: opening an
+ *  asset is a hash table lookup instead of open/stat/read system calls,
+ *  and the content of each file is contiguous on disk.
+ *
+ *  Layout (little endian):
+ *  - header: magic "SBPK", version, number of entries, number of buckets,
+ *    position of the index and of the path strings
+ *  - file data, each entry starting at a 4KB (page) boundary
+ *  - index: one record per entry (path hash, offset, stored and original size, flags)
+ *  - buckets: open addressing hash table of entry indices, by path hash
+ *  - path strings, referenced by the index records
+ *
+ *  Entries can be compressed (see compressLZ) in independent blocks of 64KB:
+ *  the block table (number of blocks, compressed size of each block) is
+ *  followed by the blocks. Blocks which do not shrink are stored as they are.
+ *
+ *  Paths are stored normalized and relative (eg. "assets/shaders/misc/quad.glsl").
+ *  Archives are created by the 'asset_packer' tool.
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+#include <sandbox/utils/MappedFile.hpp>
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace sb::utils
+{
+    class Archive
+    {
+    public:
+
+        //! Extension of the archive files.
+        static const std::string EXTENSION;
+
+        //! Constructor. Create an empty archive.
+        Archive() = default;
+
+        Archive(const Archive&) = delete;
+        Archive& operator=(const Archive&) = delete;
+
+        /*!
+            @brief Map an archive file and validate its index.
+
+            @param filename Path to the '.sbpak' file.
+
+            @return True if the file is a valid archive.
+        */
+        bool open(const std::string& filename);
+
+        //! Unmap the archive. Views of uncompressed entries become invalid.
+        void close();
+
+        //! Return the number of entries.
+        uint size() const;
+
+        //! Return the path of an entry.
+        std::string_view path(uint i) const;
+
+        //! Return true if the archive contains a file.
+        bool contains(const std::string& path) const;
+
+        /*!
+            @brief View the content of a file.
+
+            Uncompressed entries point into the archive mapping, which must outlive the view.
+            Compressed entries are decompressed into a buffer owned by the view.
+
+            @param path Path of the file, as built by the callers (it is normalized here).
+
+            @return View of the file content. Not open if the file is not in the archive.
+        */
+        MappedFile map(const std::string& path) const;
+
+        /*!
+            @brief Write an archive file.
+
+            @param filename Path to the '.sbpak' file.
+            @param files Path of each file in the archive and path of the file to read from disk.
+            @param compress If true, entries are compressed when they shrink enough.
+
+            @return True if the file has been written.
+        */
+        static bool write(const std::string& filename, const std::vector<std::pair<std::string, std::string>>& files, bool compress);
+
+        //! Return a path in the form stored in archives: relative, without '.' or '..' components.
+        static std::string normalize(const std::string& path);
+
+    private:
+
+        //! File header, as stored on disk.
+        struct Header
+        {
+            char magic[4]{'S', 'B', 'P', 'K'};
+            uint version{VERSION};
+            uint entries{0};
+            uint buckets{0};
+            ulong index_offset{0};
+            ulong paths_offset{0};
+            ulong paths_size{0};
+            uchar reserved[24]{};
+        };
+
+        //! Index record of a file, as stored on disk.
+        struct Entry
+        {
+            ulong hash{0};
+            ulong offset{0};
+            ulong size{0};
+            ulong original_size{0};
+            uint path_offset{0};
+            uint path_size{0};
+            uint flags{0};
+            uint reserved{0};
+        };
+
+        //! Current version of the file layout.
+        static const uint VERSION = 1;
+
+        //! Alignment of the entry data in bytes.
+        static const uint ALIGNMENT = 4096;
+
+        //! Size of the uncompressed blocks of compressed entries.
+        static const uint BLOCK_SIZE = 65536;
+
+        //! Entry flag: data is split in compressed blocks.
+        static const uint COMPRESSED = 1;
+
+        //! Block size flag: the block is stored uncompressed.
+        static const uint RAW_BLOCK = 0x80000000;
+
+        //! Return the entry of a normalized path. Nullptr if not found.
+        const Entry* find(const std::string& path) const;
+
+        /*!
+            @brief Compress a file in independent blocks.
+
+            @param data File content.
+            @param size Size of the file in bytes.
+
+            @return Block table followed by the blocks.
+        */
+        static std::vector<uchar> compress(const uchar* data, size_t size);
+
+        //! Decompress the blocks of an entry into a buffer of its original size.
+        bool decompress(const Entry& entry, std::vector<uchar>& buffer) const;
+
+        //! Mapped archive.
+        MappedFile _file;
+
+        //! Index records, pointing into the mapping.
+        const Entry* _entries{nullptr};
+
+        //! Hash table of entry indices plus one (0 = empty bucket), pointing into the mapping.
+        const uint* _buckets{nullptr};
+
+        //! Number of buckets, a power of two.
+        uint _num_buckets{0};
+
+        //! Number of entries.
+        uint _num_entries{0};
+
+        //! Path strings, pointing into the mapping.
+        const char* _paths{nullptr};
+    };
+}
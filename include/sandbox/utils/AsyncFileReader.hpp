@@ -0,0 +1,211 @@
+/** @file AsyncFileReader.hpp
+ *  @brief Read many whole files concurrently, keeping the I/O queue deep.
+ *
+ *  Reads are submitted to the kernel through io_uring: a single ring keeps
+ *  up to 'queue_depth' reads in flight, and a completion thread collects
+ *  the results without issuing one blocking call per file. When io_uring is
+ *  not available (old kernels, containers forbidding it), each file is read
+ *  with pread by a pool of worker threads.
+ *
+ *  Completions are delivered in two ways:
+ *  - callbacks, invoked by 'poll' or 'wait' on the calling thread (eg. once per frame)
+ *  - futures, fulfilled as soon as the data is available
+ *
+ *  Files are opened when their read gets a slot in the ring (by the thread
+ *  calling 'read' or by the completion thread), or by the fallback workers,
+ *  never while holding the lock taken by 'poll'.
+ *
+ *  References
+ *  https://kernel.dk/io_uring.pdf
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+#include <sandbox/utils/ThreadPool.hpp>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace sb::utils
+{
+    class AsyncFileReader
+    {
+    public:
+
+        //! Function receiving the content of a file. Data can be moved away.
+        using Callback = std::function<void(std::vector<uchar>& data, bool success)>;
+
+        /*!
+            @brief Constructor. Create the submission ring, or the fallback workers.
+
+            @param queue_depth Maximum number of reads in flight.
+            @param num_threads Number of fallback workers, used only without io_uring.
+        */
+        AsyncFileReader(uint queue_depth = 64, uint num_threads = 4);
+
+        //! Destructor. Wait for the reads in flight: the callbacks not yet delivered are dropped.
+        ~AsyncFileReader();
+
+        AsyncFileReader(const AsyncFileReader&) = delete;
+        AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+
+        /*!
+            @brief Queue the read of a whole file.
+
+            @param filename Path to the file.
+            @param callback Function invoked by 'poll' or 'wait' once the file has been read.
+        */
+        void read(const std::string& filename, Callback callback);
+
+        /*!
+            @brief Queue the read of a whole file.
+
+            @param filename Path to the file.
+
+            @return Future content of the file. It holds an exception if the file cannot be read.
+        */
+        std::future<std::vector<uchar>> read(const std::string& filename);
+
+        /*!
+            @brief Invoke the callbacks of the completed reads.
+
+            @return Number of callbacks invoked.
+        */
+        uint poll();
+
+        //! Block until all the queued reads have been completed and their callbacks invoked.
+        void wait();
+
+        //! Return the number of reads not yet delivered.
+        uint pending() const;
+
+        //! Return true if reads are submitted through io_uring, false with the pread fallback.
+        bool uring() const;
+
+    private:
+
+        //! State of a single file read.
+        struct Request
+        {
+            //! Path to the file.
+            std::string filename;
+
+            //! Function to invoke when completed. Unset if awaited through the promise.
+            Callback callback;
+
+            //! Promise of the awaited reads.
+            std::promise<std::vector<uchar>> promise;
+
+            //! File content.
+            std::vector<uchar> data;
+
+            //! File descriptor, -1 once closed.
+            int fd{-1};
+
+            //! Number of bytes already read.
+            size_t offset{0};
+
+            //! True if the whole file has been read.
+            bool success{false};
+        };
+
+        //! Memory shared with the kernel by an io_uring instance.
+        struct Ring
+        {
+            int fd{-1};
+            uint entries{0};
+
+            void* sq_memory{nullptr};
+            void* cq_memory{nullptr};
+            void* sqes{nullptr};
+            size_t sq_memory_size{0};
+            size_t cq_memory_size{0};
+            size_t sqes_size{0};
+
+            uint* sq_head{nullptr};
+            uint* sq_tail{nullptr};
+            uint* sq_mask{nullptr};
+            uint* sq_array{nullptr};
+
+            uint* cq_head{nullptr};
+            uint* cq_tail{nullptr};
+            uint* cq_mask{nullptr};
+            void* cqes{nullptr};
+        };
+
+        //! Hand a request over to the backend.
+        void submit(std::unique_ptr<Request> request);
+
+        //! Open the file of a request and allocate its content. Return false if the file cannot be read.
+        bool open(Request* request);
+
+        //! Create the io_uring instance and map its rings. Return false if io_uring is not available.
+        bool setup(uint entries);
+
+        //! Unmap the rings and close the io_uring instance.
+        void teardown();
+
+        //! Move the queued requests in the ring, while there are free slots. Requires the mutex, which is released while opening the files.
+        void pump(std::unique_lock<std::mutex>& lock);
+
+        /*!
+            @brief Write a read of the remaining bytes of a request in the submission ring. Requires the mutex.
+
+            While in flight, the request is owned by the ring: the kernel returns it in the completion.
+        */
+        void push(Request* request);
+
+        //! Submit the entries written in the submission ring. Requires the mutex.
+        void enter(uint count);
+
+        //! Completion thread loop: reap completed reads and resubmit partial ones.
+        void reap();
+
+        //! Read a file with pread, on a fallback worker.
+        void readBlocking(Request* request);
+
+        //! Close the file and hand a request over to the thread delivering it. Requires the mutex.
+        void complete(Request* request, bool success);
+
+        //! Io_uring instance. Its descriptor is -1 with the pread fallback.
+        Ring _ring;
+
+        //! Maximum number of reads in flight.
+        uint _queue_depth{0};
+
+        //! Number of reads submitted and not yet completed by the kernel.
+        uint _in_flight{0};
+
+        //! Number of reads queued and not yet delivered.
+        uint _pending{0};
+
+        //! True when the completion thread must exit.
+        bool _stop{false};
+
+        //! Requests waiting for a slot in the ring.
+        std::deque<std::unique_ptr<Request>> _queued;
+
+        //! Completed requests with a callback, waiting for 'poll'.
+        std::vector<std::unique_ptr<Request>> _completed;
+
+        //! Mutex which protects the submission ring, the queues and the counters.
+        mutable std::mutex _mutex;
+
+        //! Signaled when a request is completed.
+        std::condition_variable _done;
+
+        //! Thread collecting io_uring completions.
+        std::thread _reaper;
+
+        //! Fallback workers. Nullptr with io_uring.
+        std::unique_ptr<ThreadPool> _pool;
+    };
+}
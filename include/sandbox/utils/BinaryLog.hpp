@@ -0,0 +1,241 @@
+/** @file BinaryLog.hpp
+ *  @brief Log of binary records, formatted offline.
+ *
+ *  Each call site of SB_BLOG registers its format string once and gets an id:
+ *  a record stores the id, the timestamp, the thread and the raw bytes of the
+ *  arguments. Nothing is formatted on the calling thread, which only copies
+ *  a few bytes into its own ring buffer (see LogWriter), so it is cheap
+ *  enough to log from the frame loop. Each argument is evaluated once.
+ *
+ *  The background writer appends the records, and the format strings they
+ *  refer to, to a '.sblog' file. The 'log_decoder' tool (or decode) renders
+ *  it as text, replacing each "{}" of the format with the next argument.
+ *
+ *  Arguments can be integers, floating point numbers, booleans, characters
+ *  and strings (copied into the record, up to 1KB each).
+ *
+ *  Example:
+ *  SB_BLOG("frame {} took {} ms", frame, ms);
+ *
+ *  File layout (little endian): "SBLG", version, then entries starting
+ *  with their size in bytes (4 bytes, the size included) and an id (4 bytes):
+ *  - id = FORMAT_ID: format definition (id, line, types, file and format strings)
+ *  - otherwise: record (timestamp, thread index, arguments)
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+#include <sandbox/utils/LogWriter.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace sb::utils
+{
+    class BinaryLog
+    {
+    public:
+
+        //! Extension of the binary log files.
+        static const std::string EXTENSION;
+
+        //! Entry id of the format definitions.
+        static const uint FORMAT_ID = 0xFFFFFFFF;
+
+        //! Longest string argument stored in a record, longer ones are truncated.
+        static const uint MAX_STRING = 1024;
+
+        /*!
+            @brief Open the log file and start the background writer.
+
+            Records logged while the log is closed are discarded.
+
+            @param filename Path to the '.sblog' file. It is overwritten.
+            @return True if the file has been opened.
+        */
+        static bool open(const std::string& filename);
+
+        //! Write the pending records, stop the writer and close the file.
+        static void close();
+
+        //! Return true if the log is open.
+        static bool isOpen();
+
+        //! Wait until the records logged so far, by any thread, are written to the file.
+        static void flush();
+
+        //! Set the policy applied when a thread buffer is full (Logger::BLOCK or Logger::DROP).
+        static void setPolicy(uint policy);
+
+        //! Return the number of records discarded so far.
+        static ulong dropped();
+
+        /*!
+            @brief Register the format string of a call site. Called once per call site by SB_BLOG.
+
+            @param format Format string, with a "{}" for each argument. It must be a literal.
+            @param file Source file of the call site.
+            @param line Source line of the call site.
+            @return Id of the format.
+        */
+        template <typename... Args>
+        static uint site(const char* format, const char* file, uint line)
+        {
+            static const char types[] = {typeCode<Args>()..., '\0'};
+            return define(format, file, line, types);
+        }
+
+        //! Store a record: format id and raw arguments. Use SB_BLOG.
+        template <typename... Args>
+        static void write(uint id, const Args&... args)
+        {
+            if (!_open.load(std::memory_order_relaxed))
+                return;
+
+            const size_t size = HEADER_SIZE + (0 + ... + argumentSize(args));
+            char* record = reserve(size);
+            if (record == nullptr)
+                return;
+
+            char* p = record + HEADER_SIZE;
+            (encode(p, args), ...);
+            commit(record, id, size);
+        }
+
+        /*!
+            @brief Render a binary log as text, a line per record.
+
+            @param filename Path to the '.sblog' file.
+            @param output Stream of the text lines: thread, timestamp, source location and formatted message.
+            @return False if the file cannot be read or it is truncated.
+        */
+        static bool decode(const std::string& filename, std::ostream& output);
+
+    private:
+
+        //! Bytes before the arguments of a record: size, id, timestamp and thread.
+        static const size_t HEADER_SIZE = 20;
+
+        /*!
+            @brief Register a format string.
+
+            @param format Format string.
+            @param file Source file of the call site.
+            @param line Source line of the call site.
+            @param types Type code of each argument, one character per argument.
+            @return Id of the format.
+        */
+        static uint define(const char* format, const char* file, uint line, const char* types);
+
+        //! Return the type code of an argument type.
+        template <typename T>
+        static constexpr char typeCode()
+        {
+            if constexpr (std::is_same_v<T, bool>)
+                return 'b';
+            else if constexpr (std::is_same_v<T, char>)
+                return 'c';
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+                return 'i';
+            else if constexpr (std::is_integral_v<T>)
+                return 'u';
+            else if constexpr (std::is_floating_point_v<T>)
+                return 'd';
+            else
+            {
+                static_assert(std::is_convertible_v<T, std::string_view>, "BinaryLog: unsupported argument type");
+                return 's';
+            }
+        }
+
+        //! Return the size of an argument in a record.
+        template <typename T>
+        static size_t argumentSize(const T& arg)
+        {
+            constexpr char code = typeCode<std::decay_t<T>>();
+            if constexpr (code == 's')
+                return sizeof(uint) + std::min<size_t>(std::string_view(arg).size(), MAX_STRING);
+            else if constexpr (code == 'b' || code == 'c')
+                return 1;
+            else
+                return 8;
+        }
+
+        //! Copy an argument into a record: integers as 64 bits, reals as double, strings with their length.
+        template <typename T>
+        static void encode(char*& p, const T& arg)
+        {
+            constexpr char code = typeCode<std::decay_t<T>>();
+            if constexpr (code == 's')
+            {
+                const std::string_view str(arg);
+                const uint size = static_cast<uint>(std::min<size_t>(str.size(), MAX_STRING));
+                std::memcpy(p, &size, sizeof(uint));
+                std::memcpy(p + sizeof(uint), str.data(), size);
+                p += sizeof(uint) + size;
+            }
+            else if constexpr (code == 'b' || code == 'c')
+            {
+                *p++ = static_cast<char>(arg);
+            }
+            else
+            {
+                using Stored = std::conditional_t<code == 'i', long, std::conditional_t<code == 'u', ulong, double>>;
+                const Stored value = static_cast<Stored>(arg);
+                std::memcpy(p, &value, 8);
+                p += 8;
+            }
+        }
+
+        /*!
+            @brief Reserve room for a record in the ring of the calling thread.
+
+            @param size Size of the record in bytes.
+            @return Start of the record. Nullptr if the record is dropped.
+        */
+        static char* reserve(size_t size);
+
+        //! Fill the record header and publish the record to the writer.
+        static void commit(char* record, uint id, size_t size);
+
+        //! Return the buffers of the threads and their writer.
+        static LogWriter& writer();
+
+        //! Write the new format definitions, then a batch of records.
+        static void writeBatch(std::vector<char>& batch);
+
+        //! Write a buffer to the file, retrying partial writes.
+        static void writeFile(const char* data, size_t size);
+
+        //! True while the log is open.
+        static std::atomic<bool> _open;
+
+        //! Mutex which protects the definitions and the file changes.
+        static std::mutex _mutex;
+
+        //! Format definition entries, as written in the file.
+        static std::string _definitions;
+
+        //! Bytes of the definitions already written to the current file.
+        static size_t _written_definitions;
+
+        //! File descriptor of the open log.
+        static int _fd;
+    };
+}
+
+//! Log a record with deferred formatting (see BinaryLog). The lambda gives each call site its own format id.
+#define SB_BLOG(format, ...)                                                                                                            \
+    [](const auto&... sb_blog_args)                                                                                                     \
+    {                                                                                                                                   \
+        static const uint sb_blog_id = sb::utils::BinaryLog::site<std::decay_t<decltype(sb_blog_args)>...>(format, __FILE__, __LINE__); \
+        sb::utils::BinaryLog::write(sb_blog_id, sb_blog_args...);                                                                       \
+    }(__VA_ARGS__)
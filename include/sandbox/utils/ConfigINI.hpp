@@ -0,0 +1,136 @@
+/** @file ConfigINI.hpp
+ *  @brief Configuration file organized in sections of key-value pairs.
+ *
+ *  The file is parsed in place: sections, keys and values are views of
+ *  the mapped content, which the configuration owns, so no string is copied.
+ *  Pairs are stored in a flat hash table indexed by section and key.
+ *
+ *  Typed accessors parse a value the first time it is requested and keep
+ *  the result, so repeated lookups (eg. once per frame) cost a hash probe.
+ *  The cache makes lookups not thread safe: share a configuration between
+ *  threads only after the values have been read once.
+ *
+ *  Syntax:
+ *  - "[section]" starts a section, pairs before the first one have an empty section
+ *  - "key = value" defines a variable, blanks around key and value are ignored
+ *  - ';' and '#' start a comment until the end of the line
+ *  - a key repeated in the same section overrides the previous value
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+#include <sandbox/utils/MappedFile.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sb::utils
+{
+    class ConfigINI
+    {
+    public:
+
+        //! Constructor. Create an empty configuration.
+        ConfigINI() = default;
+
+        ConfigINI(const ConfigINI&) = delete;
+        ConfigINI& operator=(const ConfigINI&) = delete;
+
+        ConfigINI(ConfigINI&& other) = default;
+        ConfigINI& operator=(ConfigINI&& other) = default;
+
+        /*!
+            @brief Parse a configuration file, taking ownership of its content.
+
+            @param file Mapped content of the file.
+
+            @return False if a line is neither a section, a pair nor a comment. Pairs before that line are kept.
+        */
+        bool parse(MappedFile&& file);
+
+        //! Return the number of variables.
+        uint size() const;
+
+        //! Return true if a variable is defined.
+        bool contains(std::string_view section, std::string_view key) const;
+
+        /*!
+            @brief Return the raw value of a variable.
+
+            @param section Section name, empty for the variables before the first section.
+            @param key Variable name.
+            @param fallback Value returned if the variable is not defined.
+
+            @return View of the value. Valid as long as the configuration.
+        */
+        std::string_view get(std::string_view section, std::string_view key, std::string_view fallback = "") const;
+
+        //! Return a variable as integer, or the fallback if undefined or not a number.
+        int getInt(std::string_view section, std::string_view key, int fallback = 0) const;
+
+        //! Return a variable as float, or the fallback if undefined or not a number.
+        float getFloat(std::string_view section, std::string_view key, float fallback = 0.f) const;
+
+        //! Return a variable as double, or the fallback if undefined or not a number.
+        double getDouble(std::string_view section, std::string_view key, double fallback = 0.) const;
+
+        //! Return a variable as boolean: "0", "false" and "False" are false, any other value is true.
+        bool getBool(std::string_view section, std::string_view key, bool fallback = false) const;
+
+    private:
+
+        //! Variable, with the values parsed so far.
+        struct Entry
+        {
+            ulong hash;
+            std::string_view section;
+            std::string_view key;
+            std::string_view value;
+
+            //! Parsed types (see INTEGER, REAL), set on first access.
+            mutable uint parsed{0};
+
+            //! Parsed types which failed, so they are not parsed again.
+            mutable uint invalid{0};
+
+            mutable long integer{0};
+            mutable double real{0.};
+        };
+
+        //! Parsed type flags.
+        static const uint INTEGER = 1;
+        static const uint REAL = 2;
+
+        //! Return a view without the leading and trailing blanks.
+        static std::string_view trimmed(std::string_view str);
+
+        //! Return the hash of a variable.
+        static ulong hash(std::string_view section, std::string_view key);
+
+        //! Return the variable, nullptr if not defined.
+        const Entry* find(std::string_view section, std::string_view key) const;
+
+        //! Add a variable, replacing the value of an existing one.
+        void insert(std::string_view section, std::string_view key, std::string_view value);
+
+        //! Double the buckets and reinsert the variables.
+        void rehash();
+
+        //! Parse the value of an entry as integer, once. False if not an integer.
+        static bool integer(const Entry& entry);
+
+        //! Parse the value of an entry as real number, once. False if not a number.
+        static bool real(const Entry& entry);
+
+        //! Content of the file, referenced by the views.
+        MappedFile _file;
+
+        //! Variables, in file order.
+        std::vector<Entry> _entries;
+
+        //! Hash table of entry indices plus one (0 = empty bucket). Size is a power of two.
+        std::vector<uint> _buckets;
+    };
+}
@@ -0,0 +1,125 @@
+/** @file FrameStats.hpp
+ *  @brief Frame time statistics with percentiles.
+ *
+ *  Frame times (eg. from Timer::getFrameTime) are counted in a log-linear
+ *  histogram: 32 linear buckets per power of two, so percentiles have a
+ *  relative error below 3% whatever the range, in constant memory and
+ *  constant time per frame. Averages hide stutter: tail percentiles
+ *  (p99, p99.9) and jitter show it.
+ *
+ *  The last frames are also kept to summarize a rolling window, eg. to
+ *  show the current frame rate.
+ *
+ *  Example:
+ *  FrameStats stats;
+ *  while (running)
+ *      stats.add(timer.getFrameTime());
+ *  stats.save("frames.json");
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+#include <string>
+#include <vector>
+
+namespace sb::utils
+{
+    class FrameStats
+    {
+    public:
+
+        //! Summary of a set of frame times, in nanoseconds.
+        struct Summary
+        {
+            ulong count{0};
+            double mean{0};
+            double stddev{0};
+            double jitter{0};
+            ulong min{0};
+            ulong p50{0};
+            ulong p95{0};
+            ulong p99{0};
+            ulong p999{0};
+            ulong max{0};
+        };
+
+        /*!
+            @brief Constructor.
+
+            @param window Number of frames of the rolling window.
+        */
+        FrameStats(uint window = 120);
+
+        //! Add a frame time in nanoseconds.
+        void add(ulong frame_time);
+
+        //! Discard all the frames.
+        void reset();
+
+        //! Return the number of frames.
+        ulong count() const;
+
+        /*!
+            @brief Return a percentile of the frame times.
+
+            @param p Percentile, in [0, 100] (eg. 99.9).
+            @return Frame time in nanoseconds, within 3% of the exact one.
+        */
+        ulong percentile(double p) const;
+
+        //! Return the summary of all the frames.
+        Summary summary() const;
+
+        //! Return the summary of the frames of the rolling window. Percentiles are exact.
+        Summary window() const;
+
+        //! Copy the frame times of the rolling window, from the oldest (eg. to plot them).
+        void recent(std::vector<ulong>& frames) const;
+
+        /*!
+            @brief Save the statistics to file.
+
+            The format depends on the extension:
+            - '.json' summary, window summary and histogram
+            - '.csv' histogram, a row per non-empty bucket (lower and upper bound, count and cumulative percentage)
+
+            @param filename Path to the file.
+            @return True if the file has been written.
+        */
+        bool save(const std::string& filename) const;
+
+    private:
+
+        //! Linear buckets per power of two: 2^5.
+        static const uint SUB_BUCKET_BITS = 5;
+        static const uint SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+
+        //! Largest frame time counted, about 18 minutes. Longer ones are clamped.
+        static const ulong MAX_VALUE = (1ul << 40) - 1;
+
+        //! Return the bucket of a value.
+        static uint bucket(ulong value);
+
+        //! Return the smallest value of a bucket.
+        static ulong lowerBound(uint bucket);
+
+        //! Histogram of the frame times.
+        std::vector<ulong> _histogram;
+
+        //! Number of frames, and statistics for mean, deviation and jitter.
+        ulong _count;
+        ulong _min;
+        ulong _max;
+        double _sum;
+        double _sum_squares;
+        double _sum_jitter;
+        ulong _last;
+
+        //! Last frame times, as a ring: next slot and number of frames.
+        std::vector<ulong> _window;
+        uint _window_next;
+        uint _window_count;
+    };
+}
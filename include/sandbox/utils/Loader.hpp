@@ -5,23 +5,31 @@
 */
 #pragma once
 
+#include <sandbox/core/types.hpp>
+#include <sandbox/utils/MappedFile.hpp>
+#include <sandbox/utils/ConfigINI.hpp>
 #include <string>
-#include <map>
 
 namespace sb::utils
 {
-    //! Configuration file alias: primary key is the section string identifier, secondary is the variable name.
-    using ConfigINI = std::map< std::string, std::string>;
-
     class Loader
     {
     public:
 
         /*!
-            @brief Load a text file, line by line.
+            @brief Map a file in memory, without copying its content.
+
+            @param filename Path to the file to read.
+            @param advice Access pattern hint (see MappedFile).
+            @return Read-only view of the file content. Not open if the file cannot be read.
+        */
+        static MappedFile map(const std::string& filename, uint advice = MappedFile::SEQUENTIAL);
+
+        /*!
+            @brief Load a text file at once.
 
             @param filename Path to the text file to read.
-            @return File content as string. Lines are separated by '\n' character.
+            @return File content as string. Lines are separated by '\n' character, the last one included.
         */
         static std::string readFileTXT(const std::string& filename);
 
@@ -29,8 +37,8 @@ namespace sb::utils
             @brief Load a ini configuration file.
 
             @param filename Path to the config file to read.
-            @return File content as a map of variables organized in sections.
+            @return Variables organized in sections. Throw std::logic_error if the file cannot be read or parsed.
         */
-        static ConfigINI readFileINI(std::string& i_filename);
+        static ConfigINI readFileINI(const std::string& filename);
     };
 }
\ No newline at end of file
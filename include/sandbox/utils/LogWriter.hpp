@@ -0,0 +1,197 @@
+/** @file LogWriter.hpp
+ *  @brief Per-thread ring buffers drained to a file by a background thread.
+ *
+ *  Buffering shared by Logger and BinaryLog. Each thread copies its records
+ *  into its own ring buffer (single producer, single consumer), without
+ *  locks or system calls; the writer thread moves them into a batch and
+ *  hands it to the output function, which writes it with large writes.
+ *  Records of the same thread keep their order.
+ *
+ *  When a ring is full, the policy decides whether the thread waits for the
+ *  writer (BLOCK, default) or the record is discarded (DROP).
+ *
+ *  Example:
+ *  LogWriter writer([](std::vector<char>& batch) { write(fd, batch.data(), batch.size()); });
+ *  writer.start();
+ *  char* record = writer.reserve(size);
+ *  if (record != nullptr)
+ *  {
+ *      std::memcpy(record, data, size);
+ *      writer.commit();
+ *  }
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sb::utils
+{
+    class LogWriter
+    {
+    public:
+
+        //! Full ring policy: wait until the writer makes room.
+        static const uint BLOCK = 0;
+
+        //! Full ring policy: discard the record.
+        static const uint DROP = 1;
+
+        //! Largest record: larger ones are dropped, so a record always fits in an empty ring.
+        static const size_t MAX_RECORD = 1 << 14;
+
+        /*!
+            @brief Constructor. The writer is not started.
+
+            @param output Function which writes a batch of records, called by the thread draining the rings. The batch is cleared afterwards.
+        */
+        LogWriter(std::function<void(std::vector<char>& batch)> output);
+
+        //! Destructor. Stop the writer.
+        ~LogWriter();
+
+        LogWriter(const LogWriter&) = delete;
+        LogWriter& operator=(const LogWriter&) = delete;
+
+        //! Start the writer thread, if not running.
+        void start();
+
+        //! Stop the writer thread and write the pending records.
+        void stop();
+
+        //! Return true while the writer thread runs.
+        bool running() const;
+
+        /*!
+            @brief Reserve room for a record in the ring of the calling thread.
+
+            The record is contiguous and passed to the output as is, once committed.
+
+            @param size Size of the record in bytes.
+            @return Start of the record. Nullptr if the record is dropped.
+        */
+        char* reserve(size_t size);
+
+        //! Publish the record reserved by the calling thread to the writer.
+        void commit();
+
+        //! Return the index of the calling thread, in order of first record.
+        uint thread();
+
+        //! Wait until the records committed so far, by any thread, are written.
+        void flush();
+
+        //! Set the policy applied when a ring is full (BLOCK or DROP).
+        void setPolicy(uint policy);
+
+        //! Return the number of records discarded so far.
+        ulong dropped() const;
+
+        /*!
+            @brief Keep the writer from calling the output until resume (eg. to swap the output file).
+
+            Not to be called from the output function.
+        */
+        void pause();
+
+        //! Let the writer call the output again.
+        void resume();
+
+        /*!
+            @brief Write the pending records from a crash handler.
+
+            The writer may be the crashed thread, so it is waited for a short time only.
+        */
+        void drainAfterCrash();
+
+    private:
+
+        //! Ring buffer of records, written by a thread and read by the writer.
+        struct Ring;
+
+        //! Rings of the calling thread, by writer: they are released once the thread exits and they are drained.
+        struct RingHandle
+        {
+            Ring* rings[4]{};
+            ~RingHandle();
+        };
+
+        //! Return the ring of the calling thread, registering it on first use.
+        Ring* ring();
+
+        //! Body of the writer thread.
+        void run();
+
+        /*!
+            @brief Move the records of all the rings to the output.
+
+            @param batch Buffer reused between calls.
+            @return True if any record has been written.
+        */
+        bool drain(std::vector<char>& batch);
+
+        /*!
+            @brief Move the records of a ring into a batch. The batch is written when it gets large.
+
+            @param ring Ring to drain.
+            @param batch Buffer of records to write.
+        */
+        void drainRing(Ring& ring, std::vector<char>& batch);
+
+        //! Write and clear a batch.
+        void output(std::vector<char>& batch);
+
+        //! Function which writes the batches.
+        std::function<void(std::vector<char>& batch)> _output;
+
+        //! Index of the writer in the thread local handles.
+        uint _index;
+
+        //! Mutex which protects the ring list.
+        std::mutex _mutex;
+
+        //! Rings of the threads which committed at least a record.
+        std::vector<std::unique_ptr<Ring>> _rings;
+
+        //! Number of threads which committed at least a record.
+        uint _num_threads{0};
+
+        //! Background writer.
+        std::thread _writer;
+
+        //! True while the writer runs.
+        std::atomic<bool> _running{false};
+
+        //! Held while the output is called: the crash handler and pause take it too.
+        std::atomic_flag _draining = ATOMIC_FLAG_INIT;
+
+        //! Mutex and condition to wake up the writer and to wait for flushes.
+        std::mutex _wake_mutex;
+        std::condition_variable _wake;
+        std::condition_variable _flushed;
+
+        //! Flush requests, and requests served by the writer.
+        ulong _flush_requested{0};
+        ulong _flush_done{0};
+
+        //! Full ring policy.
+        std::atomic<uint> _policy{BLOCK};
+
+        //! Number of dropped records.
+        std::atomic<ulong> _dropped{0};
+
+        //! Number of writers created, which gives their index.
+        static std::atomic<uint> _num_writers;
+
+        //! Thread local owner of the rings of each thread.
+        static thread_local RingHandle _handle;
+    };
+}
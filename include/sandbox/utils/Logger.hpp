@@ -1,12 +1,36 @@
 /** @file Logger.hpp
  *  @brief Thread safe object to log messages to a text file.
- * 
+ *
+ *  Logging is asynchronous: each thread formats its messages into its own
+ *  ring buffer, without locks or system calls, and a background thread
+ *  drains the buffers into the logfile, which stays open, with large writes
+ *  (see LogWriter).
+ *  Lines of the same thread keep their order; lines of different threads
+ *  can be interleaved slightly out of order (each one has its timestamp).
+ *
+ *  When a thread buffer is full, the policy decides whether the thread
+ *  waits for the writer (BLOCK, default) or the message is discarded (DROP).
+ *  Dropped messages are counted and reported in the logfile.
+ *
+ *  The SB_LOG macros filter messages by severity and category: messages
+ *  below SB_LOG_LEVEL (set by the LOG_LEVEL CMake option) are compiled out,
+ *  arguments included; the others are written only if their category is
+ *  enabled at runtime (see setCategories), which costs a relaxed load.
+ *
+ *  Example:
+ *  SB_DEBUG(utils::Logger::GRAPHICS, "Shader " + name + " compiled");
+ *
  *  @author Marco Carletti
 */
 #pragma once
 
+#include <sandbox/core/types.hpp>
+#include <sandbox/utils/LogWriter.hpp>
+#include <atomic>
 #include <string>
+#include <string_view>
 #include <mutex>
+#include <vector>
 
 namespace sb::utils
 {
@@ -14,25 +38,75 @@ namespace sb::utils
     {
     public:
 
+        //! Full buffer policy: wait until the writer makes room.
+        static const uint BLOCK = LogWriter::BLOCK;
+
+        //! Full buffer policy: discard the message.
+        static const uint DROP = LogWriter::DROP;
+
+        //! Severity levels, from the most verbose.
+        static const uint TRACE = 0;
+        static const uint DEBUG = 1;
+        static const uint INFO = 2;
+        static const uint WARNING = 3;
+        static const uint ERROR = 4;
+
+        //! Categories, as bits of the runtime mask.
+        static const uint CORE = 1 << 0;
+        static const uint GRAPHICS = 1 << 1;
+        static const uint MATH = 1 << 2;
+        static const uint UTILS = 1 << 3;
+        static const uint APP = 1 << 4;
+        static const uint ALL = 0xFFFFFFFF;
+
         /*!
             @brief Write a message as a new line in the logfile.
 
-            Thread safe function. 
-            Each message will be enriched by a prefix composed by 
+            Thread safe function.
+            Each message will be enriched by a prefix composed by
             the thread id and the current timestamp.
+            The line is written in background: see flush.
 
             @param message String to be written in a new line in the logfile.
-            @param append Enable/disable append mode.
+            @param append Enable/disable append mode. If disabled, the logfile is cleared before writing the line.
         */
-        static void write(std::string message, bool append = true);
+        static void write(std::string_view message, bool append = true);
+
+        //! Wait until the lines logged so far, by any thread, are written to the logfile.
+        static void flush();
+
+        //! Set the categories whose messages are written by the SB_LOG macros (eg. CORE | GRAPHICS). Default is ALL.
+        static void setCategories(uint mask);
+
+        //! Return the mask of the enabled categories.
+        static uint categories();
+
+        //! Return true if any of the given categories is enabled.
+        static bool enabled(uint category)
+        {
+            return (_categories.load(std::memory_order_relaxed) & category) != 0;
+        }
+
+        //! Set the policy applied when a thread buffer is full (BLOCK or DROP).
+        static void setPolicy(uint policy);
+
+        //! Return the number of messages discarded so far (see DROP).
+        static ulong dropped();
+
+        /*!
+            @brief Set the path of the logfile. The lines logged so far are written to the previous file.
+
+            @param filename Path of the logfile, relative to the working directory. Default is "sandbox.log".
+        */
+        static void setFilename(const std::string& filename);
 
         /*!
             @brief Setup the stack tracer on a signals.
 
             This function should be called at the very beginning
             of the program. Signals are catched from that point.
-            Once a signal has been sent, the logger catches it
-            and prints the corresponding stack trace.
+            Once a signal has been sent, the logger catches it,
+            writes the pending lines and prints the corresponding stack trace.
 
             Common signals code are:
             - SIGSEGV [code = 11] Storage with an invalid access (aka, segmentation fault).
@@ -52,13 +126,61 @@ namespace sb::utils
         */
         static void stackTraceHandler(int signal_code);
 
+        //! Open the logfile and start the writer thread, once.
+        static void start();
+
+        //! Write the pending lines and stop the writer thread, at exit.
+        static void stop();
+
+        //! Return the buffers of the threads and their writer.
+        static LogWriter& writer();
+
+        //! Write a batch of lines to the logfile, after a warning if messages have been dropped since the last batch.
+        static void output(std::vector<char>& batch);
+
+        //! Format a line: thread id, timestamp, message and line break.
+        static void format(std::string& line, std::string_view message);
+
+        //! Write a buffer to the logfile, retrying partial writes.
+        static void writeFile(const char* data, size_t size);
+
         //! Path of the log text file.
         static std::string _log_fn;
 
         //! Path of the stack trace text file.
         static std::string _stack_trace_fn;
 
-        //! Mutex to make the logging thread safe.
+        //! Mutex which protects the logfile changes.
         static std::mutex _mutex;
+
+        //! Logfile descriptor, open for the whole execution.
+        static int _fd;
+
+        //! Mask of the enabled categories.
+        static std::atomic<uint> _categories;
     };
-}
\ No newline at end of file
+}
+
+//! Minimum severity compiled in: TRACE (0) in debug builds, INFO (2) otherwise.
+#ifndef SB_LOG_LEVEL
+#ifdef __Debug
+#define SB_LOG_LEVEL 0
+#else
+#define SB_LOG_LEVEL 2
+#endif
+#endif
+
+//! Write a message if its level is compiled in and its category is enabled. The message is not evaluated otherwise.
+#define SB_LOG(level, category, message)                                                                     \
+    do                                                                                                       \
+    {                                                                                                        \
+        if constexpr ((level) >= SB_LOG_LEVEL)                                                               \
+            if (sb::utils::Logger::enabled(category))                                                        \
+                sb::utils::Logger::write(message);                                                           \
+    } while (false)
+
+#define SB_TRACE(category, message) SB_LOG(sb::utils::Logger::TRACE, category, message)
+#define SB_DEBUG(category, message) SB_LOG(sb::utils::Logger::DEBUG, category, message)
+#define SB_INFO(category, message) SB_LOG(sb::utils::Logger::INFO, category, message)
+#define SB_WARNING(category, message) SB_LOG(sb::utils::Logger::WARNING, category, message)
+#define SB_ERROR(category, message) SB_LOG(sb::utils::Logger::ERROR, category, message)
@@ -0,0 +1,120 @@
+/** @file MappedFile.hpp
+ *  @brief Read-only view of a whole file, memory mapped when possible.
+ *
+ *  Mapping a file gives access to its content straight from the page
+ *  cache: no buffer is allocated and no data is copied until it is used.
+ *  An access pattern hint is passed to the kernel (madvise) so that pages
+ *  are read ahead (sequential parsing) or not (random lookups).
+ *
+ *  When the file cannot be mapped (eg. special files, or on request for
+ *  small files), its content is read with a single 'read' call into an
+ *  owned buffer. The view is the same in both cases.
+ *
+ *  Files packed in an Archive are viewed the same way: the view either
+ *  points into the archive mapping or owns the decompressed content.
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sb::utils
+{
+    class MappedFile
+    {
+    public:
+
+        //! No access pattern hint.
+        static const uint NORMAL = 0;
+
+        //! The file is read from start to end: pages are read ahead aggressively.
+        static const uint SEQUENTIAL = 1;
+
+        //! The file is accessed at random positions: read ahead is disabled.
+        static const uint RANDOM = 2;
+
+        //! The whole file is going to be used soon: all the pages are read ahead.
+        static const uint WILLNEED = 3;
+
+        //! Do not map: the file is read at once into an owned buffer.
+        static const uint READ = 4;
+
+        //! Constructor. Create an empty view.
+        MappedFile() = default;
+
+        //! Destructor. Unmap the file, if any.
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        //! Move constructor. The other view is left empty.
+        MappedFile(MappedFile&& other) noexcept;
+
+        //! Move assignment. The other view is left empty.
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        /*!
+            @brief Map a file, or read it if mapping fails.
+
+            @param filename Path to the file.
+            @param advice Access pattern hint (eg. SEQUENTIAL) or READ.
+
+            @return True if the file content is available.
+        */
+        bool open(const std::string& filename, uint advice = SEQUENTIAL);
+
+        //! Unmap the file or release the buffer.
+        void close();
+
+        //! Return true if a file is open, even if it is empty.
+        bool isOpen() const;
+
+        //! Return true if the file is memory mapped, false if it has been read into memory.
+        bool mapped() const;
+
+        //! Return a pointer to the file content. Nullptr if the file is empty.
+        const uchar* data() const;
+
+        //! Return the size of the file in bytes.
+        size_t size() const;
+
+        //! Return the file content as characters.
+        std::string_view view() const;
+
+    private:
+
+        friend class Archive;
+
+        //! Read the whole file with a single call, retrying only on partial reads.
+        bool read(int fd, size_t size);
+
+        //! View memory mapped by another object, which must outlive this view.
+        void borrow(const uchar* data, size_t size);
+
+        //! Take ownership of a buffer.
+        void adopt(std::vector<uchar>&& buffer);
+
+        //! Pointer to the content, either mapped or owned.
+        const uchar* _data{nullptr};
+
+        //! Size of the content in bytes.
+        size_t _size{0};
+
+        //! True if the content is memory mapped.
+        bool _mapped{false};
+
+        //! True if the mapping must be released by this object.
+        bool _owner{false};
+
+        //! True if a file is open.
+        bool _open{false};
+
+        //! Owned content, when the file is not mapped.
+        std::vector<uchar> _buffer;
+    };
+}
@@ -0,0 +1,166 @@
+/** @file Profiler.hpp
+ *  @brief Scoped CPU profiler with Chrome trace export.
+ *
+ *  SB_PROFILE_SCOPE("name") measures the enclosing scope: the zone is
+ *  stored, with its begin and end ticks (see Timer::getTicks), into a
+ *  buffer owned by the calling thread, so threads never contend.
+ *  Nested scopes are nested zones. Profiler::frame marks the frame
+ *  boundaries: each frame becomes a zone which contains the others.
+ *
+ *  Zones are recorded only while the profiler is enabled (one relaxed load
+ *  otherwise) and they are saved as Chrome trace JSON, which can be opened
+ *  by chrome://tracing or https://ui.perfetto.dev.
+ *
+ *  Example:
+ *  utils::Profiler::setEnabled(true);
+ *  while (running)
+ *  {
+ *      utils::Profiler::frame();
+ *      {
+ *          SB_PROFILE_SCOPE("draw");
+ *          ...
+ *      }
+ *  }
+ *  utils::Profiler::save("trace.json");
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+#include <sandbox/utils/Timer.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sb::utils
+{
+    class Profiler
+    {
+    public:
+
+        //! Maximum number of zones stored per thread, the others are dropped.
+        static const size_t CAPACITY = 1 << 16;
+
+        //! Zone of a scope, recorded when the scope ends. Use SB_PROFILE_SCOPE.
+        class Scope
+        {
+        public:
+
+            //! Constructor. The name must outlive the profiler (eg. a string literal).
+            explicit Scope(const char* name) : _name(name), _begin(enabled() ? Timer::getTicks() : 0) {}
+
+            //! Destructor. Record the zone.
+            ~Scope()
+            {
+                if (_begin != 0)
+                    record(_name, _begin, Timer::getTicks());
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+
+            //! Zone name.
+            const char* _name;
+
+            //! Begin time in ticks, 0 if the profiler was disabled.
+            ulong _begin;
+        };
+
+        //! Start or stop recording zones. Default is disabled.
+        static void setEnabled(bool enable);
+
+        //! Return true while zones are recorded.
+        static bool enabled()
+        {
+            return _enabled.load(std::memory_order_relaxed);
+        }
+
+        //! Mark the beginning of a new frame of the calling thread. The previous frame is recorded as a zone.
+        static void frame();
+
+        //! Set the name of the calling thread, shown in the trace.
+        static void setThreadName(const std::string& name);
+
+        /*!
+            @brief Save the recorded zones as Chrome trace JSON.
+
+            Zones of running threads can be saved: those ended so far are written.
+
+            @param filename Path to the '.json' file.
+            @return True if the file has been written.
+        */
+        static bool save(const std::string& filename);
+
+        //! Discard the recorded zones. Call it while the profiler is disabled.
+        static void clear();
+
+        //! Return the number of zones dropped because a thread buffer was full.
+        static ulong dropped();
+
+    private:
+
+        //! Zone: name and time interval in ticks (see Timer::getTicks), converted when saved.
+        struct Zone
+        {
+            const char* name;
+            ulong begin;
+            ulong end;
+        };
+
+        //! Zones of a thread, written by the thread only.
+        struct Buffer
+        {
+            //! Zones, allocated once with CAPACITY elements.
+            std::vector<Zone> zones;
+
+            //! Number of recorded zones, published to the readers.
+            std::atomic<size_t> size{0};
+
+            //! Begin time of the current frame in ticks, 0 if none.
+            ulong frame_begin{0};
+
+            //! Thread index and name.
+            uint thread{0};
+            std::string name;
+        };
+
+        //! Store a zone in the buffer of the calling thread.
+        static void record(const char* name, ulong begin, ulong end);
+
+        //! Return the buffer of the calling thread, registering it on first use.
+        static Buffer* buffer();
+
+        //! Append a JSON string, escaping quotes, backslashes and control characters.
+        static void appendString(std::string& json, std::string_view str);
+
+        //! Append nanoseconds as microseconds, with 3 decimals.
+        static void appendMicroseconds(std::string& json, ulong ns);
+
+        //! True while zones are recorded.
+        static std::atomic<bool> _enabled;
+
+        //! Number of dropped zones.
+        static std::atomic<ulong> _dropped;
+
+        //! Mutex which protects the buffer list and the thread names.
+        static std::mutex _mutex;
+
+        //! Buffers of the threads which recorded at least a zone. They are kept until exit, for saving.
+        static std::vector<std::unique_ptr<Buffer>> _buffers;
+
+        //! Buffer of the calling thread.
+        static thread_local Buffer* _buffer;
+    };
+}
+
+#define SB_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SB_PROFILE_CONCAT(a, b) SB_PROFILE_CONCAT_IMPL(a, b)
+
+//! Record the enclosing scope as a zone of the profiler (see Profiler).
+#define SB_PROFILE_SCOPE(name) sb::utils::Profiler::Scope SB_PROFILE_CONCAT(sb_profile_scope_, __LINE__)(name)
@@ -0,0 +1,78 @@
+/** @file ThreadPool.hpp
+ *  @brief Fixed set of worker threads which execute queued jobs.
+ * 
+ *  Jobs are executed in submission order, by the first idle worker.
+ *  Workers are started by the constructor and joined by the destructor,
+ *  after all the queued jobs have been completed.
+ * 
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <vector>
+
+namespace sb::utils
+{
+    class ThreadPool
+    {
+    public:
+
+        /*!
+            @brief Constructor. Start the worker threads.
+
+            @param num_threads Number of workers. If 0, use the number of hardware threads.
+        */
+        ThreadPool(uint num_threads = 0);
+
+        //! Destructor. Complete the queued jobs and join the worker threads.
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /*!
+            @brief Queue a job. Thread safe function.
+
+            @param job Function to be executed by a worker thread.
+        */
+        void push(std::function<void()> job);
+
+        //! Block the calling thread until all the queued jobs have been completed.
+        void wait();
+
+        //! Return the number of worker threads.
+        uint size() const;
+
+    private:
+
+        //! Worker loop: pop and execute jobs until the pool is stopped.
+        void work();
+
+        //! Worker threads.
+        std::vector<std::thread> _workers;
+
+        //! Jobs waiting for a worker.
+        std::queue<std::function<void()>> _jobs;
+
+        //! Number of jobs being executed.
+        uint _running{0};
+
+        //! True when the workers must exit.
+        bool _stop{false};
+
+        //! Mutex which protects the queue and the counters.
+        std::mutex _mutex;
+
+        //! Signaled when a job is queued or the pool is stopped.
+        std::condition_variable _job_available;
+
+        //! Signaled when a worker becomes idle.
+        std::condition_variable _job_done;
+    };
+}
@@ -4,13 +4,25 @@
  *  Chrono utility to get the current timestamp and compute
  *  application time intervals such as frame and wall time.
  * 
+ *  Hot paths (eg. profiling zones) read the CPU timestamp counter instead:
+ *  getTicks costs a few nanoseconds, against ~20 of steady_clock. The
+ *  counter is calibrated against steady_clock on the first use of the ticks
+ *  (which takes a few milliseconds, once) and it is used only if it is
+ *  invariant (constant rate, synchronized among the cores); otherwise ticks
+ *  are steady_clock nanoseconds.
+ * 
  *  @author Marco Carletti
 */
 #pragma once
 
 #include <sandbox/core/types.hpp>
+#include <atomic>
 #include <chrono>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
 namespace sb::utils
 {
     class Timer
@@ -37,6 +49,45 @@ namespace sb::utils
         //! Return system time in nanoseconds.
         static ulong getSystemTime();
 
+        //! Return the CPU timestamp counter, or steady_clock nanoseconds if the counter is not usable.
+        static ulong getTicks()
+        {
+            if (!_calibrated.load(std::memory_order_acquire))
+                initialize();
+
+#if defined(__x86_64__) || defined(__i386__)
+            if (_tsc)
+                return __rdtsc();
+#endif
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(getTime().time_since_epoch()).count();
+        }
+
+        //! Convert ticks to system time in nanoseconds (see getSystemTime).
+        static ulong toNanoseconds(ulong ticks)
+        {
+            if (!_calibrated.load(std::memory_order_acquire))
+                initialize();
+
+            if (!_tsc)
+                return ticks;
+
+            // signed: ticks read before the calibration are valid too
+            const __int128 delta = static_cast<__int128>(static_cast<long>(ticks - _tsc_base)) * _tsc_scale;
+            return _ns_base + static_cast<long>(delta >> 32);
+        }
+
+        //! Return system time in nanoseconds from the timestamp counter. Cheaper than getSystemTime.
+        static ulong getFastTime()
+        {
+            return toNanoseconds(getTicks());
+        }
+
+        //! Return true if the ticks come from the CPU timestamp counter.
+        static bool usesTSC();
+
+        //! Return the frequency of the ticks in Hz.
+        static double tickFrequency();
+
         //! Sleep calling thread for 'ms' milliseconds.
         static void sleep(ulong ms);
 
@@ -46,7 +97,33 @@ namespace sb::utils
     private:
 
         //! Retrieve current system clock.
-        static std::chrono::steady_clock::time_point getTime();
+        static std::chrono::steady_clock::time_point getTime()
+        {
+            return std::chrono::steady_clock::now();
+        }
+
+        //! Calibrate the ticks, once. Concurrent callers wait for the calibration.
+        static void initialize();
+
+        /*!
+            @brief Detect an invariant timestamp counter and measure its frequency against steady_clock.
+
+            @return True if the counter is used as tick source.
+        */
+        static bool calibrate();
+
+        //! True if the ticks come from the timestamp counter. Valid once calibrated.
+        static bool _tsc;
+
+        //! Counter and system time at the calibration.
+        static ulong _tsc_base;
+        static ulong _ns_base;
+
+        //! Nanoseconds per tick, fixed point 32.32.
+        static ulong _tsc_scale;
+
+        //! True once the ticks are calibrated, on their first use.
+        static std::atomic<bool> _calibrated;
 
         //! Reference time (t0).
         std::chrono::steady_clock::time_point _tstart;
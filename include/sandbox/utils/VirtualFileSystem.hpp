@@ -0,0 +1,74 @@
+/** @file VirtualFileSystem.hpp
+ *  @brief Resolve asset paths in the mounted archives before the disk.
+ *
+ *  Once an archive is mounted, the paths built by the application (eg. with
+ *  'utils::join') are looked up in it: Loader::map, and everything built on
+ *  it (shaders, textures, configuration files), reads the packed files
+ *  without touching the file system. Paths not found in any archive are
+ *  read from disk as usual.
+ *
+ *  Archives mounted later take precedence, so a patch archive can override
+ *  the files of a base one. Lookups are thread safe; archives are meant to be
+ *  mounted at startup and stay mounted while their files are in use.
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/utils/Archive.hpp>
+#include <sandbox/utils/MappedFile.hpp>
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace sb::utils
+{
+    class VirtualFileSystem
+    {
+    public:
+
+        /*!
+            @brief Mount an archive.
+
+            @param filename Path to the '.sbpak' file.
+
+            @return True if the archive has been mounted.
+        */
+        static bool mount(const std::string& filename);
+
+        /*!
+            @brief Unmount an archive. Views of its uncompressed files become invalid.
+
+            @param filename Path used to mount the archive.
+        */
+        static void unmount(const std::string& filename);
+
+        //! Return true if at least an archive is mounted.
+        static bool mounted();
+
+        //! Return true if a file is in a mounted archive.
+        static bool contains(const std::string& path);
+
+        /*!
+            @brief View the content of a file from the mounted archives.
+
+            @param path Path of the file.
+
+            @return View of the file content. Not open if no mounted archive contains the file.
+        */
+        static MappedFile map(const std::string& path);
+
+    private:
+
+        //! Mounted archives, in mounting order.
+        static std::vector<std::pair<std::string, std::unique_ptr<Archive>>> _archives;
+
+        //! Number of mounted archives, read without locking.
+        static std::atomic<uint> _num_archives;
+
+        //! Mutex which protects the archive list: shared by lookups, exclusive by (un)mounting.
+        static std::shared_mutex _mutex;
+    };
+}
@@ -0,0 +1,52 @@
+/** @file compression.hpp
+ *  @brief Fast lossless compression of memory blocks.
+ *
+ *  The format follows the LZ4 block layout: a sequence of tokens, each
+ *  made of a run of literal bytes and a back reference (offset, length)
+ *  to data already decoded, up to 64KB behind. Matches are found with a
+ *  single hash table of 4-byte sequences, so compression is fast and
+ *  decompression is little more than a memory copy.
+ *
+ *  References
+ *  https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+ *
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+#include <cstddef>
+
+namespace sb::utils
+{
+    /*!
+        @brief Return the maximum size of a compressed block.
+
+        @param i_size Size of the uncompressed block in bytes.
+        @return Size of the buffer to pass to 'compressLZ'.
+    */
+    size_t boundLZ(size_t i_size);
+
+    /*!
+        @brief Compress a memory block.
+
+        @param i_src Pointer to the data to compress.
+        @param i_size Size of the data in bytes.
+        @param o_dst Output buffer, at least 'boundLZ(i_size)' bytes.
+        @return Size of the compressed data in bytes.
+    */
+    size_t compressLZ(const uchar* i_src, size_t i_size, uchar* o_dst);
+
+    /*!
+        @brief Decompress a memory block.
+
+        Malformed input is detected: reads and writes never exceed the given sizes.
+
+        @param i_src Pointer to the compressed data.
+        @param i_size Size of the compressed data in bytes.
+        @param o_dst Output buffer.
+        @param i_dst_size Exact size of the decompressed data in bytes.
+        @return True if the block has been decompressed to exactly 'i_dst_size' bytes.
+    */
+    bool decompressLZ(const uchar* i_src, size_t i_size, uchar* o_dst, size_t i_dst_size);
+}
@@ -0,0 +1,40 @@
+/** @file hash.hpp
+ *  @brief Non-cryptographic hash functions for content identification.
+ * 
+ *  Hashes are 64-bit FNV-1a: fast, stable across runs and platforms,
+ *  so they can be stored on disk and compared between executions.
+ * 
+ *  References
+ *  http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ * 
+ *  @author Marco Carletti
+*/
+#pragma once
+
+#include <sandbox/core/types.hpp>
+#include <string>
+
+namespace sb::utils
+{
+    //! Seed of the FNV-1a hash (ie. 64-bit offset basis).
+    const ulong HASH_SEED = 14695981039346656037UL;
+
+    /*!
+        @brief Compute the hash of a memory block.
+
+        @param i_data Pointer to the first byte of the block.
+        @param i_size Size of the block in bytes.
+        @param i_seed Initial value. Pass the hash of a previous block to chain them.
+        @return 64-bit hash of the block.
+    */
+    ulong hash(const void* i_data, size_t i_size, ulong i_seed = HASH_SEED);
+
+    /*!
+        @brief Compute the hash of a string.
+
+        @param i_str String to hash.
+        @param i_seed Initial value. Pass the hash of a previous string to chain them.
+        @return 64-bit hash of the string.
+    */
+    ulong hash(const std::string& i_str, ulong i_seed = HASH_SEED);
+}
@@ -6,6 +6,8 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace sb::utils
@@ -15,24 +17,81 @@ namespace sb::utils
     std::string join(const std::vector<std::string>& i_strings, const std::string &i_connector = "");
     std::vector<std::string> split(const std::string &i_str, const std::string &i_separator = " ");
 
-    // conversion
-    int toInt(const std::string &i_str);
-    float toFloat(const std::string &i_str);
-    double toDouble(const std::string &i_str);
-    bool toBool(const std::string &i_str);
+    // tokenizing (tokens are views of the input string, nothing is allocated)
+
+    /*!
+        @brief Find the first delimiter in a range of characters. Scan 16 characters at a time with SSE2 (up to 4 delimiters).
+
+        @param i_begin First character of the range.
+        @param i_end End of the range.
+        @param i_delimiters Delimiter characters.
+        @return Position of the first delimiter, i_end if none.
+    */
+    const char* findFirstOf(const char* i_begin, const char* i_end, std::string_view i_delimiters);
+
+    class Tokenizer
+    {
+    public:
+
+        /*!
+            @brief Constructor.
+
+            @param i_str String to tokenize. It must outlive the tokenizer and its tokens.
+            @param i_delimiters Characters between tokens. Consecutive delimiters do not produce empty tokens.
+        */
+        Tokenizer(std::string_view i_str, std::string_view i_delimiters = " \t\r\n");
+
+        /*!
+            @brief Move to the next token.
+
+            @param o_token View of the token.
+            @return False if there are no more tokens.
+        */
+        bool next(std::string_view& o_token);
+
+    private:
+
+        //! Characters not yet tokenized.
+        const char* _pos;
+        const char* _end;
+
+        //! Delimiter characters.
+        std::string_view _delimiters;
+
+        //! Delimiter lookup table, to skip the runs of delimiters.
+        bool _is_delimiter[256]{};
+    };
+
+    //! Append the tokens of a string to a vector, which can be reused between calls to avoid allocations.
+    void tokenize(std::string_view i_str, std::vector<std::string_view>& o_tokens, std::string_view i_delimiters = " \t\r\n");
+
+    // conversion (leading blanks are skipped, parsing stops at the first invalid character, 0 if there is no number)
+    int toInt(std::string_view i_str);
+    float toFloat(std::string_view i_str);
+    double toDouble(std::string_view i_str);
+    bool toBool(std::string_view i_str);
 
     template <class T>
-    std::vector<T> toVec(const std::string &i_str)
+    std::vector<T> toVec(std::string_view i_str)
     {
         std::vector<T> vec;
-        for (const std::string &s : split(i_str))
-            vec.push_back((T)toFloat(s));
+        std::string_view token;
+        Tokenizer tokenizer(i_str);
+        while (tokenizer.next(token))
+        {
+            if constexpr (std::is_integral_v<T>)
+                vec.push_back(static_cast<T>(toInt(token)));
+            else if constexpr (std::is_same_v<T, float>)
+                vec.push_back(toFloat(token));
+            else
+                vec.push_back(static_cast<T>(toDouble(token)));
+        }
         return vec;
     }
 
-    std::vector<int> toVeci(const std::string &i_str);
-    std::vector<float> toVecf(const std::string &i_str);
-    std::vector<double> toVecd(const std::string &i_str);
+    std::vector<int> toVeci(std::string_view i_str);
+    std::vector<float> toVecf(std::string_view i_str);
+    std::vector<double> toVecd(std::string_view i_str);
 
     // print
     std::string pad(int i_num, char p = '0', uint i_len = 4);
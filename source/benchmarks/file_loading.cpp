@@ -0,0 +1,118 @@
+/*
+    Compare the ways of loading a text file into memory.
+
+    Usage: file_loading [size in MB]...
+
+    For each size, a text file is generated in the temporary folder and loaded with:
+    - getline   line by line with std::getline, appending each line (the former Loader::readFileTXT)
+    - readTXT   Loader::readFileTXT, a single copy from the mapped file into a string
+    - map       Loader::map, lines are counted straight from the mapping (zero copy)
+    - read      MappedFile::READ, the file is read with a single call into a buffer
+
+    Files are read from the page cache: each method runs once to warm it up,
+    then the best of a few runs is reported.
+*/
+#include <sandbox/utils/Loader.hpp>
+#include <sandbox/utils/MappedFile.hpp>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace sb;
+
+const uint RUNS = 5;
+
+string makeFile(size_t size)
+{
+    const string filename = (filesystem::temp_directory_path() / ("sandbox_file_loading_" + to_string(size) + ".txt")).string();
+    const string line = "vec3 position = model * vec4(position, 1.0); // a line of text\n";
+
+    ofstream file(filename);
+    for (size_t written = 0; written < size; written += line.size())
+        file << line;
+
+    return filename;
+}
+
+size_t countLines(string_view text)
+{
+    return static_cast<size_t>(count(text.begin(), text.end(), '\n'));
+}
+
+size_t loadGetline(const string& filename)
+{
+    ifstream file(filename);
+    string text("");
+    string line("");
+
+    while (getline(file, line))
+        text += line + '\n';
+
+    return countLines(text);
+}
+
+size_t loadReadTXT(const string& filename)
+{
+    return countLines(utils::Loader::readFileTXT(filename));
+}
+
+size_t loadMap(const string& filename)
+{
+    return countLines(utils::Loader::map(filename, utils::MappedFile::SEQUENTIAL).view());
+}
+
+size_t loadRead(const string& filename)
+{
+    return countLines(utils::Loader::map(filename, utils::MappedFile::READ).view());
+}
+
+void run(const string& name, const string& filename, size_t size, const function<size_t(const string&)>& load)
+{
+    size_t lines = load(filename);
+    double best = 1e30;
+
+    for (uint i = 0; i < RUNS; ++i)
+    {
+        auto t0 = chrono::steady_clock::now();
+        lines = load(filename);
+        auto t1 = chrono::steady_clock::now();
+        best = min(best, chrono::duration<double, milli>(t1 - t0).count());
+    }
+
+    cout << "  " << left << setw(10) << name << right << fixed << setprecision(2)
+         << setw(10) << best << " ms" << setw(10) << (size / 1048576.) / (best / 1000.) << " MB/s"
+         << "   (" << lines << " lines)" << endl;
+}
+
+int main(int argc, char** argv)
+{
+    vector<size_t> sizes;
+    for (int i = 1; i < argc; ++i)
+        sizes.push_back(stoul(argv[i]));
+
+    if (sizes.empty())
+        sizes = {1, 8, 64};
+
+    for (size_t mb : sizes)
+    {
+        const size_t size = mb * 1048576;
+        const string filename = makeFile(size);
+
+        cout << mb << " MB" << endl;
+        run("getline", filename, size, loadGetline);
+        run("readTXT", filename, size, loadReadTXT);
+        run("map", filename, size, loadMap);
+        run("read", filename, size, loadRead);
+
+        filesystem::remove(filename);
+    }
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*
+    Measure the logging throughput with concurrent threads.
+
+    Usage: logging [messages per thread] [threads]...
+
+    Each thread logs the given number of messages with:
+    - legacy    a global mutex and the logfile opened and closed for each line (the former Logger::write)
+    - block     Logger::write, waiting for the writer when a thread buffer is full
+    - drop      Logger::write, discarding the messages when a thread buffer is full
+    - binary    SB_BLOG, storing the arguments of the message and formatting them offline
+
+    Times include Logger::flush (BinaryLog::flush), so every line is in the file when the clock stops.
+    Logfiles are written in the temporary folder and removed at the end.
+*/
+#include <sandbox/utils/BinaryLog.hpp>
+#include <sandbox/utils/Logger.hpp>
+#include <sandbox/utils/Timer.hpp>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace sb;
+
+const string LEGACY_LOG = (filesystem::temp_directory_path() / "sandbox_logging_legacy.log").string();
+const string ASYNC_LOG = (filesystem::temp_directory_path() / "sandbox_logging_async.log").string();
+const string BINARY_LOG = (filesystem::temp_directory_path() / ("sandbox_logging" + utils::BinaryLog::EXTENSION)).string();
+
+mutex legacy_mutex;
+
+void legacyWrite(const string& message)
+{
+    stringstream ss;
+    ss << this_thread::get_id() << " " << utils::Timer::getSystemTime();
+    string text = ss.str() + " " + message + "\n";
+
+    lock_guard<mutex> lock(legacy_mutex);
+    fstream fs;
+    fs.open(LEGACY_LOG, ios::in | ios::out | ios::app);
+    fs.write(text.c_str(), text.size());
+    fs.close();
+}
+
+void run(const string& name, uint threads, uint messages, const function<void(uint, uint)>& write)
+{
+    auto t0 = chrono::steady_clock::now();
+
+    vector<thread> workers;
+    for (uint t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([t, messages, &write]()
+        {
+            for (uint i = 0; i < messages; ++i)
+                write(t, i);
+        });
+    }
+
+    for (thread& worker : workers)
+        worker.join();
+    utils::Logger::flush();
+    utils::BinaryLog::flush();
+
+    auto t1 = chrono::steady_clock::now();
+    const double ms = chrono::duration<double, milli>(t1 - t0).count();
+
+    cout << "  " << left << setw(8) << name << right << fixed << setprecision(2)
+         << setw(10) << ms << " ms" << setw(12) << (threads * messages) / (ms / 1000.) / 1e6 << " M lines/s";
+    if (name == "drop")
+        cout << "   (" << utils::Logger::dropped() << " dropped so far)";
+    if (name == "binary")
+        cout << "   (" << utils::BinaryLog::dropped() << " dropped so far)";
+    cout << endl;
+}
+
+int main(int argc, char** argv)
+{
+    uint messages = argc > 1 ? stoul(argv[1]) : 100000;
+
+    vector<uint> threads;
+    for (int i = 2; i < argc; ++i)
+        threads.push_back(stoul(argv[i]));
+
+    if (threads.empty())
+        threads = {1, 2, 4, 8};
+
+    utils::Logger::setFilename(ASYNC_LOG);
+    utils::BinaryLog::open(BINARY_LOG);
+
+    // the text messages are formatted as the binary ones are decoded
+    auto message = [](uint t, uint i) { return "ERROR::BENCHMARK::MESSAGE thread " + to_string(t) + " line " + to_string(i) + " of a typical log"; };
+
+    for (uint n : threads)
+    {
+        cout << n << " threads, " << messages << " messages each" << endl;
+
+        // the legacy path is much slower: it logs a tenth of the messages
+        run("legacy", n, max(1u, messages / 10), [&message](uint t, uint i) { legacyWrite(message(t, i)); });
+
+        utils::Logger::setPolicy(utils::Logger::BLOCK);
+        run("block", n, messages, [&message](uint t, uint i) { utils::Logger::write(message(t, i)); });
+
+        utils::Logger::setPolicy(utils::Logger::DROP);
+        run("drop", n, messages, [&message](uint t, uint i) { utils::Logger::write(message(t, i)); });
+
+        run("binary", n, messages, [](uint t, uint i) { SB_BLOG("ERROR::BENCHMARK::MESSAGE thread {} line {} of a typical log", t, i); });
+    }
+
+    utils::BinaryLog::close();
+
+    filesystem::remove(LEGACY_LOG);
+    filesystem::remove(ASYNC_LOG);
+    filesystem::remove(BINARY_LOG);
+
+    return 0;
+}
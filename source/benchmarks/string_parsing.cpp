@@ -0,0 +1,180 @@
+/*
+    Compare the ways of parsing numbers from text.
+
+    Usage: string_parsing [size in MB]...
+
+    For each size, two texts are generated in memory: a mesh dump (lines of
+    "v x y z" and "f a b c") and a matrix dump (rows of space separated reals).
+    Each text is parsed with:
+    - split     utils::split by line and by space, then atof (the former utils::toFloat)
+    - stream    std::istringstream extraction
+    - find      std::string_view::find_first_of to tokenize, utils::toDouble to convert
+    - tokenizer utils::Tokenizer (SSE2 delimiter scan) and utils::toDouble
+
+    The best of a few runs is reported; the checksum (sum of the numbers) must match.
+*/
+#include <sandbox/core/types.hpp>
+#include <sandbox/utils/string.hpp>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace sb;
+
+const uint RUNS = 5;
+
+const string_view DELIMITERS = " \t\r\n";
+
+string makeMesh(size_t size)
+{
+    mt19937 rng(7);
+    uniform_real_distribution<double> coordinate(-100., 100.);
+    uniform_int_distribution<int> index(1, 100000);
+
+    string text;
+    text.reserve(size + 64);
+    ostringstream line;
+    line << fixed << setprecision(6);
+
+    for (uint i = 0; text.size() < size; ++i)
+    {
+        line.str("");
+        if (i % 3 == 2)
+            line << "f " << index(rng) << " " << index(rng) << " " << index(rng) << "\n";
+        else
+            line << "v " << coordinate(rng) << " " << coordinate(rng) << " " << coordinate(rng) << "\n";
+        text += line.str();
+    }
+
+    return text;
+}
+
+string makeMatrix(size_t size)
+{
+    mt19937 rng(11);
+    normal_distribution<double> value(0., 1.);
+
+    string text;
+    text.reserve(size + 512);
+    ostringstream row;
+    row << setprecision(17);
+
+    while (text.size() < size)
+    {
+        row.str("");
+        for (uint j = 0; j < 16; ++j)
+            row << value(rng) << (j < 15 ? " " : "\n");
+        text += row.str();
+    }
+
+    return text;
+}
+
+// keywords ("v", "f") are skipped: they do not start with a number
+bool isNumber(string_view token)
+{
+    return !token.empty() && token[0] != 'v' && token[0] != 'f';
+}
+
+double parseSplit(const string& text)
+{
+    double sum = 0.;
+    for (const string& line : utils::split(text, "\n"))
+        for (const string& token : utils::split(line, " "))
+            if (isNumber(token))
+                sum += atof(token.c_str());
+
+    return sum;
+}
+
+double parseStream(const string& text)
+{
+    double sum = 0.;
+    istringstream stream(text);
+    string token;
+    while (stream >> token)
+        if (isNumber(token))
+            sum += stod(token);
+
+    return sum;
+}
+
+double parseFind(const string& text)
+{
+    double sum = 0.;
+    string_view view = text;
+    size_t pos = 0;
+    while ((pos = view.find_first_not_of(DELIMITERS, pos)) != string_view::npos)
+    {
+        size_t end = min(view.find_first_of(DELIMITERS, pos), view.size());
+        string_view token = view.substr(pos, end - pos);
+        if (isNumber(token))
+            sum += utils::toDouble(token);
+        pos = end;
+    }
+
+    return sum;
+}
+
+double parseTokenizer(const string& text)
+{
+    double sum = 0.;
+    string_view token;
+    utils::Tokenizer tokenizer(text, DELIMITERS);
+    while (tokenizer.next(token))
+        if (isNumber(token))
+            sum += utils::toDouble(token);
+
+    return sum;
+}
+
+void run(const string& name, const string& text, const function<double(const string&)>& parse)
+{
+    double checksum = parse(text);
+    double best = 1e30;
+
+    for (uint i = 0; i < RUNS; ++i)
+    {
+        auto t0 = chrono::steady_clock::now();
+        checksum = parse(text);
+        auto t1 = chrono::steady_clock::now();
+        best = min(best, chrono::duration<double, milli>(t1 - t0).count());
+    }
+
+    cout << "  " << left << setw(10) << name << right << fixed << setprecision(2)
+         << setw(10) << best << " ms" << setw(10) << (text.size() / 1048576.) / (best / 1000.) << " MB/s"
+         << "   (checksum " << setprecision(4) << checksum << ")" << endl;
+}
+
+int main(int argc, char** argv)
+{
+    vector<size_t> sizes;
+    for (int i = 1; i < argc; ++i)
+        sizes.push_back(stoul(argv[i]));
+
+    if (sizes.empty())
+        sizes = {4, 16};
+
+    for (size_t mb : sizes)
+    {
+        const size_t size = mb * 1048576;
+
+        for (const auto& [kind, text] : {pair<string, string>{"mesh", makeMesh(size)}, pair<string, string>{"matrix", makeMatrix(size)}})
+        {
+            cout << mb << " MB " << kind << endl;
+            run("split", text, parseSplit);
+            run("stream", text, parseStream);
+            run("find", text, parseFind);
+            run("tokenizer", text, parseTokenizer);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+/*
+    Measure the cost of reading the clock sources.
+
+    Usage: timing [iterations]
+
+    Each row reads the clock in a loop and prints the average cost of a read:
+    - steady_clock      std::chrono::steady_clock::now
+    - getSystemTime     Timer::getSystemTime (steady_clock nanoseconds)
+    - getTicks          Timer::getTicks (timestamp counter, if invariant)
+    - getFastTime       Timer::getFastTime (timestamp counter converted to nanoseconds)
+    - profile scope     SB_PROFILE_SCOPE with the profiler enabled (two ticks and a store)
+
+    The drift between getFastTime and getSystemTime is printed at the end.
+*/
+#include <sandbox/utils/Profiler.hpp>
+#include <sandbox/utils/Timer.hpp>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace sb;
+
+// sum of the values read, printed to keep the loops alive
+ulong sink = 0;
+
+void run(const string& name, ulong iterations, const function<void(ulong)>& loop)
+{
+    auto t0 = chrono::steady_clock::now();
+    loop(iterations);
+    auto t1 = chrono::steady_clock::now();
+
+    const double ns = chrono::duration<double, nano>(t1 - t0).count() / iterations;
+    cout << "  " << left << setw(16) << name << right << fixed << setprecision(2) << setw(8) << ns << " ns" << endl;
+}
+
+int main(int argc, char** argv)
+{
+    ulong iterations = argc > 1 ? stoul(argv[1]) : 10000000;
+
+    cout << "tick source: " << (utils::Timer::usesTSC() ? "timestamp counter" : "steady_clock")
+         << " at " << fixed << setprecision(3) << utils::Timer::tickFrequency() * 1e-9 << " GHz" << endl;
+
+    run("steady_clock", iterations, [](ulong n) { for (ulong i = 0; i < n; ++i) sink += chrono::steady_clock::now().time_since_epoch().count(); });
+    run("getSystemTime", iterations, [](ulong n) { for (ulong i = 0; i < n; ++i) sink += utils::Timer::getSystemTime(); });
+    run("getTicks", iterations, [](ulong n) { for (ulong i = 0; i < n; ++i) sink += utils::Timer::getTicks(); });
+    run("getFastTime", iterations, [](ulong n) { for (ulong i = 0; i < n; ++i) sink += utils::Timer::getFastTime(); });
+
+    // zones beyond the buffer capacity are dropped: the loop is split in rounds
+    utils::Profiler::setEnabled(true);
+    run("profile scope", iterations, [](ulong n)
+    {
+        for (ulong i = 0; i < n; ++i)
+        {
+            if (i % utils::Profiler::CAPACITY == 0)
+                utils::Profiler::clear();
+            SB_PROFILE_SCOPE("zone");
+        }
+    });
+    utils::Profiler::setEnabled(false);
+
+    const long drift = static_cast<long>(utils::Timer::getFastTime() - utils::Timer::getSystemTime());
+    cout << "drift: " << drift << " ns (" << sink % 10 << ")" << endl;
+
+    return 0;
+}
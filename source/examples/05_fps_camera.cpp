@@ -1,5 +1,7 @@
 #include <sandbox/sandbox.hpp>
 #include <sandbox/graphics/Texture.hpp>
+#include <sandbox/graphics/TextureLoader.hpp>
+#include <sandbox/utils/filesystem.hpp>
 #include <cmath>
 
 using namespace std;
@@ -11,24 +13,24 @@ using namespace sb;
 #define PRINT(msg) {}
 #endif
 
-void waitToRefresh(real target_fps, real& elapsed_time_s)
+int main(int argc, char* argv[])
 {
-    if (abs(target_fps) < EPS)
-        return;
-
-    real min_target_delay_us = (1000. / target_fps) * 1e3;
-    real elapsed_time_us = elapsed_time_s * 1e6;
+    utils::Logger::setSignalHandler(11);
 
-    if (elapsed_time_us < min_target_delay_us)
+    // run with --profile to record a trace of the frames,
+    // with --stats to save the frame time statistics
+    bool profile = false, stats = false;
+    for (int i = 1; i < argc; ++i)
     {
-        utils::Timer::usleep(min_target_delay_us - elapsed_time_us);
-        elapsed_time_s = min_target_delay_us * 1e-6;
+        profile |= string(argv[i]) == "--profile";
+        stats |= string(argv[i]) == "--stats";
     }
-}
 
-int main(int argc, char* argv[])
-{
-    utils::Logger::setSignalHandler(11);
+    if (profile)
+    {
+        utils::Profiler::setEnabled(true);
+        utils::Profiler::setThreadName("main");
+    }
 
     sb::Window window;
     Input input(&window);
@@ -38,96 +40,153 @@ int main(int argc, char* argv[])
     input.setMousePosition(win_width / 2, win_height / 2);
 
     string title = "05_fps_camera";
-    real target_fps = 0.;
+    real target_fps = 60.;
 
     window.setTitle(title);
 
+    // packed assets, when available, are read from the archive
+    if (utils::exists("assets.sbpak"))
+        utils::VirtualFileSystem::mount("assets.sbpak");
+
     string vs_path = utils::join({"assets/shaders/examples/", title, "/vertex.glsl"});
     string fs_path = utils::join({"assets/shaders/examples/", title, "/fragment.glsl"});
-    Shader* shader = Shader::create(vs_path, fs_path);
+
+    // submit the shader program first: the driver compiles
+    // it while the textures are being loaded
+    ShaderBatch shader_batch;
+    ShaderBatch::Handle shader_handle = shader_batch.add(vs_path, fs_path);
+
+    // textures are decoded in background: placeholders are
+    // bound until the images are uploaded in the render loop
+    Texture texture1(GL_RGB);
+    Texture texture2(GL_RGB);
+
+    TextureLoader texture_loader;
+    texture_loader.load(texture1, utils::join({"assets/textures/examples/", title, "/container.jpg"}));
+    texture_loader.load(texture2, utils::join({"assets/textures/examples/", title, "/wood.png"}));
+
+    Shader* shader = shader_batch.get(shader_handle);
     assert(shader);
     shader->use();
-
-    Texture texture1(utils::join({"assets/textures/examples/", title, "/container.jpg"}), GL_RGB);
-    Texture texture2(utils::join({"assets/textures/examples/", title, "/wood.png"}), GL_RGB);
     shader->setInt("texture_data", 0);
 
-    VAO cube({
-        // position (xyz)     // normal (xyz)      // color (rgb)       // texture (st)
-         0.5f,  0.5f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 1.0f,
-         0.5f, -0.5f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 0.0f,
-        -0.5f, -0.5f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 0.0f,
-        -0.5f, -0.5f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 0.0f,
-        -0.5f,  0.5f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 1.0f,
-         0.5f,  0.5f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 1.0f,
-
-        -0.5f, -0.5f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 0.0f,
-         0.5f, -0.5f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 0.0f,
-         0.5f,  0.5f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 1.0f,
-         0.5f,  0.5f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 1.0f,
-        -0.5f,  0.5f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 1.0f,
-        -0.5f, -0.5f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 0.0f,
-
-        -0.5f,  0.5f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 0.0f,
-        -0.5f,  0.5f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 1.0f,
-        -0.5f, -0.5f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 1.0f,
-        -0.5f, -0.5f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 1.0f,
-        -0.5f, -0.5f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 0.0f,
-        -0.5f,  0.5f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 0.0f,
-
-         0.5f, -0.5f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 1.0f,
-         0.5f,  0.5f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 1.0f,
-         0.5f,  0.5f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 0.0f,
-         0.5f,  0.5f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 0.0f,
-         0.5f, -0.5f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 0.0f,
-         0.5f, -0.5f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 1.0f,
-
-        -0.5f, -0.5f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 1.0f,
-         0.5f, -0.5f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 1.0f,
-         0.5f, -0.5f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 0.0f,
-         0.5f, -0.5f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 0.0f,
-        -0.5f, -0.5f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 0.0f,
-        -0.5f, -0.5f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 1.0f,
-
-         0.5f,  0.5f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 0.0f,
-         0.5f,  0.5f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 1.0f,
-        -0.5f,  0.5f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 1.0f,
-        -0.5f,  0.5f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 1.0f,
-        -0.5f,  0.5f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 0.0f,
-         0.5f,  0.5f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 0.0f,
-    }, {}, 11);
-
-    VAO plane({
-        // position (xyz)     // normal (xyz)      // color (rgb)       // texture (st)
-        -0.5f,  0.0f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 1.0f,
-        -0.5f,  0.0f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 0.0f,
-         0.5f,  0.0f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 0.0f,
-        -0.5f,  0.0f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  1.0f, 1.0f,
-         0.5f,  0.0f,  0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 0.0f,
-         0.5f,  0.0f, -0.5f,  0.00,  0.00,  0.00,  0.00,  0.00,  0.00,  0.0f, 1.0f,
-    }, {}, 11);
+    // position and texture coords only: 20 bytes per vertex
+    VertexLayout layout;
+    layout.add(0, 3, GL_FLOAT)
+          .add(3, 2, GL_FLOAT);
+
+    vector<float> cube_vertices = {
+        // position (xyz)    // texture (st)
+         0.5f,  0.5f, -0.5f,  1.0f,  1.0f,
+         0.5f, -0.5f, -0.5f,  1.0f,  0.0f,
+        -0.5f, -0.5f, -0.5f,  0.0f,  0.0f,
+        -0.5f, -0.5f, -0.5f,  0.0f,  0.0f,
+        -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,
+         0.5f,  0.5f, -0.5f,  1.0f,  1.0f,
+
+        -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,
+         0.5f, -0.5f,  0.5f,  1.0f,  0.0f,
+         0.5f,  0.5f,  0.5f,  1.0f,  1.0f,
+         0.5f,  0.5f,  0.5f,  1.0f,  1.0f,
+        -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,
+        -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,
+
+        -0.5f,  0.5f,  0.5f,  1.0f,  0.0f,
+        -0.5f,  0.5f, -0.5f,  1.0f,  1.0f,
+        -0.5f, -0.5f, -0.5f,  0.0f,  1.0f,
+        -0.5f, -0.5f, -0.5f,  0.0f,  1.0f,
+        -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,
+        -0.5f,  0.5f,  0.5f,  1.0f,  0.0f,
+
+         0.5f, -0.5f, -0.5f,  0.0f,  1.0f,
+         0.5f,  0.5f, -0.5f,  1.0f,  1.0f,
+         0.5f,  0.5f,  0.5f,  1.0f,  0.0f,
+         0.5f,  0.5f,  0.5f,  1.0f,  0.0f,
+         0.5f, -0.5f,  0.5f,  0.0f,  0.0f,
+         0.5f, -0.5f, -0.5f,  0.0f,  1.0f,
+
+        -0.5f, -0.5f, -0.5f,  0.0f,  1.0f,
+         0.5f, -0.5f, -0.5f,  1.0f,  1.0f,
+         0.5f, -0.5f,  0.5f,  1.0f,  0.0f,
+         0.5f, -0.5f,  0.5f,  1.0f,  0.0f,
+        -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,
+        -0.5f, -0.5f, -0.5f,  0.0f,  1.0f,
+
+         0.5f,  0.5f,  0.5f,  1.0f,  0.0f,
+         0.5f,  0.5f, -0.5f,  1.0f,  1.0f,
+        -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,
+        -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,
+        -0.5f,  0.5f,  0.5f,  0.0f,  0.0f,
+         0.5f,  0.5f,  0.5f,  1.0f,  0.0f,
+    };
+    VAO cube(cube_vertices.data(), sizeof(float) * cube_vertices.size(), layout);
+
+    vector<float> plane_vertices = {
+        // position (xyz)    // texture (st)
+        -0.5f,  0.0f, -0.5f,  1.0f,  1.0f,
+        -0.5f,  0.0f,  0.5f,  1.0f,  0.0f,
+         0.5f,  0.0f,  0.5f,  0.0f,  0.0f,
+        -0.5f,  0.0f, -0.5f,  1.0f,  1.0f,
+         0.5f,  0.0f,  0.5f,  0.0f,  0.0f,
+         0.5f,  0.0f, -0.5f,  0.0f,  1.0f,
+    };
+    VAO plane(plane_vertices.data(), sizeof(float) * plane_vertices.size(), layout);
+
+    // vsync when available, software pacing otherwise
+    FramePacer pacer(&window);
+    if (!pacer.setSwapInterval(1))
+        pacer.setTargetFPS(target_fps);
 
     utils::Timer timer;
+    utils::Timer title_timer;
+    utils::FrameStats frame_stats;
+
+    // frame times and render counters, F1 to show or hide
+    Overlay overlay(&window);
 
     Camera camera(&window, 45., 0.1, 100.);
     real base_speed = camera.speed();
 
     while (true)
     {
-        real delta_t = timer.getFrameTime() * 1e-9;
+        utils::Profiler::frame();
 
-        waitToRefresh(target_fps, delta_t);
-        
-        if (!window.focused())
+        // unfocused frames are throttled and skipped, out of the frame time
+        if (!pacer.wait())
+        {
+            timer.getFrameTime();
             continue;
+        }
+
+        ulong frame_time = timer.getFrameTime();
+        real delta_t = frame_time * 1e-9;
+
+        // frame rate and tail frame time of the last frames, once per second
+        frame_stats.add(frame_time);
+        if (title_timer.getWallTime() > 1e9)
+        {
+            utils::FrameStats::Summary last = frame_stats.window();
+            window.setTitle(title + " | " + utils::pad(1e9 / last.mean, ' ', 6, 1) + " fps | p99 " + utils::pad(last.p99 * 1e-6, ' ', 5, 1) + " ms");
+            title_timer.restart();
+        }
 
         window.update();
         input.update();
         camera.update();
 
+        // one upload per frame at most, to keep the frame time stable
+        if (texture_loader.pending() > 0)
+        {
+            SB_PROFILE_SCOPE("textures");
+            texture_loader.update(1);
+        }
+
         if (input.isKeyPressed(KEY_q) || input.isKeyDown(KEY_Escape))
             break;
 
+        if (input.isKeyPressed(KEY_F1))
+            overlay.toggle();
+
         real speed = input.isMouseButtonDown(MOUSE_Button1) ? base_speed * 2. : base_speed;
         camera.setSpeed(speed);
 
@@ -170,6 +229,10 @@ int main(int argc, char* argv[])
         mat4 view = camera.view();
         mat4 projection_view_mtx = projection.matmul(view);
 
+        SB_PROFILE_SCOPE("draw");
+
+        // the overlay uses its own program
+        shader->use();
         {
             mat4 model;
             model = rotate(model, timer.getWallTime() * 1e-9, {.5, 1., 0.});
@@ -187,9 +250,17 @@ int main(int argc, char* argv[])
             texture2.bind(0);
             plane.draw();
         }
+
+        overlay.draw(frame_stats);
+        RenderStats::frame();
     }
 
     delete shader;
 
+    if (profile)
+        utils::Profiler::save(title + ".trace.json");
+    if (stats)
+        frame_stats.save(title + ".frames.json");
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include <sandbox/core/FramePacer.hpp>
+#include <sandbox/utils/Logger.hpp>
+#include <sandbox/utils/Profiler.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <time.h>
+
+namespace sb
+{
+    // spin margin before a deadline: the measured overshoot, within these bounds
+    const ulong PACER_MIN_MARGIN = 50000;
+    const ulong PACER_MAX_MARGIN = 2000000;
+
+    // initial overshoot, before the first measure
+    const double PACER_INITIAL_OVERSHOOT = 100000.;
+
+    // weight of the last measure in the overshoot average
+    const double PACER_OVERSHOOT_WEIGHT = 0.1;
+
+    typedef void (*SwapIntervalEXT)(Display*, GLXDrawable, int);
+    typedef int (*SwapIntervalMESA)(unsigned int);
+
+    FramePacer::FramePacer(Window* window, real target_fps) :
+        _window(window),
+        _swap_interval(0),
+        _period(0),
+        _idle_period(0),
+        _deadline(0),
+        _overshoot(PACER_INITIAL_OVERSHOOT)
+    {
+        assert(_window != nullptr);
+        setTargetFPS(target_fps);
+        setIdleFPS(10);
+    }
+
+    bool FramePacer::setSwapInterval(int interval)
+    {
+        Display* display = _window->display();
+        const char* extensions = glXQueryExtensionsString(display, DefaultScreen(display));
+        auto supported = [extensions](const char* name)
+        {
+            // whole names only: an extension can be the prefix of another one
+            const size_t length = std::strlen(name);
+            for (const char* p = extensions; p != nullptr && (p = std::strstr(p, name)) != nullptr; p += length)
+                if ((p == extensions || p[-1] == ' ') && (p[length] == ' ' || p[length] == '\0'))
+                    return true;
+            return false;
+        };
+
+        bool done = false;
+        if (extensions != nullptr && supported("GLX_EXT_swap_control"))
+        {
+            auto swapInterval = reinterpret_cast<SwapIntervalEXT>(glXGetProcAddress(reinterpret_cast<const GLubyte*>("glXSwapIntervalEXT")));
+            if (swapInterval != nullptr)
+            {
+                swapInterval(display, _window->xid(), interval);
+                done = true;
+            }
+        }
+        else if (extensions != nullptr && supported("GLX_MESA_swap_control"))
+        {
+            auto swapInterval = reinterpret_cast<SwapIntervalMESA>(glXGetProcAddress(reinterpret_cast<const GLubyte*>("glXSwapIntervalMESA")));
+            done = swapInterval != nullptr && swapInterval(static_cast<unsigned int>(interval)) == 0;
+        }
+
+        if (!done)
+        {
+            SB_WARNING(utils::Logger::CORE, "WARNING::FRAMEPACER::SWAP_CONTROL_NOT_SUPPORTED fallback to software pacing");
+            _swap_interval = 0;
+            return false;
+        }
+
+        _swap_interval = interval;
+        return true;
+    }
+
+    int FramePacer::swapInterval() const
+    {
+        return _swap_interval;
+    }
+
+    void FramePacer::setTargetFPS(real fps)
+    {
+        _period = (fps > 0) ? static_cast<ulong>(1e9 / fps) : 0;
+        _deadline = 0;
+    }
+
+    void FramePacer::setIdleFPS(real fps)
+    {
+        _idle_period = (fps > 0) ? static_cast<ulong>(1e9 / fps) : 0;
+    }
+
+    bool FramePacer::wait()
+    {
+        SB_PROFILE_SCOPE("FramePacer::wait");
+
+        const ulong now = utils::Timer::getSystemTime();
+
+        if (!_window->focused())
+        {
+            // the deadlines restart once the window is focused again
+            _deadline = 0;
+            if (_idle_period > 0)
+                waitUntil(now + _idle_period);
+            return false;
+        }
+
+        // the buffer swap waits for the vertical blank
+        if (_swap_interval > 0 || _period == 0)
+            return true;
+
+        // a late frame moves the deadlines: the next frames are not hurried to catch up
+        if (_deadline == 0 || now > _deadline + _period)
+            _deadline = now;
+        else
+            _deadline += _period;
+
+        waitUntil(_deadline);
+        return true;
+    }
+
+    ulong FramePacer::overshoot() const
+    {
+        return static_cast<ulong>(_overshoot);
+    }
+
+    void FramePacer::waitUntil(ulong deadline)
+    {
+        const ulong margin = std::clamp(static_cast<ulong>(2 * _overshoot), PACER_MIN_MARGIN, PACER_MAX_MARGIN);
+        ulong now = utils::Timer::getSystemTime();
+
+        // sleep on the absolute wake up time, then measure how late it was
+        if (deadline > now + margin)
+        {
+            const ulong wake_up = deadline - margin;
+            timespec time;
+            time.tv_sec = static_cast<time_t>(wake_up / 1000000000);
+            time.tv_nsec = static_cast<long>(wake_up % 1000000000);
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &time, nullptr) == EINTR);
+
+            now = utils::Timer::getSystemTime();
+            const double late = (now > wake_up) ? static_cast<double>(now - wake_up) : 0.;
+            _overshoot += PACER_OVERSHOOT_WEIGHT * (late - _overshoot);
+        }
+
+        // the margin is short: spinning is more precise than yielding the core
+        while (now < deadline)
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            _mm_pause();
+#endif
+            now = utils::Timer::getSystemTime();
+        }
+    }
+}
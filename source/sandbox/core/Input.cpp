@@ -1,4 +1,5 @@
 #include <sandbox/core/Input.hpp>
+#include <sandbox/utils/Profiler.hpp>
 #include <cstring>
 #include <cassert>
 
@@ -12,6 +13,8 @@ Input::Input(Window* w) :
 
 void Input::update()
 {
+    SB_PROFILE_SCOPE("Input::update");
+
     // do nothing if the associated
     // window is not focused
     XID focused_window;
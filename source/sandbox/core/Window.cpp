@@ -1,5 +1,6 @@
 #include <sandbox/core/Window.hpp>
 #include <sandbox/utils/Logger.hpp>
+#include <sandbox/utils/Profiler.hpp>
 #include <sstream>
 #include <X11/Xatom.h>
 #include <cstring> // memset
@@ -29,9 +30,7 @@ namespace sb
         } 
         else
         {
-            ss.str("");
-            ss << "Visual " << (void *)visual_info->visualid << " selected";
-            utils::Logger::write(ss.str());
+            SB_DEBUG(utils::Logger::CORE, "Visual " + std::to_string(visual_info->visualid) + " selected");
         }
 
         XSetWindowAttributes swa;
@@ -52,9 +51,7 @@ namespace sb
 
         // glew must be initialized AFTER the opengl context has been created
         GLenum status = glewInit();
-        ss.str("");
-        ss << "GLEW has " << (status == GLEW_OK ? "" : "NOT ") << "been initialized";
-        utils::Logger::write(ss.str());
+        SB_INFO(utils::Logger::CORE, std::string("GLEW has ") + (status == GLEW_OK ? "" : "NOT ") + "been initialized");
         if (status != GLEW_OK)
         {
             ss.str("");
@@ -63,7 +60,7 @@ namespace sb
         }
         else
             if (GLEW_VERSION_4_3)
-                utils::Logger::write("OpenGL 4.3 is supported");
+                SB_INFO(utils::Logger::CORE, "OpenGL 4.3 is supported");
 
         glEnable(GL_DEPTH_TEST);
         glEnable(GL_CULL_FACE);
@@ -81,6 +78,8 @@ namespace sb
 
     void Window::update()
     {
+        SB_PROFILE_SCOPE("Window::update");
+
         XWindowAttributes window_attributes;
         XGetWindowAttributes(_display, _window_xid, &window_attributes);
 
@@ -89,7 +88,10 @@ namespace sb
         _size[0] = window_attributes.width;
         _size[1] = window_attributes.height;
 
-        glXSwapBuffers(_display, _window_xid);
+        {
+            SB_PROFILE_SCOPE("Window::swap");
+            glXSwapBuffers(_display, _window_xid);
+        }
 
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
         glClearColor(0.3, 0.6, 0.9, 1.0);
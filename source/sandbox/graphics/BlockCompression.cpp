@@ -0,0 +1,253 @@
+#include <sandbox/graphics/BlockCompression.hpp>
+#include <sandbox/core/opengl.hpp>
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace sb
+{
+    bool isCompressed(uint format)
+    {
+        return format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+            || format == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+            || format == GL_COMPRESSED_RG_RGTC2;
+    }
+
+    uint blockSize(uint format)
+    {
+        assert(isCompressed(format));
+        return (format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT) ? 8 : 16;
+    }
+
+    size_t compressedSize(uint width, uint height, uint format)
+    {
+        return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * blockSize(format);
+    }
+
+    void encodeBC1(const uchar* block, uchar* dst)
+    {
+        // bounding box of the block colors
+        uchar lo[4], hi[4];
+
+#if defined(__SSE2__)
+        __m128i p0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+        __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16));
+        __m128i p2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 32));
+        __m128i p3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 48));
+
+        // reduce 16 pixels to 4, then 4 pixels to 1
+        __m128i mn = _mm_min_epu8(_mm_min_epu8(p0, p1), _mm_min_epu8(p2, p3));
+        __m128i mx = _mm_max_epu8(_mm_max_epu8(p0, p1), _mm_max_epu8(p2, p3));
+        mn = _mm_min_epu8(mn, _mm_shuffle_epi32(mn, _MM_SHUFFLE(1, 0, 3, 2)));
+        mx = _mm_max_epu8(mx, _mm_shuffle_epi32(mx, _MM_SHUFFLE(1, 0, 3, 2)));
+        mn = _mm_min_epu8(mn, _mm_shuffle_epi32(mn, _MM_SHUFFLE(2, 3, 0, 1)));
+        mx = _mm_max_epu8(mx, _mm_shuffle_epi32(mx, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        int lo_rgba = _mm_cvtsi128_si32(mn);
+        int hi_rgba = _mm_cvtsi128_si32(mx);
+        std::memcpy(lo, &lo_rgba, 4);
+        std::memcpy(hi, &hi_rgba, 4);
+#else
+        std::memcpy(lo, block, 4);
+        std::memcpy(hi, block, 4);
+        for (uint i = 1; i < 16; ++i)
+        {
+            for (uint c = 0; c < 4; ++c)
+            {
+                lo[c] = std::min(lo[c], block[4 * i + c]);
+                hi[c] = std::max(hi[c], block[4 * i + c]);
+            }
+        }
+#endif
+
+        // inset the box by 1/16 of its size, to reduce the error of the extreme colors
+        for (uint c = 0; c < 3; ++c)
+        {
+            const uchar inset = (hi[c] - lo[c]) >> 4;
+            lo[c] += inset;
+            hi[c] -= inset;
+        }
+
+        // since hi >= lo on each channel, color0 >= color1 (four colors mode)
+        const ushort color0 = ((hi[0] >> 3) << 11) | ((hi[1] >> 2) << 5) | (hi[2] >> 3);
+        const ushort color1 = ((lo[0] >> 3) << 11) | ((lo[1] >> 2) << 5) | (lo[2] >> 3);
+
+        std::memcpy(dst, &color0, 2);
+        std::memcpy(dst + 2, &color1, 2);
+
+        uint indices = 0;
+
+        if (color0 != color1)
+        {
+            // endpoints as decoded by the GPU
+            const int e0[3] = {((color0 >> 11) & 31) * 255 / 31, ((color0 >> 5) & 63) * 255 / 63, (color0 & 31) * 255 / 31};
+            const int e1[3] = {((color1 >> 11) & 31) * 255 / 31, ((color1 >> 5) & 63) * 255 / 63, (color1 & 31) * 255 / 31};
+            const int dir[3] = {e0[0] - e1[0], e0[1] - e1[1], e0[2] - e1[2]};
+            const int dd = dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2];
+
+            // projection of each pixel on the endpoints axis
+            int t[16];
+
+#if defined(__SSE2__)
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i base = _mm_setr_epi16(e1[0], e1[1], e1[2], 0, e1[0], e1[1], e1[2], 0);
+            const __m128i axis = _mm_setr_epi16(dir[0], dir[1], dir[2], 0, dir[0], dir[1], dir[2], 0);
+            const __m128i pixels[4] = {p0, p1, p2, p3};
+
+            for (uint i = 0; i < 4; ++i)
+            {
+                // two pixels per register, as 16-bit signed differences from the base
+                __m128i l = _mm_sub_epi16(_mm_unpacklo_epi8(pixels[i], zero), base);
+                __m128i h = _mm_sub_epi16(_mm_unpackhi_epi8(pixels[i], zero), base);
+
+                // (r*dr + g*dg, b*db) for each pixel, then sum the pairs
+                l = _mm_madd_epi16(l, axis);
+                h = _mm_madd_epi16(h, axis);
+                l = _mm_add_epi32(l, _mm_shuffle_epi32(l, _MM_SHUFFLE(2, 3, 0, 1)));
+                h = _mm_add_epi32(h, _mm_shuffle_epi32(h, _MM_SHUFFLE(2, 3, 0, 1)));
+
+                __m128i dots = _mm_unpacklo_epi64(_mm_shuffle_epi32(l, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_epi32(h, _MM_SHUFFLE(2, 0, 2, 0)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(t + 4 * i), dots);
+            }
+#else
+            for (uint i = 0; i < 16; ++i)
+            {
+                t[i] = 0;
+                for (uint c = 0; c < 3; ++c)
+                    t[i] += (block[4 * i + c] - e1[c]) * dir[c];
+            }
+#endif
+
+            // palette order: color0, color1, 2/3 color0 + 1/3 color1, 1/3 color0 + 2/3 color1
+            const uint remap[4] = {1, 3, 2, 0};
+            for (uint i = 0; i < 16; ++i)
+            {
+                const int step = std::clamp((3 * t[i] + dd / 2) / dd, 0, 3);
+                indices |= remap[step] << (2 * i);
+            }
+        }
+
+        std::memcpy(dst + 4, &indices, 4);
+    }
+
+    void encodeBC4(const uchar* block, uint channel, uchar* dst)
+    {
+        assert(channel < 4);
+
+        uchar values[16];
+
+#if defined(__SSE2__)
+        // isolate the channel of each pixel and pack the 16 values in a register
+        const __m128i shift = _mm_cvtsi32_si128(8 * channel);
+        const __m128i mask = _mm_set1_epi32(0xFF);
+        __m128i v[4];
+        for (uint i = 0; i < 4; ++i)
+            v[i] = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i)), shift), mask);
+
+        __m128i packed = _mm_packus_epi16(_mm_packs_epi32(v[0], v[1]), _mm_packs_epi32(v[2], v[3]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(values), packed);
+
+        __m128i mn = _mm_min_epu8(packed, _mm_srli_si128(packed, 8));
+        __m128i mx = _mm_max_epu8(packed, _mm_srli_si128(packed, 8));
+        mn = _mm_min_epu8(mn, _mm_srli_si128(mn, 4));
+        mx = _mm_max_epu8(mx, _mm_srli_si128(mx, 4));
+        mn = _mm_min_epu8(mn, _mm_srli_si128(mn, 2));
+        mx = _mm_max_epu8(mx, _mm_srli_si128(mx, 2));
+        mn = _mm_min_epu8(mn, _mm_srli_si128(mn, 1));
+        mx = _mm_max_epu8(mx, _mm_srli_si128(mx, 1));
+
+        const uchar lo = static_cast<uchar>(_mm_cvtsi128_si32(mn));
+        const uchar hi = static_cast<uchar>(_mm_cvtsi128_si32(mx));
+#else
+        for (uint i = 0; i < 16; ++i)
+            values[i] = block[4 * i + channel];
+
+        const uchar lo = *std::min_element(values, values + 16);
+        const uchar hi = *std::max_element(values, values + 16);
+#endif
+
+        // alpha0 > alpha1 selects the eight values mode
+        dst[0] = hi;
+        dst[1] = lo;
+
+        ulong indices = 0;
+
+        if (hi != lo)
+        {
+            // palette order: alpha0, alpha1, then six values from alpha0 to alpha1
+            const int range = hi - lo;
+            for (uint i = 0; i < 16; ++i)
+            {
+                const int step = ((values[i] - lo) * 7 + range / 2) / range;
+                const ulong code = (step == 7) ? 0 : (step == 0) ? 1 : 8 - step;
+                indices |= code << (3 * i);
+            }
+        }
+
+        // 16 indices of 3 bits, little endian
+        for (uint i = 0; i < 6; ++i)
+            dst[2 + i] = static_cast<uchar>(indices >> (8 * i));
+    }
+
+    void encodeBC3(const uchar* block, uchar* dst)
+    {
+        encodeBC4(block, 3, dst);
+        encodeBC1(block, dst + 8);
+    }
+
+    void encodeBC5(const uchar* block, uchar* dst)
+    {
+        encodeBC4(block, 0, dst);
+        encodeBC4(block, 1, dst + 8);
+    }
+
+    std::vector<uchar> compress(const uchar* pixels, uint width, uint height, uint channels, uint row_size, uint format)
+    {
+        assert(pixels != nullptr);
+        assert(channels == 3 || channels == 4);
+
+        const uint block_size = blockSize(format);
+        const uint blocks_x = (width + 3) / 4;
+        const uint blocks_y = (height + 3) / 4;
+
+        std::vector<uchar> blocks(compressedSize(width, height, format));
+        uchar* dst = blocks.data();
+
+        uchar block[64];
+        for (uint by = 0; by < blocks_y; ++by)
+        {
+            for (uint bx = 0; bx < blocks_x; ++bx)
+            {
+                // gather a 4x4 RGBA block, replicating the border pixels
+                for (uint y = 0; y < 4; ++y)
+                {
+                    const uchar* row = pixels + std::min(4 * by + y, height - 1) * row_size;
+                    for (uint x = 0; x < 4; ++x)
+                    {
+                        const uchar* p = row + std::min(4 * bx + x, width - 1) * channels;
+                        uchar* q = block + 4 * (4 * y + x);
+                        q[0] = p[0];
+                        q[1] = p[1];
+                        q[2] = p[2];
+                        q[3] = (channels == 4) ? p[3] : 255;
+                    }
+                }
+
+                if (format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT)
+                    encodeBC1(block, dst);
+                else if (format == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT)
+                    encodeBC3(block, dst);
+                else
+                    encodeBC5(block, dst);
+
+                dst += block_size;
+            }
+        }
+
+        return blocks;
+    }
+}
@@ -4,6 +4,7 @@
 #include <sandbox/math/transform.hpp>
 #include <sandbox/math/Vector2.hpp>
 #include <sandbox/math/Vector3.hpp>
+#include <sandbox/utils/Profiler.hpp>
 
 namespace sb
 {
@@ -26,6 +27,8 @@ namespace sb
 
     void Camera::update()
     {
+        SB_PROFILE_SCOPE("Camera::update");
+
         real aspect_ratio = 0;
 
         if (_viewport[3] > 0)
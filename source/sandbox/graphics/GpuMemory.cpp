@@ -0,0 +1,66 @@
+#include <sandbox/graphics/GpuMemory.hpp>
+#include <sandbox/graphics/BlockCompression.hpp>
+#include <sandbox/core/opengl.hpp>
+#include <algorithm>
+#include <cassert>
+
+namespace sb
+{
+    std::atomic<size_t> GpuMemory::_used[GpuMemory::CATEGORIES] = {0, 0, 0};
+    std::atomic<size_t> GpuMemory::_peak{0};
+
+    void GpuMemory::allocate(uint category, size_t bytes)
+    {
+        assert(category < CATEGORIES);
+        _used[category].fetch_add(bytes, std::memory_order_relaxed);
+
+        // the peak is a statistic: a lost update under contention is acceptable
+        const size_t total = used();
+        if (total > _peak.load(std::memory_order_relaxed))
+            _peak.store(total, std::memory_order_relaxed);
+    }
+
+    void GpuMemory::release(uint category, size_t bytes)
+    {
+        assert(category < CATEGORIES);
+        assert(_used[category].load(std::memory_order_relaxed) >= bytes);
+        _used[category].fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    size_t GpuMemory::used(uint category)
+    {
+        assert(category < CATEGORIES);
+        return _used[category].load(std::memory_order_relaxed);
+    }
+
+    size_t GpuMemory::used()
+    {
+        size_t total = 0;
+        for (uint i = 0; i < CATEGORIES; ++i)
+            total += used(i);
+        return total;
+    }
+
+    size_t GpuMemory::peak()
+    {
+        return _peak.load(std::memory_order_relaxed);
+    }
+
+    size_t GpuMemory::textureSize(uint width, uint height, uint num_levels, int internal_format)
+    {
+        size_t size = 0;
+
+        for (uint i = 0; i < num_levels; ++i)
+        {
+            const uint w = std::max(1u, width >> i);
+            const uint h = std::max(1u, height >> i);
+
+            if (isCompressed(internal_format))
+                size += compressedSize(w, h, internal_format);
+            else
+                size += static_cast<size_t>(w) * h * 4;
+        }
+
+        return size;
+    }
+}
@@ -0,0 +1,318 @@
+#include <sandbox/graphics/Overlay.hpp>
+#include <sandbox/core/opengl.hpp>
+#include <sandbox/graphics/RenderStats.hpp>
+#include <sandbox/math/Vector2.hpp>
+#include <sandbox/utils/Logger.hpp>
+#include <sandbox/utils/Profiler.hpp>
+#include <sandbox/utils/string.hpp>
+#include <algorithm>
+#include <cassert>
+
+namespace sb
+{
+    // vertices streamed per frame: the text and the graph take a few thousand
+    const size_t OVERLAY_MAX_VERTICES = 32768;
+
+    // glyph cell in font pixels, spacing included
+    const uint OVERLAY_CHAR_WIDTH = 6;
+    const uint OVERLAY_LINE_HEIGHT = 9;
+
+    // panel margin and padding, characters per line and graph height, in font pixels
+    const uint OVERLAY_MARGIN = 4;
+    const uint OVERLAY_PADDING = 3;
+    const uint OVERLAY_COLUMNS = 22;
+    const uint OVERLAY_GRAPH_HEIGHT = 30;
+
+    // graph range: frames up to 30 fps fill it, longer ones stretch it
+    const double OVERLAY_GRAPH_RANGE = 1e9 / 30.;
+    const double OVERLAY_FRAME_60 = 1e9 / 60.;
+    const double OVERLAY_FRAME_30 = 1e9 / 30.;
+
+    // vsync frames jitter around the refresh period: bars change color past this margin
+    const double OVERLAY_TOLERANCE = 1.1;
+
+    // colors, RGBA with red in the lowest byte
+    const uint OVERLAY_BACKGROUND = 0xB0000000;
+    const uint OVERLAY_TEXT = 0xFFFFFFFF;
+    const uint OVERLAY_LABEL = 0xFFB0B0B0;
+    const uint OVERLAY_GREEN = 0xFF40D040;
+    const uint OVERLAY_YELLOW = 0xFF30D0E0;
+    const uint OVERLAY_RED = 0xFF4040F0;
+    const uint OVERLAY_REFERENCE = 0x80FFFFFF;
+
+    // 5x7 glyphs from ' ' to 'Z', one byte per row from the top, bit 4 is the leftmost pixel
+    const char OVERLAY_FIRST_CHAR = ' ';
+    const char OVERLAY_LAST_CHAR = 'Z';
+    const uchar OVERLAY_FONT[OVERLAY_LAST_CHAR - OVERLAY_FIRST_CHAR + 1][7] = {
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // space
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // !
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // "
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // #
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // $
+        {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03}, // %
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // &
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // '
+        {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02}, // (
+        {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08}, // )
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // *
+        {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00}, // +
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ,
+        {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00}, // -
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C}, // .
+        {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00}, // /
+        {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}, // 0
+        {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}, // 1
+        {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}, // 2
+        {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}, // 3
+        {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}, // 4
+        {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}, // 5
+        {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}, // 6
+        {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}, // 7
+        {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}, // 8
+        {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}, // 9
+        {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00}, // :
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ;
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // <
+        {0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00}, // =
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // >
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ?
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // @
+        {0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11}, // A
+        {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}, // B
+        {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}, // C
+        {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C}, // D
+        {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}, // E
+        {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}, // F
+        {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F}, // G
+        {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}, // H
+        {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}, // I
+        {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}, // J
+        {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}, // K
+        {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}, // L
+        {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11}, // M
+        {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}, // N
+        {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // O
+        {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}, // P
+        {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}, // Q
+        {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}, // R
+        {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}, // S
+        {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}, // T
+        {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // U
+        {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}, // V
+        {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A}, // W
+        {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}, // X
+        {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04}, // Y
+        {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}, // Z
+    };
+
+    const char* const OVERLAY_VERTEX_SHADER = R"(
+        #version 330 core
+        layout (location = 0) in vec2 position;
+        layout (location = 1) in vec4 color;
+
+        uniform vec2 viewport;
+
+        out vec4 vertex_color;
+
+        void main()
+        {
+            // pixels from the top-left corner to normalized device coordinates
+            vec2 ndc = position / viewport * 2.0 - 1.0;
+            gl_Position = vec4(ndc.x, -ndc.y, 0.0, 1.0);
+            vertex_color = color;
+        }
+    )";
+
+    const char* const OVERLAY_FRAGMENT_SHADER = R"(
+        #version 330 core
+        in vec4 vertex_color;
+
+        out vec4 frag_color;
+
+        void main()
+        {
+            frag_color = vertex_color;
+        }
+    )";
+
+    Overlay::Overlay(Window* window) :
+        _window(window),
+        _visible(true),
+        _scale(2),
+        _shader(Shader::createFromSource(OVERLAY_VERTEX_SHADER, OVERLAY_FRAGMENT_SHADER)),
+        _buffer(OVERLAY_MAX_VERTICES * sizeof(Vertex))
+    {
+        assert(_window != nullptr);
+
+        if (!_shader)
+            utils::Logger::write("ERROR::OVERLAY::SHADER_NOT_CREATED");
+
+        VertexLayout layout;
+        layout.add(0, 2, GL_FLOAT)
+              .add(1, 4, GL_UNSIGNED_BYTE, true);
+        _vao = std::make_unique<VAO>(_buffer, layout);
+
+        _vertices.reserve(OVERLAY_MAX_VERTICES);
+    }
+
+    void Overlay::setVisible(bool visible)
+    {
+        _visible = visible;
+    }
+
+    bool Overlay::visible() const
+    {
+        return _visible;
+    }
+
+    void Overlay::toggle()
+    {
+        _visible = !_visible;
+    }
+
+    void Overlay::setScale(uint scale)
+    {
+        _scale = std::max(scale, 1u);
+    }
+
+    void Overlay::draw(const utils::FrameStats& stats)
+    {
+        if (!_visible || !_shader)
+            return;
+
+        SB_PROFILE_SCOPE("Overlay::draw");
+
+        const float s = static_cast<float>(_scale);
+        const float line = OVERLAY_LINE_HEIGHT * s;
+        const float x = (OVERLAY_MARGIN + OVERLAY_PADDING) * s;
+        const float value_x = x + 10 * OVERLAY_CHAR_WIDTH * s;
+        const float width = OVERLAY_COLUMNS * OVERLAY_CHAR_WIDTH * s;
+        float y = (OVERLAY_MARGIN + OVERLAY_PADDING) * s;
+
+        const utils::FrameStats::Summary summary = stats.window();
+        const uint lines = 5 + RenderStats::COUNTERS;
+        const float height = lines * line + OVERLAY_PADDING * s + OVERLAY_GRAPH_HEIGHT * s;
+
+        _vertices.clear();
+        rect(OVERLAY_MARGIN * s, OVERLAY_MARGIN * s, width + 2 * OVERLAY_PADDING * s, height + 2 * OVERLAY_PADDING * s, OVERLAY_BACKGROUND);
+
+        // frame times of the rolling window, in milliseconds
+        auto row = [&](std::string_view label, const std::string& value)
+        {
+            text(x, y, label, OVERLAY_LABEL);
+            text(value_x, y, value, OVERLAY_TEXT);
+            y += line;
+        };
+        row("FPS", utils::pad(summary.mean > 0 ? 1e9 / summary.mean : 0., ' ', 8, 1));
+        row("FRAME MS", utils::pad(summary.mean * 1e-6, ' ', 8, 2));
+        row("P50 MS", utils::pad(summary.p50 * 1e-6, ' ', 8, 2));
+        row("P99 MS", utils::pad(summary.p99 * 1e-6, ' ', 8, 2));
+        row("MAX MS", utils::pad(summary.max * 1e-6, ' ', 8, 2));
+
+        // counters of the last complete frame, uploads in kilobytes
+        for (uint counter = 0; counter < RenderStats::COUNTERS; ++counter)
+        {
+            const ulong value = RenderStats::last(counter);
+            if (counter == RenderStats::BUFFER_BYTES)
+                row("UPLOAD KB", utils::pad(value / 1024., ' ', 8, 1));
+            else
+                row(RenderStats::name(counter), utils::pad(static_cast<int>(value), ' ', 8));
+        }
+
+        // one bar per frame of the window, the line marks 60 fps
+        y += OVERLAY_PADDING * s;
+        const float graph_height = OVERLAY_GRAPH_HEIGHT * s;
+        stats.recent(_frames);
+        if (!_frames.empty())
+        {
+            const double range = std::max(OVERLAY_GRAPH_RANGE, static_cast<double>(*std::max_element(_frames.begin(), _frames.end())));
+            const float bar = width / _frames.size();
+            for (size_t i = 0; i < _frames.size(); ++i)
+            {
+                const double frame = static_cast<double>(_frames[i]);
+                const float bar_height = std::max(static_cast<float>(frame / range * graph_height), 1.f);
+                const uint color = (frame <= OVERLAY_FRAME_60 * OVERLAY_TOLERANCE) ? OVERLAY_GREEN : (frame <= OVERLAY_FRAME_30 * OVERLAY_TOLERANCE) ? OVERLAY_YELLOW : OVERLAY_RED;
+                rect(x + i * bar, y + graph_height - bar_height, std::max(bar - 1.f, 1.f), bar_height, color);
+            }
+            const float reference = static_cast<float>(OVERLAY_FRAME_60 / range * graph_height);
+            rect(x, y + graph_height - reference, width, std::max(s / 2, 1.f), OVERLAY_REFERENCE);
+        }
+
+        if (_vertices.size() > OVERLAY_MAX_VERTICES)
+            _vertices.resize(OVERLAY_MAX_VERTICES - OVERLAY_MAX_VERTICES % 6);
+
+        _buffer.beginFrame();
+        const size_t offset = _buffer.write(_vertices.data(), _vertices.size() * sizeof(Vertex), sizeof(Vertex));
+        if (offset != StreamBuffer::INVALID_OFFSET)
+        {
+            // drawn over the scene, blended, whatever the state left by it
+            const bool depth_test = glIsEnabled(GL_DEPTH_TEST);
+            const bool cull_face = glIsEnabled(GL_CULL_FACE);
+            const bool blend = glIsEnabled(GL_BLEND);
+            glDisable(GL_DEPTH_TEST);
+            glDisable(GL_CULL_FACE);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+            _shader->use();
+            _shader->setVector("viewport", Vector2T<float>({static_cast<float>(_window->width()), static_cast<float>(_window->height())}));
+            _vao->draw(static_cast<uint>(offset / sizeof(Vertex)), static_cast<uint>(_vertices.size()));
+
+            if (depth_test)
+                glEnable(GL_DEPTH_TEST);
+            if (cull_face)
+                glEnable(GL_CULL_FACE);
+            if (!blend)
+                glDisable(GL_BLEND);
+        }
+        _buffer.endFrame();
+    }
+
+    void Overlay::rect(float x, float y, float width, float height, uint color)
+    {
+        const Vertex top_left{x, y, color};
+        const Vertex top_right{x + width, y, color};
+        const Vertex bottom_left{x, y + height, color};
+        const Vertex bottom_right{x + width, y + height, color};
+
+        _vertices.insert(_vertices.end(), {top_left, bottom_left, bottom_right, top_left, bottom_right, top_right});
+    }
+
+    void Overlay::text(float x, float y, std::string_view str, uint color)
+    {
+        const float s = static_cast<float>(_scale);
+
+        for (char c : str)
+        {
+            if (c >= 'a' && c <= 'z')
+                c = static_cast<char>(c - 'a' + 'A');
+
+            if (c > OVERLAY_FIRST_CHAR && c <= OVERLAY_LAST_CHAR)
+            {
+                const uchar* glyph = OVERLAY_FONT[c - OVERLAY_FIRST_CHAR];
+                for (uint row = 0; row < 7; ++row)
+                {
+                    // horizontal runs of lit pixels become a single quad
+                    uint column = 0;
+                    while (column < 5)
+                    {
+                        if (!(glyph[row] & (0x10 >> column)))
+                        {
+                            ++column;
+                            continue;
+                        }
+
+                        uint end = column;
+                        while (end < 5 && (glyph[row] & (0x10 >> end)))
+                            ++end;
+
+                        rect(x + column * s, y + row * s, (end - column) * s, s, color);
+                        column = end;
+                    }
+                }
+            }
+
+            x += OVERLAY_CHAR_WIDTH * s;
+        }
+    }
+}
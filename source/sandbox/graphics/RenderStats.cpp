@@ -0,0 +1,38 @@
+#include <sandbox/graphics/RenderStats.hpp>
+#include <algorithm>
+
+namespace sb
+{
+    ulong RenderStats::_current[RenderStats::COUNTERS] = {};
+    ulong RenderStats::_last[RenderStats::COUNTERS] = {};
+    uint RenderStats::_program = 0;
+    uint RenderStats::_textures[RenderStats::TEXTURE_UNITS] = {};
+    uint RenderStats::_active_unit = 0;
+
+    void RenderStats::frame()
+    {
+        std::copy(_current, _current + COUNTERS, _last);
+        std::fill(_current, _current + COUNTERS, 0);
+    }
+
+    void RenderStats::deleteTexture(uint texture)
+    {
+        std::replace(_textures, _textures + TEXTURE_UNITS, texture, 0u);
+    }
+
+    ulong RenderStats::last(uint counter)
+    {
+        return (counter < COUNTERS) ? _last[counter] : 0;
+    }
+
+    ulong RenderStats::current(uint counter)
+    {
+        return (counter < COUNTERS) ? _current[counter] : 0;
+    }
+
+    const char* RenderStats::name(uint counter)
+    {
+        static const char* names[COUNTERS] = {"DRAWS", "TRIANGLES", "PROGRAMS", "TEXTURES", "UNIFORMS", "UPLOADS"};
+        return (counter < COUNTERS) ? names[counter] : "";
+    }
+}
@@ -0,0 +1,155 @@
+#include <sandbox/graphics/ResourceCache.hpp>
+#include <sandbox/utils/Loader.hpp>
+#include <sandbox/utils/hash.hpp>
+#include <sandbox/utils/string.hpp>
+#include <filesystem>
+
+namespace sb
+{
+    std::shared_ptr<Texture> ResourceCache::texture(const std::string& filename, int format, bool flip, int wrap_s_mode, int wrap_t_mode, int min_filter_mode, int max_filter_mode)
+    {
+        const int params[] = {format, flip ? 1 : 0, wrap_s_mode, wrap_t_mode, min_filter_mode, max_filter_mode};
+        const std::string path_key = pathKey(filename, utils::join({"texture", std::to_string(utils::hash(params, sizeof(params)))}, "|"));
+
+        // same file, already requested
+        auto path = _paths.find(path_key);
+        if (path != _paths.end())
+            if (std::shared_ptr<Texture> texture = find(_textures, path->second))
+                return texture;
+
+        // same content, from another file
+        utils::MappedFile content = utils::Loader::map(filename);
+        const ulong key = utils::hash(params, sizeof(params), utils::hash(content.data(), content.size()));
+        _paths[path_key] = key;
+
+        if (std::shared_ptr<Texture> texture = find(_textures, key))
+            return texture;
+
+        std::shared_ptr<Texture> texture = std::make_shared<Texture>(filename, format, flip, wrap_s_mode, wrap_t_mode, min_filter_mode, max_filter_mode);
+        if (texture->resident())
+            _textures[key] = texture;
+
+        return texture;
+    }
+
+    std::shared_ptr<Shader> ResourceCache::shader(const std::string& vertex_shader_filename, const std::string& fragment_shader_filename)
+    {
+        const std::string path_key = pathKey(vertex_shader_filename, pathKey(fragment_shader_filename, "shader"));
+
+        auto path = _paths.find(path_key);
+        if (path != _paths.end())
+            if (std::shared_ptr<Shader> shader = find(_shaders, path->second))
+                return shader;
+
+        utils::MappedFile vertex_shader_file = utils::Loader::map(vertex_shader_filename);
+        utils::MappedFile fragment_shader_file = utils::Loader::map(fragment_shader_filename);
+
+        const ulong key = utils::hash(fragment_shader_file.data(), fragment_shader_file.size(), utils::hash(vertex_shader_file.data(), vertex_shader_file.size()));
+        _paths[path_key] = key;
+
+        if (std::shared_ptr<Shader> shader = find(_shaders, key))
+            return shader;
+
+        std::shared_ptr<Shader> shader(Shader::createFromSource(vertex_shader_file.view(), fragment_shader_file.view()));
+        if (shader)
+            _shaders[key] = shader;
+
+        return shader;
+    }
+
+    std::shared_ptr<VAO> ResourceCache::vao(const void* vertices, size_t size, const VertexLayout& layout, const std::vector<uint>& indices)
+    {
+        ulong key = utils::hash(vertices, size);
+        key = utils::hash(indices.data(), sizeof(uint) * indices.size(), key);
+
+        // attributes are hashed field by field: the struct has padding bytes
+        for (const VertexAttribute& a : layout.attributes())
+        {
+            const uint fields[] = {a.location, a.components, a.type, a.normalized ? 1u : 0u, a.offset};
+            key = utils::hash(fields, sizeof(fields), key);
+        }
+
+        if (std::shared_ptr<VAO> vao = find(_vaos, key))
+            return vao;
+
+        std::shared_ptr<VAO> vao = std::make_shared<VAO>(vertices, size, layout, indices);
+        _vaos[key] = vao;
+
+        return vao;
+    }
+
+    std::shared_ptr<VAO> ResourceCache::vao(const std::vector<real>& vertices, const std::vector<uint>& indices, uint stride)
+    {
+        ulong key = utils::hash(vertices.data(), sizeof(real) * vertices.size());
+        key = utils::hash(indices.data(), sizeof(uint) * indices.size(), key);
+        key = utils::hash(&stride, sizeof(stride), key);
+
+        if (std::shared_ptr<VAO> vao = find(_vaos, key))
+            return vao;
+
+        std::shared_ptr<VAO> vao = std::make_shared<VAO>(vertices, indices, stride);
+        _vaos[key] = vao;
+
+        return vao;
+    }
+
+    void ResourceCache::purge()
+    {
+        std::erase_if(_textures, [](const auto& item) { return item.second.expired(); });
+        std::erase_if(_shaders, [](const auto& item) { return item.second.expired(); });
+        std::erase_if(_vaos, [](const auto& item) { return item.second.expired(); });
+
+        // path keys pointing to released resources are dropped as well
+        std::erase_if(_paths, [this](const auto& item)
+        {
+            return !_textures.contains(item.second) && !_shaders.contains(item.second);
+        });
+    }
+
+    uint ResourceCache::textures() const
+    {
+        return alive(_textures);
+    }
+
+    uint ResourceCache::shaders() const
+    {
+        return alive(_shaders);
+    }
+
+    uint ResourceCache::vaos() const
+    {
+        return alive(_vaos);
+    }
+
+    std::string ResourceCache::pathKey(const std::string& filename, const std::string& params)
+    {
+        // resolve '..', '.' and symbolic links, so different spellings of a path share the key
+        std::error_code error;
+        std::filesystem::path canonical = std::filesystem::weakly_canonical(filename, error);
+
+        return utils::join({error ? filename : canonical.string(), params}, "|");
+    }
+
+    template <typename T>
+    std::shared_ptr<T> ResourceCache::find(std::unordered_map<ulong, std::weak_ptr<T>>& resources, ulong key)
+    {
+        auto it = resources.find(key);
+        if (it == resources.end())
+            return nullptr;
+
+        std::shared_ptr<T> resource = it->second.lock();
+        if (!resource)
+            resources.erase(it);
+
+        return resource;
+    }
+
+    template <typename T>
+    uint ResourceCache::alive(const std::unordered_map<ulong, std::weak_ptr<T>>& resources)
+    {
+        uint count = 0;
+        for (const auto& item : resources)
+            count += item.second.expired() ? 0 : 1;
+        return count;
+    }
+}
@@ -1,47 +1,30 @@
 #include <sandbox/graphics/Shader.hpp>
 #include <sandbox/core/opengl.hpp>
+#include <sandbox/graphics/RenderStats.hpp>
 #include <sandbox/utils/Logger.hpp>
 #include <sandbox/utils/Loader.hpp>
-#include <sstream>
+#include <sandbox/math/convert.hpp>
 #include <cassert>
 
 namespace sb
 {
     Shader* Shader::create(const std::string& vertex_shader_filename, const std::string& fragment_shader_filename)
     {
-        std::string vertex_shader_text = utils::Loader::readFileTXT(vertex_shader_filename);
-        std::string fragment_shader_text = utils::Loader::readFileTXT(fragment_shader_filename);
+        utils::MappedFile vertex_shader_file = utils::Loader::map(vertex_shader_filename);
+        utils::MappedFile fragment_shader_file = utils::Loader::map(fragment_shader_filename);
 
-        const char* vertex_shader_source = vertex_shader_text.c_str();
-        const char* fragment_shader_source = fragment_shader_text.c_str();
+        return createFromSource(vertex_shader_file.view(), fragment_shader_file.view());
+    }
 
-        int success;
-        char message[512];
-        std::stringstream ss;
-
-        uint vertex_shader;
-        vertex_shader = glCreateShader(GL_VERTEX_SHADER);
-        glShaderSource(vertex_shader, 1, &vertex_shader_source, NULL);
-        glCompileShader(vertex_shader);
-        glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &success);
-        if (!success)
-        {
-            glGetShaderInfoLog(vertex_shader, 512, NULL, message);
-            ss << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << message;
-            utils::Logger::write(ss.str());
-            return nullptr;
-        }
+    Shader* Shader::createFromSource(std::string_view vertex_shader_text, std::string_view fragment_shader_text)
+    {
+        uint vertex_shader = compile(GL_VERTEX_SHADER, vertex_shader_text);
+        uint fragment_shader = compile(GL_FRAGMENT_SHADER, fragment_shader_text);
 
-        uint fragment_shader;
-        fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(fragment_shader, 1, &fragment_shader_source, NULL);
-        glCompileShader(fragment_shader);
-        glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &success);
-        if (!success)
+        if (!compiled(vertex_shader, "VERTEX") || !compiled(fragment_shader, "FRAGMENT"))
         {
-            glGetShaderInfoLog(vertex_shader, 512, NULL, message);
-            ss << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << message;
-            utils::Logger::write(ss.str());
+            glDeleteShader(vertex_shader);
+            glDeleteShader(fragment_shader);
             return nullptr;
         }
 
@@ -52,18 +35,15 @@ namespace sb
         glAttachShader(shader_program, fragment_shader);
         glLinkProgram(shader_program);
 
-        glGetProgramiv(shader_program, GL_LINK_STATUS, &success);
-        if (!success)
+        glDeleteShader(vertex_shader);
+        glDeleteShader(fragment_shader);
+
+        if (!linked(shader_program))
         {
-            glGetProgramInfoLog(shader_program, 512, NULL, message);
-            ss << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << message;
-            utils::Logger::write(ss.str());
+            glDeleteProgram(shader_program);
             return nullptr;
         }
 
-        glDeleteShader(vertex_shader);
-        glDeleteShader(fragment_shader);
-
         Shader* shader = new Shader();
         shader->_shader_program = shader_program;
 
@@ -72,7 +52,46 @@ namespace sb
 
     Shader::~Shader()
     {
-        glDeleteShader(_shader_program);
+        glDeleteProgram(_shader_program);
+    }
+
+    uint Shader::compile(uint type, std::string_view source)
+    {
+        // the source is not null terminated when mapped from a file
+        const char* shader_source = source.empty() ? "" : source.data();
+        const int length = static_cast<int>(source.size());
+
+        uint shader = glCreateShader(type);
+        glShaderSource(shader, 1, &shader_source, &length);
+        glCompileShader(shader);
+
+        return shader;
+    }
+
+    bool Shader::compiled(uint shader, const std::string& stage)
+    {
+        int success;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+        if (!success)
+        {
+            char message[512];
+            glGetShaderInfoLog(shader, 512, NULL, message);
+            utils::Logger::write("ERROR::SHADER::" + stage + "::COMPILATION_FAILED\n" + message);
+        }
+        return success;
+    }
+
+    bool Shader::linked(uint program)
+    {
+        int success;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (!success)
+        {
+            char message[512];
+            glGetProgramInfoLog(program, 512, NULL, message);
+            utils::Logger::write(std::string("ERROR::SHADER::PROGRAM::LINKING_FAILED\n") + message);
+        }
+        return success;
     }
 
     uint Shader::id() const
@@ -83,53 +102,59 @@ namespace sb
     void Shader::use() const
     {
         glUseProgram(_shader_program);
+        RenderStats::useProgram(_shader_program);
     }
 
     void Shader::setBool(const std::string& name, const bool& value) const
     {
         int loc = glGetUniformLocation(_shader_program, name.c_str());
         glUniform1i(loc, value);
+
+        // unknown names (eg. uniforms optimized out) upload nothing
+        if (loc != -1)
+            RenderStats::add(RenderStats::UNIFORM_UPLOADS);
     }
 
     void Shader::setInt(const std::string& name, const int& value) const
     {
         int loc = glGetUniformLocation(_shader_program, name.c_str());
         glUniform1i(loc, value);
+        if (loc != -1)
+            RenderStats::add(RenderStats::UNIFORM_UPLOADS);
     }
 
     void Shader::setReal(const std::string& name, const real& value) const
     {
         int loc = glGetUniformLocation(_shader_program, name.c_str());
-#ifdef __DOUBLE_PRECISION
-        glUniform1d(loc, value);
-#else
-        glUniform1f(loc, value);
-#endif
+        glUniform1f(loc, static_cast<float>(value));
+        if (loc != -1)
+            RenderStats::add(RenderStats::UNIFORM_UPLOADS);
     }
 
-    void Shader::setVector(const std::string& name, const Vector& value) const
+    template <typename T>
+    void Shader::uploadVector(const std::string& name, const VectorT<T>& value) const
     {
         assert(!name.empty());
         assert(value.size() >= 2 && value.size() <= 4);
 
         int loc = glGetUniformLocation(_shader_program, name.c_str());
 
+        float buffer[4];
+        const float* data = asFloat(value.data(), buffer, value.size());
+
         switch (value.size())
         {
-#ifdef __DOUBLE_PRECISION
-            case 2: glUniform2dv(loc, 1, value.data()); break;
-            case 3: glUniform3dv(loc, 1, value.data()); break;
-            case 4: glUniform4dv(loc, 1, value.data()); break;
-#else
-            case 2: glUniform2fv(loc, 1, value.data()); break;
-            case 3: glUniform3fv(loc, 1, value.data()); break;
-            case 4: glUniform4fv(loc, 1, value.data()); break;
-#endif
+            case 2: glUniform2fv(loc, 1, data); break;
+            case 3: glUniform3fv(loc, 1, data); break;
+            case 4: glUniform4fv(loc, 1, data); break;
             default: break;
         }
+        if (loc != -1)
+            RenderStats::add(RenderStats::UNIFORM_UPLOADS);
     }
 
-    void Shader::setMatrix(const std::string& name, const Matrix& value) const
+    template <typename T>
+    void Shader::uploadMatrix(const std::string& name, const MatrixT<T>& value) const
     {
         assert(!name.empty());
         assert(value.rows() >= 2 && value.rows() <= 4);
@@ -138,18 +163,37 @@ namespace sb
 
         int loc = glGetUniformLocation(_shader_program, name.c_str());
 
+        float buffer[16];
+        const float* data = asFloat(value.data(), buffer, value.size());
+
         switch (value.rows())
         {
-#ifdef __DOUBLE_PRECISION
-            case 2: glUniformMatrix2dv(loc, 1, GL_FALSE, value.data()); break;
-            case 3: glUniformMatrix3dv(loc, 1, GL_FALSE, value.data()); break;
-            case 4: glUniformMatrix4dv(loc, 1, GL_FALSE, value.data()); break;
-#else
-            case 2: glUniformMatrix2fv(loc, 1, GL_FALSE, value.data()); break;
-            case 3: glUniformMatrix3fv(loc, 1, GL_FALSE, value.data()); break;
-            case 4: glUniformMatrix4fv(loc, 1, GL_FALSE, value.data()); break;
-#endif
+            case 2: glUniformMatrix2fv(loc, 1, GL_FALSE, data); break;
+            case 3: glUniformMatrix3fv(loc, 1, GL_FALSE, data); break;
+            case 4: glUniformMatrix4fv(loc, 1, GL_FALSE, data); break;
             default: break;
         }
+        if (loc != -1)
+            RenderStats::add(RenderStats::UNIFORM_UPLOADS);
+    }
+
+    void Shader::setVector(const std::string& name, const VectorT<float>& value) const
+    {
+        uploadVector(name, value);
+    }
+
+    void Shader::setVector(const std::string& name, const VectorT<double>& value) const
+    {
+        uploadVector(name, value);
+    }
+
+    void Shader::setMatrix(const std::string& name, const MatrixT<float>& value) const
+    {
+        uploadMatrix(name, value);
+    }
+
+    void Shader::setMatrix(const std::string& name, const MatrixT<double>& value) const
+    {
+        uploadMatrix(name, value);
     }
 }
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include <sandbox/graphics/ShaderBatch.hpp>
+#include <sandbox/core/opengl.hpp>
+#include <sandbox/utils/Loader.hpp>
+#include <cassert>
+
+namespace sb
+{
+    ShaderBatch::ShaderBatch()
+    {
+        // 0xFFFFFFFF lets the driver pick as many threads as it likes
+        if (GLEW_KHR_parallel_shader_compile)
+        {
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+            _parallel = true;
+        }
+        else if (GLEW_ARB_parallel_shader_compile)
+        {
+            glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+            _parallel = true;
+        }
+    }
+
+    ShaderBatch::~ShaderBatch()
+    {
+        for (Program& p : _programs)
+        {
+            if (p.retrieved)
+                continue;
+
+            glDeleteShader(p.vertex_shader);
+            glDeleteShader(p.fragment_shader);
+            glDeleteProgram(p.program);
+        }
+    }
+
+    ShaderBatch::Handle ShaderBatch::add(const std::string& vertex_shader_filename, const std::string& fragment_shader_filename)
+    {
+        utils::MappedFile vertex_shader_file = utils::Loader::map(vertex_shader_filename);
+        utils::MappedFile fragment_shader_file = utils::Loader::map(fragment_shader_filename);
+
+        Program p;
+        p.vertex_shader = Shader::compile(GL_VERTEX_SHADER, vertex_shader_file.view());
+        p.fragment_shader = Shader::compile(GL_FRAGMENT_SHADER, fragment_shader_file.view());
+
+        // linking a program with stages which failed to compile is legal:
+        // it just fails as well, and the error is reported by 'get'
+        p.program = glCreateProgram();
+        glAttachShader(p.program, p.vertex_shader);
+        glAttachShader(p.program, p.fragment_shader);
+        glLinkProgram(p.program);
+
+        _programs.push_back(p);
+
+        return static_cast<Handle>(_programs.size() - 1);
+    }
+
+    bool ShaderBatch::ready(Handle handle) const
+    {
+        assert(handle < _programs.size());
+
+        const Program& p = _programs[handle];
+        if (!_parallel || p.retrieved)
+            return true;
+
+        int completed = GL_FALSE;
+        glGetProgramiv(p.program, GL_COMPLETION_STATUS_KHR, &completed);
+        return completed == GL_TRUE;
+    }
+
+    bool ShaderBatch::ready() const
+    {
+        for (Handle h = 0; h < _programs.size(); ++h)
+            if (!ready(h))
+                return false;
+        return true;
+    }
+
+    Shader* ShaderBatch::get(Handle handle)
+    {
+        assert(handle < _programs.size());
+        assert(!_programs[handle].retrieved);
+
+        Program& p = _programs[handle];
+        p.retrieved = true;
+
+        // the first status query waits for the driver, if still busy
+        bool success = Shader::linked(p.program);
+        if (!success)
+        {
+            Shader::compiled(p.vertex_shader, "VERTEX");
+            Shader::compiled(p.fragment_shader, "FRAGMENT");
+        }
+
+        glDetachShader(p.program, p.vertex_shader);
+        glDetachShader(p.program, p.fragment_shader);
+        glDeleteShader(p.vertex_shader);
+        glDeleteShader(p.fragment_shader);
+
+        if (!success)
+        {
+            glDeleteProgram(p.program);
+            return nullptr;
+        }
+
+        Shader* shader = new Shader();
+        shader->_shader_program = p.program;
+
+        return shader;
+    }
+
+    uint ShaderBatch::size() const
+    {
+        return static_cast<uint>(_programs.size());
+    }
+}
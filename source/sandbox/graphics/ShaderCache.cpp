@@ -0,0 +1,69 @@
+#include <sandbox/graphics/ShaderCache.hpp>
+#include <sandbox/utils/hash.hpp>
+#include <sandbox/utils/string.hpp>
+#include <algorithm>
+
+namespace sb
+{
+    ShaderCache::ShaderCache(const std::string& include_dir) :
+        _preprocessor(include_dir)
+    {
+    }
+
+    ShaderCache::~ShaderCache()
+    {
+        clear();
+    }
+
+    Shader* ShaderCache::get(const std::string& vertex_shader_filename, const std::string& fragment_shader_filename, const std::vector<std::string>& defines)
+    {
+        std::vector<std::string> sorted_defines(defines);
+        std::sort(sorted_defines.begin(), sorted_defines.end());
+        sorted_defines.erase(std::unique(sorted_defines.begin(), sorted_defines.end()), sorted_defines.end());
+
+        // fast path: this variant has already been requested
+        std::string key = utils::join({vertex_shader_filename, fragment_shader_filename, utils::join(sorted_defines, ";")}, "|");
+        auto variant = _variants.find(key);
+        if (variant != _variants.end())
+            return variant->second;
+
+        std::string vertex_shader_text = _preprocessor.process(vertex_shader_filename, sorted_defines);
+        std::string fragment_shader_text = _preprocessor.process(fragment_shader_filename, sorted_defines);
+
+        // variants with the same defines may expand to the same sources (eg. the same files through different paths)
+        ulong h = utils::hash(fragment_shader_text, utils::hash(vertex_shader_text));
+        auto program = _programs.find(h);
+        if (program != _programs.end())
+        {
+            _variants[key] = program->second;
+            return program->second;
+        }
+
+        // failures are cached as well, to avoid compiling again
+        // a broken variant every time it is requested
+        Shader* shader = Shader::createFromSource(vertex_shader_text, fragment_shader_text);
+        _programs[h] = shader;
+        _variants[key] = shader;
+
+        return shader;
+    }
+
+    uint ShaderCache::variants() const
+    {
+        return static_cast<uint>(_variants.size());
+    }
+
+    uint ShaderCache::programs() const
+    {
+        return static_cast<uint>(_programs.size());
+    }
+
+    void ShaderCache::clear()
+    {
+        for (auto& p : _programs)
+            delete p.second;
+
+        _programs.clear();
+        _variants.clear();
+    }
+}
@@ -0,0 +1,120 @@
+#include <sandbox/graphics/ShaderPreprocessor.hpp>
+#include <sandbox/utils/Loader.hpp>
+#include <sandbox/utils/Logger.hpp>
+
+namespace sb
+{
+    ShaderPreprocessor::ShaderPreprocessor(const std::string& include_dir) :
+        _include_dir(include_dir)
+    {
+        // normalize the folder so that paths can be built by concatenation
+        if (!_include_dir.empty() && _include_dir.back() != '/')
+            _include_dir += '/';
+    }
+
+    std::string ShaderPreprocessor::process(const std::string& filename, const std::vector<std::string>& defines) const
+    {
+        std::string source = utils::Loader::readFileTXT(filename);
+        if (source.empty())
+            return "";
+
+        std::set<std::string> included;
+        source = expand(source, included, 0);
+
+        if (defines.empty())
+            return source;
+
+        std::string block("");
+        for (const std::string& d : defines)
+        {
+            size_t pos = d.find('=');
+            if (pos == std::string::npos)
+                block += "#define " + d + "\n";
+            else
+                block += "#define " + d.substr(0, pos) + " " + d.substr(pos + 1) + "\n";
+        }
+
+        // the version directive must be the first statement of the source,
+        // so defines go right after it and line numbers are restored
+        size_t version = source.find("#version");
+        if (version == std::string::npos)
+            return block + "#line 1 0\n" + source;
+
+        size_t eol = source.find('\n', version);
+        if (eol == std::string::npos)
+            return source + "\n" + block;
+
+        uint version_line = 1;
+        for (size_t i = 0; i < version; ++i)
+            version_line += source[i] == '\n';
+
+        return source.substr(0, eol + 1) + block + "#line " + std::to_string(version_line + 1) + " 0\n" + source.substr(eol + 1);
+    }
+
+    const std::string& ShaderPreprocessor::includeDir() const
+    {
+        return _include_dir;
+    }
+
+    std::string ShaderPreprocessor::expand(const std::string& source, std::set<std::string>& included, uint depth) const
+    {
+        if (depth >= MAX_INCLUDE_DEPTH)
+        {
+            utils::Logger::write("ERROR::SHADER::PREPROCESSOR::MAX_INCLUDE_DEPTH_EXCEEDED");
+            return source;
+        }
+
+        std::string text("");
+        text.reserve(source.size());
+
+        size_t from = 0;
+        uint line_number = 1;
+
+        while (from < source.size())
+        {
+            size_t to = source.find('\n', from);
+            if (to == std::string::npos)
+                to = source.size();
+
+            std::string line = source.substr(from, to - from);
+            from = to + 1;
+
+            size_t directive = line.find_first_not_of(" \t");
+            if (directive == std::string::npos || line.compare(directive, 8, "#include") != 0)
+            {
+                text += line + '\n';
+                ++line_number;
+                continue;
+            }
+
+            // both "path" and <path> forms are resolved from the include folder
+            size_t open = line.find_first_of("\"<", directive + 8);
+            size_t close = open == std::string::npos ? std::string::npos : line.find_first_of("\">", open + 1);
+            if (close == std::string::npos)
+            {
+                utils::Logger::write("ERROR::SHADER::PREPROCESSOR::INVALID_INCLUDE\n" + line);
+                text += '\n';
+                ++line_number;
+                continue;
+            }
+
+            std::string path = _include_dir + line.substr(open + 1, close - open - 1);
+            ++line_number;
+
+            // expand each file once, like '#pragma once'
+            if (included.insert(path).second)
+            {
+                std::string content = utils::Loader::readFileTXT(path);
+                if (content.empty())
+                    utils::Logger::write("ERROR::SHADER::PREPROCESSOR::INCLUDE_NOT_FOUND\n" + path);
+
+                text += "#line 1 " + std::to_string(depth + 1) + "\n";
+                text += expand(content, included, depth + 1);
+            }
+
+            text += "#line " + std::to_string(line_number) + " " + std::to_string(depth) + "\n";
+        }
+
+        return text;
+    }
+}
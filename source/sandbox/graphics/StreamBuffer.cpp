@@ -0,0 +1,160 @@
+#include <sandbox/graphics/StreamBuffer.hpp>
+#include <sandbox/core/opengl.hpp>
+#include <sandbox/graphics/GpuMemory.hpp>
+#include <sandbox/graphics/RenderStats.hpp>
+#include <sandbox/utils/Logger.hpp>
+#include <cstring>
+#include <cassert>
+
+namespace sb
+{
+    StreamBuffer::StreamBuffer(size_t frame_size, uint frames)
+        : _frame_size(frame_size), _frames(frames), _fences(frames, nullptr)
+    {
+        assert(frame_size > 0);
+        assert(frames > 0);
+
+        const size_t capacity = _frame_size * _frames;
+
+        glGenBuffers(1, &_buffer);
+        glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+
+        if (GLEW_ARB_buffer_storage)
+        {
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glBufferStorage(GL_ARRAY_BUFFER, capacity, nullptr, flags);
+            _mapped = static_cast<byte*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, capacity, flags));
+
+            if (_mapped == nullptr)
+            {
+                utils::Logger::write("ERROR::STREAMBUFFER::MAPPING_FAILED");
+
+                // immutable storage can be neither orphaned nor updated: the fallback needs a new buffer
+                glDeleteBuffers(1, &_buffer);
+                glGenBuffers(1, &_buffer);
+                glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+            }
+        }
+
+        if (_mapped == nullptr)
+            glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        GpuMemory::allocate(GpuMemory::STREAMING, capacity);
+
+        // the first 'beginFrame' moves to region 0
+        _frame = _frames - 1;
+        _head = _frame * _frame_size;
+    }
+
+    StreamBuffer::~StreamBuffer()
+    {
+        for (void* fence : _fences)
+            if (fence != nullptr)
+                glDeleteSync(static_cast<GLsync>(fence));
+
+        if (_mapped != nullptr)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+
+        glDeleteBuffers(1, &_buffer);
+
+        GpuMemory::release(GpuMemory::STREAMING, _frame_size * _frames);
+    }
+
+    void StreamBuffer::beginFrame()
+    {
+        _frame = (_frame + 1) % _frames;
+        _head = _frame * _frame_size;
+
+        GLsync fence = static_cast<GLsync>(_fences[_frame]);
+        if (fence != nullptr)
+        {
+            // flush only on the first attempt, then just wait for the GPU
+            GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+            GLenum status = GL_TIMEOUT_EXPIRED;
+            while (status == GL_TIMEOUT_EXPIRED)
+            {
+                status = glClientWaitSync(fence, flags, 1000000);
+                flags = 0;
+            }
+
+            if (status == GL_WAIT_FAILED)
+                utils::Logger::write("ERROR::STREAMBUFFER::FENCE_WAIT_FAILED");
+
+            glDeleteSync(fence);
+            _fences[_frame] = nullptr;
+        }
+
+        // without persistent mapping, let the driver detach the storage
+        // still in use by the GPU instead of stalling on the next update
+        if (_mapped == nullptr && _frame == 0)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+            glBufferData(GL_ARRAY_BUFFER, _frame_size * _frames, nullptr, GL_STREAM_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+    }
+
+    size_t StreamBuffer::write(const void* data, size_t size, size_t alignment)
+    {
+        assert(data != nullptr);
+        assert(alignment > 0);
+
+        // alignment is not required to be a power of two (eg. vertex stride)
+        const size_t offset = (_head + alignment - 1) / alignment * alignment;
+        const size_t end = (_frame + 1) * _frame_size;
+
+        if (offset + size > end)
+        {
+            utils::Logger::write("ERROR::STREAMBUFFER::FRAME_OVERFLOW");
+            return INVALID_OFFSET;
+        }
+
+        if (_mapped != nullptr)
+        {
+            std::memcpy(_mapped + offset, data, size);
+        }
+        else
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, _buffer);
+            glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+
+        _head = offset + size;
+        RenderStats::add(RenderStats::BUFFER_BYTES, size);
+
+        return offset;
+    }
+
+    void StreamBuffer::endFrame()
+    {
+        assert(_fences[_frame] == nullptr);
+        _fences[_frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    uint StreamBuffer::id() const
+    {
+        return _buffer;
+    }
+
+    size_t StreamBuffer::frameSize() const
+    {
+        return _frame_size;
+    }
+
+    size_t StreamBuffer::available() const
+    {
+        return (_frame + 1) * _frame_size - _head;
+    }
+
+    bool StreamBuffer::persistent() const
+    {
+        return _mapped != nullptr;
+    }
+}
@@ -1,55 +1,56 @@
 #include <sandbox/graphics/Texture.hpp>
-#include <sandbox/core/types.hpp>
+#include <sandbox/graphics/TextureFile.hpp>
+#include <sandbox/graphics/BlockCompression.hpp>
+#include <sandbox/graphics/GpuMemory.hpp>
+#include <sandbox/graphics/RenderStats.hpp>
+#include <sandbox/utils/Logger.hpp>
+#include <sandbox/utils/Loader.hpp>
+#include <algorithm>
+#include <cassert>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <externals/stb_image.h>
 
 namespace sb
 {
+    ulong Texture::_bind_clock = 0;
+
     Texture::Texture(const std::string& filename, int format, bool flip, int wrap_s_mode, int wrap_t_mode, int min_filter_mode, int max_filter_mode)
+        : Texture(format, wrap_s_mode, wrap_t_mode, min_filter_mode, max_filter_mode)
     {
-        // FIXME: currently, our texture class supports only 3 and 4 channels images
-        assert(format == GL_RGB || format == GL_RGBA);
-
-        // like VAOs, texture objects must be generated
-        // and "activated" through texture binding
-        glGenTextures(1, &_texture_id);
-        glBindTexture(GL_TEXTURE_2D, _texture_id);
-
-        // set the texture wrapping/filtering options (on the currently bound texture object)
-        // available options are: GL_REPEAT, GL_MIRRORED_REPEAT, GL_CLAMP_TO_EDGE, GL_CLAMP_TO_BORDER
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap_s_mode);	
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap_t_mode);
-
-        // set interpolation mode when zoom in/out the image
-        // available options are: GL_NEAREST, GL_LINEAR
-        // if mipmaps are going to be generated: GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR_MIPMAP_NEAREST, GL_NEAREST_MIPMAP_LINEAR, GL_NEAREST_MIPMAP_NEAREST
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min_filter_mode);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, max_filter_mode);
+        _filename = filename;
+        _flip = flip;
+        _resident = load(0);
+    }
 
-        // load and generate the texture
-        int x, y, comp;
-        stbi_set_flip_vertically_on_load(flip);
-        uchar *data = stbi_load(filename.c_str(), &x, &y, &comp, 0);
-        assert (data != nullptr);
+    Texture::Texture(int format, int wrap_s_mode, int wrap_t_mode, int min_filter_mode, int max_filter_mode)
+        : _format(format), _wrap_s_mode(wrap_s_mode), _wrap_t_mode(wrap_t_mode), _min_filter_mode(min_filter_mode), _max_filter_mode(max_filter_mode)
+    {
+        // FIXME: currently, our texture class supports only 3 and 4 channels images
+        assert(format == GL_RGB || format == GL_RGBA || isCompressed(format));
 
-        _width = static_cast<uint>(x);
-        _height = static_cast<uint>(y);
-        _num_channels = static_cast<uint>(comp);
+        // compressed formats are encoded from RGBA blocks, except BC1 which has no alpha
+        _num_channels = (format == GL_RGB || format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT) ? 3 : 4;
 
-        // Pixel values are grouped into sets of one, two, three, or four values, depending on format, to form elements.
-        // FIXME: currently, internal_format and format are set to be the same.
-        int internal_format = format;
-        glTexImage2D(GL_TEXTURE_2D, 0, internal_format, _width, _height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
+        const bool s3tc = (format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT || format == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT);
+        if ((s3tc && !GLEW_EXT_texture_compression_s3tc) || (format == GL_COMPRESSED_RG_RGTC2 && !GLEW_ARB_texture_compression_rgtc))
+        {
+            SB_WARNING(utils::Logger::GRAPHICS, "WARNING::TEXTURE::COMPRESSION_NOT_SUPPORTED fallback to uncompressed format");
+            _format = (_num_channels == 4) ? GL_RGBA : GL_RGB;
+        }
 
-        glBindTexture(GL_TEXTURE_2D, 0);
-        stbi_image_free(data);
+        // opaque mid gray, never compressed
+        const uchar placeholder[4] = {128, 128, 128, 255};
+        create(1, 1, placeholder);
     }
 
     Texture::~Texture()
     {
+        GpuMemory::release(GpuMemory::TEXTURES, _memory);
+
         glBindTexture(GL_TEXTURE_2D, 0);
+        RenderStats::bindTexture(0);
+        RenderStats::deleteTexture(_texture_id);
         glDeleteTextures(1, &_texture_id);
         _texture_id = 0;
         _width = 0;
@@ -72,9 +73,295 @@ namespace sb
         return _num_channels;
     }
 
+    bool Texture::resident() const
+    {
+        return _resident;
+    }
+
+    size_t Texture::memory() const
+    {
+        return _memory;
+    }
+
+    uint Texture::droppedLevels() const
+    {
+        return _dropped_levels;
+    }
+
     void Texture::bind(uint loc) const
     {
+        _last_bound = ++_bind_clock;
+
         glActiveTexture(GL_TEXTURE0 + loc);
         glBindTexture(GL_TEXTURE_2D, _texture_id);
+        RenderStats::bindTexture(loc, _texture_id);
+    }
+
+    void Texture::allocate(uint width, uint height, uint num_levels, int internal_format)
+    {
+        // immutable storage cannot be resized: a new texture object is needed
+        RenderStats::deleteTexture(_texture_id);
+        glDeleteTextures(1, &_texture_id);
+
+        // like VAOs, texture objects must be generated
+        // and "activated" through texture binding
+        glGenTextures(1, &_texture_id);
+        glBindTexture(GL_TEXTURE_2D, _texture_id);
+        RenderStats::bindTexture(_texture_id);
+
+        // set the texture wrapping/filtering options (on the currently bound texture object)
+        // available options are: GL_REPEAT, GL_MIRRORED_REPEAT, GL_CLAMP_TO_EDGE, GL_CLAMP_TO_BORDER
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, _wrap_s_mode);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, _wrap_t_mode);
+
+        // set interpolation mode when zoom in/out the image
+        // available options are: GL_NEAREST, GL_LINEAR
+        // if mipmaps are going to be generated: GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR_MIPMAP_NEAREST, GL_NEAREST_MIPMAP_LINEAR, GL_NEAREST_MIPMAP_NEAREST
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, _min_filter_mode);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, _max_filter_mode);
+
+        // the texture is complete even if it has less levels than the filter needs
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, num_levels - 1);
+
+        GpuMemory::release(GpuMemory::TEXTURES, _memory);
+        _memory = GpuMemory::textureSize(width, height, num_levels, internal_format);
+        GpuMemory::allocate(GpuMemory::TEXTURES, _memory);
+
+        _resident_levels = num_levels;
+
+        if (GLEW_ARB_texture_storage)
+        {
+            glTexStorage2D(GL_TEXTURE_2D, num_levels, internal_format, width, height);
+        }
+        else
+        {
+            // with a pixel unpack buffer bound (eg. by TextureLoader), nullptr would
+            // be read as offset 0 in the buffer instead of "no data"
+            GLint unpack_buffer = 0;
+            glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &unpack_buffer);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+            for (uint i = 0; i < num_levels; ++i)
+                glTexImage2D(GL_TEXTURE_2D, i, internal_format, std::max(1u, width >> i), std::max(1u, height >> i), 0, (_num_channels == 4) ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, unpack_buffer);
+        }
+    }
+
+    void Texture::create(uint width, uint height, const void* pixels)
+    {
+        const uint num_levels = levels(width, height);
+        const int pixel_format = (_num_channels == 4) ? GL_RGBA : GL_RGB;
+        const int internal_format = (_num_channels == 4) ? GL_RGBA8 : GL_RGB8;
+
+        allocate(width, height, num_levels, internal_format);
+        _width = width;
+        _height = height;
+
+        // RGB rows are tightly packed: they are not 4-bytes aligned
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, pixel_format, GL_UNSIGNED_BYTE, pixels);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        if (num_levels > 1)
+            glGenerateMipmap(GL_TEXTURE_2D);
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+        RenderStats::bindTexture(0);
+    }
+
+    void Texture::createCompressed(uint width, uint height, const std::vector<std::vector<uchar>>& levels)
+    {
+        allocate(width, height, static_cast<uint>(levels.size()), _format);
+        _width = width;
+        _height = height;
+
+        for (uint i = 0; i < levels.size(); ++i)
+            glCompressedTexSubImage2D(GL_TEXTURE_2D, i, 0, 0, std::max(1u, width >> i), std::max(1u, height >> i), _format, levels[i].size(), levels[i].data());
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+        RenderStats::bindTexture(0);
+    }
+
+    void Texture::createLevels(uint width, uint height, uint dropped_levels, const void* pixels)
+    {
+        const uint num_levels = levels(width, height);
+        assert(dropped_levels < num_levels);
+
+        const uint w = std::max(1u, width >> dropped_levels);
+        const uint h = std::max(1u, height >> dropped_levels);
+
+        allocate(w, h, num_levels - dropped_levels, (_num_channels == 4) ? GL_RGBA8 : GL_RGB8);
+        _width = width;
+        _height = height;
+        _dropped_levels = dropped_levels;
+
+        // rows are aligned to 4 bytes, the default unpack alignment
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, w, h, (_num_channels == 4) ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE, pixels);
+        if (num_levels - dropped_levels > 1)
+            glGenerateMipmap(GL_TEXTURE_2D);
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+        RenderStats::bindTexture(0);
+    }
+
+    bool Texture::drop(uint dropped_levels)
+    {
+        assert(dropped_levels > _dropped_levels);
+
+        const uint skipped = dropped_levels - _dropped_levels;
+        if (skipped >= _resident_levels)
+            return false;
+
+        // blits cannot write compressed blocks
+        const bool compressed = isCompressed(_format);
+        if (compressed && !GLEW_VERSION_4_3)
+            return load(dropped_levels);
+
+        const uint source = _texture_id;
+        const uint num_levels = _resident_levels - skipped;
+        const uint width = std::max(1u, _width >> dropped_levels);
+        const uint height = std::max(1u, _height >> dropped_levels);
+
+        // the source is deleted once its levels have been copied
+        _texture_id = 0;
+        allocate(width, height, num_levels, compressed ? _format : (_num_channels == 4) ? GL_RGBA8 : GL_RGB8);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        RenderStats::bindTexture(0);
+
+        if (GLEW_VERSION_4_3)
+        {
+            for (uint i = 0; i < num_levels; ++i)
+                glCopyImageSubData(source, GL_TEXTURE_2D, i + skipped, 0, 0, 0, _texture_id, GL_TEXTURE_2D, i, 0, 0, 0,
+                                   std::max(1u, width >> i), std::max(1u, height >> i), 1);
+        }
+        else
+        {
+            GLint read_framebuffer = 0, draw_framebuffer = 0;
+            glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &read_framebuffer);
+            glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &draw_framebuffer);
+
+            uint framebuffers[2];
+            glGenFramebuffers(2, framebuffers);
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffers[0]);
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffers[1]);
+
+            // same size, one level at a time
+            for (uint i = 0; i < num_levels; ++i)
+            {
+                const int w = std::max(1u, width >> i);
+                const int h = std::max(1u, height >> i);
+                glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, source, i + skipped);
+                glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _texture_id, i);
+                glBlitFramebuffer(0, 0, w, h, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+            }
+
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, read_framebuffer);
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, draw_framebuffer);
+            glDeleteFramebuffers(2, framebuffers);
+        }
+
+        RenderStats::deleteTexture(source);
+        glDeleteTextures(1, &source);
+        _dropped_levels = dropped_levels;
+
+        return true;
+    }
+
+    bool Texture::load(uint dropped_levels)
+    {
+        assert(!_filename.empty());
+
+        if (_filename.ends_with(TextureFile::EXTENSION))
+        {
+            TextureFile file;
+            if (!file.open(_filename))
+                return false;
+
+            if (file.format() != GL_RGB && file.format() != GL_RGBA && !isCompressed(file.format()))
+            {
+                utils::Logger::write("ERROR::TEXTURE::UNSUPPORTED_FORMAT " + _filename);
+                return false;
+            }
+
+            _format = file.format();
+            _num_channels = file.channels();
+            _dropped_levels = std::min(dropped_levels, file.levels() - 1);
+
+            // all the stored levels are uploaded, even if the filter does not use them
+            const bool compressed = isCompressed(_format);
+            const int internal_format = compressed ? _format : (_format == GL_RGBA) ? GL_RGBA8 : GL_RGB8;
+            const TextureFile::Level& base = file.level(_dropped_levels);
+            allocate(base.width, base.height, file.levels() - _dropped_levels, internal_format);
+
+            // rows are already aligned to 4 bytes, the default unpack alignment
+            for (uint i = _dropped_levels; i < file.levels(); ++i)
+            {
+                const TextureFile::Level& level = file.level(i);
+                if (compressed)
+                    glCompressedTexSubImage2D(GL_TEXTURE_2D, i - _dropped_levels, 0, 0, level.width, level.height, _format, level.size, file.data(i));
+                else
+                    glTexSubImage2D(GL_TEXTURE_2D, i - _dropped_levels, 0, 0, level.width, level.height, _format, GL_UNSIGNED_BYTE, file.data(i));
+            }
+
+            glBindTexture(GL_TEXTURE_2D, 0);
+            RenderStats::bindTexture(0);
+
+            _width = file.width();
+            _height = file.height();
+
+            return true;
+        }
+
+        // decode the image from the mapped file, converting it to the requested number of channels
+        utils::MappedFile file = utils::Loader::map(_filename);
+        int x, y, comp;
+        stbi_set_flip_vertically_on_load_thread(_flip);
+        uchar *data = stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &x, &y, &comp, _num_channels);
+        if (data == nullptr)
+        {
+            utils::Logger::write("ERROR::TEXTURE::LOADING_FAILED " + _filename + " " + stbi_failure_reason());
+            return false;
+        }
+
+        const uint num_levels = levels(x, y);
+        _dropped_levels = std::min(dropped_levels, num_levels - 1);
+
+        if (isCompressed(_format))
+        {
+            // GL cannot generate mipmaps of compressed textures: the chain is computed here
+            std::vector<std::vector<uchar>> chain = TextureFile::buildLevels(data, x, y, _num_channels, num_levels, _format);
+            chain.erase(chain.begin(), chain.begin() + _dropped_levels);
+            createCompressed(std::max(1, x >> _dropped_levels), std::max(1, y >> _dropped_levels), chain);
+        }
+        else if (_dropped_levels == 0)
+        {
+            create(x, y, data);
+        }
+        else
+        {
+            // the base level is computed on the CPU, the smaller ones by the GPU
+            std::vector<uchar> base = TextureFile::buildLevels(data, x, y, _num_channels, _dropped_levels + 1).back();
+            createLevels(x, y, _dropped_levels, base.data());
+        }
+
+        _width = x;
+        _height = y;
+
+        stbi_image_free(data);
+
+        return true;
+    }
+
+    uint Texture::levels(uint width, uint height) const
+    {
+        if (_min_filter_mode == GL_LINEAR || _min_filter_mode == GL_NEAREST)
+            return 1;
+
+        uint num_levels = 1;
+        for (uint size = std::max(width, height); size > 1; size >>= 1)
+            ++num_levels;
+
+        return num_levels;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,126 @@
+#include <sandbox/graphics/TextureArray.hpp>
+#include <sandbox/graphics/GpuMemory.hpp>
+#include <sandbox/graphics/RenderStats.hpp>
+#include <sandbox/utils/Logger.hpp>
+#include <sandbox/utils/Loader.hpp>
+#include <externals/stb_image.h>
+#include <algorithm>
+#include <cassert>
+
+namespace sb
+{
+    TextureArray::TextureArray(const std::vector<std::string>& filenames, int format, bool flip, int wrap_s_mode, int wrap_t_mode, int min_filter_mode, int max_filter_mode)
+        : _filenames(filenames)
+    {
+        // FIXME: currently, our texture class supports only 3 and 4 channels images
+        assert(format == GL_RGB || format == GL_RGBA);
+        assert(!filenames.empty());
+
+        const int channels = (format == GL_RGBA) ? 4 : 3;
+        const int internal_format = (format == GL_RGBA) ? GL_RGBA8 : GL_RGB8;
+        const uint num_layers = static_cast<uint>(filenames.size());
+
+        glGenTextures(1, &_texture_id);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, _texture_id);
+        RenderStats::bindTexture(_texture_id);
+
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, wrap_s_mode);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, wrap_t_mode);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, min_filter_mode);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, max_filter_mode);
+
+        const bool mipmaps = !(min_filter_mode == GL_LINEAR || min_filter_mode == GL_NEAREST);
+
+        // RGB rows are tightly packed: they are not 4-bytes aligned
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        stbi_set_flip_vertically_on_load_thread(flip);
+
+        for (uint i = 0; i < num_layers; ++i)
+        {
+            utils::MappedFile file = utils::Loader::map(filenames[i]);
+            int x, y, comp;
+            uchar* data = stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &x, &y, &comp, channels);
+            if (data == nullptr)
+            {
+                utils::Logger::write("ERROR::TEXTUREARRAY::LOADING_FAILED " + filenames[i] + " " + stbi_failure_reason());
+                continue;
+            }
+
+            // the first valid image sets the size of all the layers
+            if (_width == 0)
+            {
+                _width = static_cast<uint>(x);
+                _height = static_cast<uint>(y);
+
+                uint num_levels = 1;
+                if (mipmaps)
+                    for (uint size = std::max(_width, _height); size > 1; size >>= 1)
+                        ++num_levels;
+
+                if (GLEW_ARB_texture_storage)
+                    glTexStorage3D(GL_TEXTURE_2D_ARRAY, num_levels, internal_format, _width, _height, num_layers);
+                else
+                    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, internal_format, _width, _height, num_layers, 0, format, GL_UNSIGNED_BYTE, nullptr);
+
+                _memory = GpuMemory::textureSize(_width, _height, num_levels, internal_format) * num_layers;
+                GpuMemory::allocate(GpuMemory::TEXTURES, _memory);
+            }
+
+            if (static_cast<uint>(x) != _width || static_cast<uint>(y) != _height)
+            {
+                utils::Logger::write("ERROR::TEXTUREARRAY::SIZE_MISMATCH " + filenames[i]);
+                stbi_image_free(data);
+                continue;
+            }
+
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, i, _width, _height, 1, format, GL_UNSIGNED_BYTE, data);
+            stbi_image_free(data);
+        }
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        if (mipmaps && _width > 0)
+            glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        RenderStats::bindTexture(0);
+    }
+
+    TextureArray::~TextureArray()
+    {
+        GpuMemory::release(GpuMemory::TEXTURES, _memory);
+
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        RenderStats::bindTexture(0);
+        RenderStats::deleteTexture(_texture_id);
+        glDeleteTextures(1, &_texture_id);
+    }
+
+    uint TextureArray::width() const
+    {
+        return _width;
+    }
+
+    uint TextureArray::height() const
+    {
+        return _height;
+    }
+
+    uint TextureArray::layers() const
+    {
+        return static_cast<uint>(_filenames.size());
+    }
+
+    int TextureArray::layer(const std::string& filename) const
+    {
+        auto it = std::find(_filenames.begin(), _filenames.end(), filename);
+        return (it == _filenames.end()) ? -1 : static_cast<int>(it - _filenames.begin());
+    }
+
+    void TextureArray::bind(uint loc) const
+    {
+        glActiveTexture(GL_TEXTURE0 + loc);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, _texture_id);
+        RenderStats::bindTexture(loc, _texture_id);
+    }
+}
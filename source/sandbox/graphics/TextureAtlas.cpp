@@ -0,0 +1,205 @@
+#include <sandbox/graphics/TextureAtlas.hpp>
+#include <sandbox/utils/Logger.hpp>
+#include <sandbox/utils/Loader.hpp>
+#include <externals/stb_image.h>
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+
+namespace sb
+{
+    TextureAtlas::TextureAtlas(uint width, uint height, int format, uint padding, int wrap_s_mode, int wrap_t_mode, int min_filter_mode, int max_filter_mode)
+        : _texture(format, wrap_s_mode, wrap_t_mode, min_filter_mode, max_filter_mode), _width(width), _height(height), _padding(padding)
+    {
+        assert(format == GL_RGB || format == GL_RGBA);
+        assert(width > 0 && height > 0);
+
+        _num_channels = _texture.channels();
+        _pixels.resize(static_cast<size_t>(width) * height * _num_channels, 0);
+        _skyline.push_back({0, 0, width});
+    }
+
+    int TextureAtlas::add(const std::string& filename, bool flip)
+    {
+        utils::MappedFile file = utils::Loader::map(filename);
+        int x, y, comp;
+        stbi_set_flip_vertically_on_load_thread(flip);
+        uchar* data = stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &x, &y, &comp, _num_channels);
+        if (data == nullptr)
+        {
+            utils::Logger::write("ERROR::TEXTUREATLAS::LOADING_FAILED " + filename + " " + stbi_failure_reason());
+            return -1;
+        }
+
+        int index = add(data, x, y);
+        if (index >= 0)
+            _filenames[index] = filename;
+
+        stbi_image_free(data);
+
+        return index;
+    }
+
+    int TextureAtlas::add(const uchar* pixels, uint width, uint height)
+    {
+        assert(pixels != nullptr);
+
+        uint x, y;
+        if (!pack(width + 2 * _padding, height + 2 * _padding, x, y))
+        {
+            utils::Logger::write("ERROR::TEXTUREATLAS::ATLAS_FULL");
+            return -1;
+        }
+
+        // copy the image with its padding: each padding pixel replicates the nearest border pixel
+        const uint row_size = _width * _num_channels;
+        for (uint j = 0; j < height + 2 * _padding; ++j)
+        {
+            const uint src_y = std::clamp<int>(static_cast<int>(j) - static_cast<int>(_padding), 0, static_cast<int>(height) - 1);
+            uchar* dst = _pixels.data() + (y + j) * row_size + x * _num_channels;
+            const uchar* src = pixels + src_y * width * _num_channels;
+
+            for (uint i = 0; i < _padding; ++i)
+                std::memcpy(dst + i * _num_channels, src, _num_channels);
+
+            std::memcpy(dst + _padding * _num_channels, src, width * _num_channels);
+
+            for (uint i = 0; i < _padding; ++i)
+                std::memcpy(dst + (_padding + width + i) * _num_channels, src + (width - 1) * _num_channels, _num_channels);
+        }
+
+        Region r;
+        r.x = x + _padding;
+        r.y = y + _padding;
+        r.width = width;
+        r.height = height;
+        r.u0 = static_cast<float>(r.x) / _width;
+        r.v0 = static_cast<float>(r.y) / _height;
+        r.u1 = static_cast<float>(r.x + width) / _width;
+        r.v1 = static_cast<float>(r.y + height) / _height;
+
+        _regions.push_back(r);
+        _filenames.push_back("");
+        _used_area += static_cast<ulong>(width + 2 * _padding) * (height + 2 * _padding);
+
+        return static_cast<int>(_regions.size() - 1);
+    }
+
+    void TextureAtlas::build()
+    {
+        _texture.create(_width, _height, _pixels.data());
+        _texture._resident = true;
+    }
+
+    const Texture& TextureAtlas::texture() const
+    {
+        return _texture;
+    }
+
+    const TextureAtlas::Region& TextureAtlas::region(uint i) const
+    {
+        assert(i < _regions.size());
+        return _regions[i];
+    }
+
+    uint TextureAtlas::size() const
+    {
+        return static_cast<uint>(_regions.size());
+    }
+
+    int TextureAtlas::find(const std::string& filename) const
+    {
+        auto it = std::find(_filenames.begin(), _filenames.end(), filename);
+        return (filename.empty() || it == _filenames.end()) ? -1 : static_cast<int>(it - _filenames.begin());
+    }
+
+    std::vector<float> TextureAtlas::remapTable() const
+    {
+        std::vector<float> table;
+        table.reserve(4 * _regions.size());
+
+        for (const Region& r : _regions)
+        {
+            table.push_back(r.u1 - r.u0);
+            table.push_back(r.v1 - r.v0);
+            table.push_back(r.u0);
+            table.push_back(r.v0);
+        }
+
+        return table;
+    }
+
+    float TextureAtlas::occupancy() const
+    {
+        return static_cast<float>(_used_area) / (static_cast<float>(_width) * _height);
+    }
+
+    void TextureAtlas::bind(uint loc) const
+    {
+        _texture.bind(loc);
+    }
+
+    bool TextureAtlas::pack(uint width, uint height, uint& x, uint& y)
+    {
+        // bottom-left rule: the lowest top edge wins, then the leftmost position
+        size_t best = _skyline.size();
+        uint best_y = _height;
+
+        for (size_t i = 0; i < _skyline.size(); ++i)
+        {
+            const uint left = _skyline[i].x;
+            if (left + width > _width)
+                break;
+
+            // the rectangle rests on the highest segment it spans
+            uint top = 0;
+            for (size_t j = i; j < _skyline.size() && _skyline[j].x < left + width; ++j)
+                top = std::max(top, _skyline[j].y);
+
+            if (top + height <= _height && top < best_y)
+            {
+                best = i;
+                best_y = top;
+            }
+        }
+
+        if (best == _skyline.size())
+            return false;
+
+        x = _skyline[best].x;
+        y = best_y;
+
+        // replace the spanned segments with the top edge of the rectangle
+        Segment top{x, y + height, width};
+        size_t end = best;
+        while (end < _skyline.size() && _skyline[end].x + _skyline[end].width <= x + width)
+            ++end;
+
+        // the last spanned segment may be only partially covered
+        if (end < _skyline.size() && _skyline[end].x < x + width)
+        {
+            const uint covered = x + width - _skyline[end].x;
+            _skyline[end].x += covered;
+            _skyline[end].width -= covered;
+        }
+
+        _skyline.erase(_skyline.begin() + best, _skyline.begin() + end);
+        _skyline.insert(_skyline.begin() + best, top);
+
+        // merge neighbours at the same height
+        for (size_t i = 0; i + 1 < _skyline.size();)
+        {
+            if (_skyline[i].y == _skyline[i + 1].y)
+            {
+                _skyline[i].width += _skyline[i + 1].width;
+                _skyline.erase(_skyline.begin() + i + 1);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,275 @@
+#include <sandbox/graphics/TextureFile.hpp>
+#include <sandbox/graphics/BlockCompression.hpp>
+#include <sandbox/core/opengl.hpp>
+#include <sandbox/utils/Logger.hpp>
+#include <sandbox/utils/Loader.hpp>
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+#include <cassert>
+
+namespace sb
+{
+    const std::string TextureFile::EXTENSION = ".sbtex";
+
+    // larger than any GL texture: bigger sizes come from corrupt headers and would overflow the level sizes
+    const uint TEXTUREFILE_MAX_SIZE = 1 << 16;
+
+    TextureFile::~TextureFile()
+    {
+        close();
+    }
+
+    bool TextureFile::open(const std::string& filename)
+    {
+        close();
+
+        // levels are read once, in order
+        _file = utils::Loader::map(filename, utils::MappedFile::SEQUENTIAL);
+        if (!_file.isOpen())
+            return false;
+
+        if (_file.size() < sizeof(Header))
+        {
+            utils::Logger::write("ERROR::TEXTUREFILE::INVALID_FILE " + filename);
+            close();
+            return false;
+        }
+
+        Header header;
+        std::memcpy(&header, _file.data(), sizeof(Header));
+
+        const size_t table_end = sizeof(Header) + sizeof(Level) * header.levels;
+        if (std::memcmp(header.magic, "SBTX", 4) != 0 || header.version != VERSION || header.levels == 0 || table_end > _file.size())
+        {
+            utils::Logger::write("ERROR::TEXTUREFILE::INVALID_HEADER " + filename);
+            close();
+            return false;
+        }
+
+        // the channels must match the pixel format, which gives the size of the levels
+        const bool compressed = isCompressed(header.format);
+        const bool valid_channels = compressed ? (header.channels == 3 || header.channels == 4)
+                                               : (header.format == GL_RGB && header.channels == 3) || (header.format == GL_RGBA && header.channels == 4);
+
+        uint max_levels = 1;
+        for (uint size = std::max(header.width, header.height); size > 1; size >>= 1)
+            ++max_levels;
+
+        if (!valid_channels || header.width == 0 || header.height == 0 || header.width > TEXTUREFILE_MAX_SIZE || header.height > TEXTUREFILE_MAX_SIZE || header.levels > max_levels)
+        {
+            utils::Logger::write("ERROR::TEXTUREFILE::INVALID_HEADER " + filename);
+            close();
+            return false;
+        }
+
+        _format = header.format;
+        _channels = header.channels;
+        _levels.resize(header.levels);
+        std::memcpy(_levels.data(), _file.data() + sizeof(Header), sizeof(Level) * header.levels);
+
+        for (uint i = 0; i < _levels.size(); ++i)
+        {
+            // each level halves the previous one and is laid out as 'write' does
+            const Level& l = _levels[i];
+            const uint width = std::max(1u, header.width >> i);
+            const uint height = std::max(1u, header.height >> i);
+            const size_t size = compressed ? compressedSize(width, height, _format) : static_cast<size_t>(rowSize(width, _channels)) * height;
+
+            if (l.width != width || l.height != height || l.size != size)
+            {
+                utils::Logger::write("ERROR::TEXTUREFILE::INVALID_LEVEL " + filename);
+                close();
+                return false;
+            }
+
+            // written as a difference: the sum could overflow
+            if (l.offset > _file.size() || l.size > _file.size() - l.offset)
+            {
+                utils::Logger::write("ERROR::TEXTUREFILE::TRUNCATED_FILE " + filename);
+                close();
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void TextureFile::close()
+    {
+        _file.close();
+        _format = 0;
+        _channels = 0;
+        _levels.clear();
+    }
+
+    uint TextureFile::format() const
+    {
+        return _format;
+    }
+
+    uint TextureFile::channels() const
+    {
+        return _channels;
+    }
+
+    uint TextureFile::width() const
+    {
+        return _levels.empty() ? 0 : _levels[0].width;
+    }
+
+    uint TextureFile::height() const
+    {
+        return _levels.empty() ? 0 : _levels[0].height;
+    }
+
+    uint TextureFile::levels() const
+    {
+        return static_cast<uint>(_levels.size());
+    }
+
+    const TextureFile::Level& TextureFile::level(uint i) const
+    {
+        assert(i < _levels.size());
+        return _levels[i];
+    }
+
+    const uchar* TextureFile::data(uint i) const
+    {
+        assert(i < _levels.size());
+        return _file.data() + _levels[i].offset;
+    }
+
+    bool TextureFile::write(const std::string& filename, const uchar* pixels, uint width, uint height, uint channels, bool mipmaps, uint format)
+    {
+        assert(pixels != nullptr);
+        assert(width > 0 && height > 0);
+        assert(channels == 3 || channels == 4);
+        assert(format == 0 || isCompressed(format));
+
+        uint num_levels = 1;
+        if (mipmaps)
+            for (uint size = std::max(width, height); size > 1; size >>= 1)
+                ++num_levels;
+
+        std::vector<std::vector<uchar>> data = buildLevels(pixels, width, height, channels, num_levels, format);
+
+        std::vector<Level> levels;
+        for (uint i = 0; i < num_levels; ++i)
+            levels.push_back({std::max(1u, width >> i), std::max(1u, height >> i), 0, data[i].size()});
+
+        if (format == 0)
+            format = (channels == 4) ? GL_RGBA : GL_RGB;
+
+        return write(filename, format, channels, levels, data);
+    }
+
+    std::vector<std::vector<uchar>> TextureFile::buildLevels(const uchar* pixels, uint width, uint height, uint channels, uint num_levels, uint format)
+    {
+        assert(num_levels > 0);
+
+        std::vector<std::vector<uchar>> levels;
+
+        // first level: pad the rows of the source image
+        const uint src_row = width * channels;
+        std::vector<uchar> level(static_cast<size_t>(rowSize(width, channels)) * height, 0);
+        for (uint y = 0; y < height; ++y)
+            std::memcpy(level.data() + y * rowSize(width, channels), pixels + y * src_row, src_row);
+
+        for (uint i = 0; i < num_levels; ++i)
+        {
+            if (i > 0)
+            {
+                const uint w = std::max(1u, width / 2);
+                const uint h = std::max(1u, height / 2);
+
+                std::vector<uchar> next(static_cast<size_t>(rowSize(w, channels)) * h, 0);
+                downsample(level.data(), width, height, channels, next.data());
+
+                level.swap(next);
+                width = w;
+                height = h;
+            }
+
+            // mipmaps are always computed from the uncompressed level
+            if (format == 0)
+                levels.push_back(level);
+            else
+                levels.push_back(compress(level.data(), width, height, channels, rowSize(width, channels), format));
+        }
+
+        return levels;
+    }
+
+    uint TextureFile::rowSize(uint width, uint channels)
+    {
+        return (width * channels + 3) & ~3u;
+    }
+
+    bool TextureFile::write(const std::string& filename, uint format, uint channels, const std::vector<Level>& levels, const std::vector<std::vector<uchar>>& data)
+    {
+        assert(levels.size() == data.size());
+
+        Header header;
+        header.format = format;
+        header.width = levels[0].width;
+        header.height = levels[0].height;
+        header.levels = static_cast<uint>(levels.size());
+        header.channels = channels;
+
+        // place the levels after the table, each one at an aligned offset
+        std::vector<Level> table = levels;
+        ulong offset = sizeof(Header) + sizeof(Level) * table.size();
+        for (Level& l : table)
+        {
+            offset = (offset + LEVEL_ALIGNMENT - 1) / LEVEL_ALIGNMENT * LEVEL_ALIGNMENT;
+            l.offset = offset;
+            offset += l.size;
+        }
+
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.is_open())
+        {
+            utils::Logger::write("Unable to open file: " + filename);
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        file.write(reinterpret_cast<const char*>(table.data()), sizeof(Level) * table.size());
+
+        const char padding[LEVEL_ALIGNMENT] = {0};
+        for (size_t i = 0; i < table.size(); ++i)
+        {
+            file.write(padding, table[i].offset - file.tellp());
+            file.write(reinterpret_cast<const char*>(data[i].data()), table[i].size);
+        }
+
+        return file.good();
+    }
+
+    void TextureFile::downsample(const uchar* src, uint width, uint height, uint channels, uchar* dst)
+    {
+        const uint w = std::max(1u, width / 2);
+        const uint h = std::max(1u, height / 2);
+        const uint src_row = rowSize(width, channels);
+        const uint dst_row = rowSize(w, channels);
+
+        for (uint y = 0; y < h; ++y)
+        {
+            const uchar* row0 = src + std::min(2 * y, height - 1) * src_row;
+            const uchar* row1 = src + std::min(2 * y + 1, height - 1) * src_row;
+
+            for (uint x = 0; x < w; ++x)
+            {
+                const uint x0 = std::min(2 * x, width - 1) * channels;
+                const uint x1 = std::min(2 * x + 1, width - 1) * channels;
+
+                for (uint c = 0; c < channels; ++c)
+                {
+                    const uint sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+                    dst[y * dst_row + x * channels + c] = static_cast<uchar>((sum + 2) / 4);
+                }
+            }
+        }
+    }
+}
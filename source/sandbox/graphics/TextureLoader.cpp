@@ -0,0 +1,208 @@
+#include <sandbox/graphics/TextureLoader.hpp>
+#include <sandbox/graphics/TextureFile.hpp>
+#include <sandbox/graphics/BlockCompression.hpp>
+#include <sandbox/graphics/RenderStats.hpp>
+#include <sandbox/utils/Logger.hpp>
+#include <externals/stb_image.h>
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+
+namespace sb
+{
+    TextureLoader::TextureLoader(uint num_threads)
+        : _pool(num_threads)
+    {
+        glGenBuffers(1, &_pbo);
+    }
+
+    TextureLoader::~TextureLoader()
+    {
+        _pool.wait();
+
+        for (Image& image : _decoded)
+            stbi_image_free(image.pixels);
+
+        glDeleteBuffers(1, &_pbo);
+    }
+
+    void TextureLoader::load(Texture& texture, const std::string& filename, bool flip)
+    {
+        // the file is kept to reload mipmap levels (see TextureResidency)
+        texture._filename = filename;
+        texture._flip = flip;
+
+        queue(texture, 0);
+    }
+
+    void TextureLoader::restore(Texture& texture, uint dropped_levels)
+    {
+        assert(!texture._filename.empty());
+        assert(dropped_levels < texture._dropped_levels);
+
+        queue(texture, dropped_levels);
+    }
+
+    void TextureLoader::queue(Texture& texture, uint dropped_levels)
+    {
+        ++_pending;
+        texture._loading = true;
+
+        const std::string& filename = texture._filename;
+        if (filename.ends_with(TextureFile::EXTENSION))
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _decoded.push_back({&texture, nullptr, 0, 0, {}, filename, dropped_levels});
+            return;
+        }
+
+        // format and channels are read here: workers only query the filter, which never changes
+        const bool flip = texture._flip;
+        const int channels = static_cast<int>(texture.channels());
+        const uint format = texture._format;
+        Texture* target = &texture;
+
+        // the read is queued with all the others, decoding starts once the file content is available
+        _reader.read(filename, [this, target, filename, flip, channels, format, dropped_levels](std::vector<uchar>& content, bool success)
+        {
+            if (!success)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _decoded.push_back({target, nullptr, 0, 0, {}, "", dropped_levels});
+                return;
+            }
+
+            _pool.push([this, target, filename, flip, channels, format, dropped_levels, file = std::move(content)]()
+            {
+                decode(target, filename, file, flip, channels, format, dropped_levels);
+            });
+        });
+    }
+
+    void TextureLoader::decode(Texture* target, const std::string& filename, const std::vector<uchar>& file, bool flip, int channels, uint format, uint dropped_levels)
+    {
+        int x, y, comp;
+        stbi_set_flip_vertically_on_load_thread(flip);
+        uchar* data = stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &x, &y, &comp, channels);
+
+        if (data == nullptr)
+            utils::Logger::write("ERROR::TEXTURE::LOADING_FAILED " + filename + " " + stbi_failure_reason());
+
+        // the decoded image is not needed anymore, once compressed or reduced to the first resident level
+        std::vector<std::vector<uchar>> levels;
+        if (data != nullptr && (isCompressed(format) || dropped_levels > 0))
+        {
+            const uint num_levels = target->levels(x, y);
+            dropped_levels = std::min(dropped_levels, num_levels - 1);
+
+            if (isCompressed(format))
+            {
+                levels = TextureFile::buildLevels(data, x, y, channels, num_levels, format);
+                levels.erase(levels.begin(), levels.begin() + dropped_levels);
+            }
+            else
+            {
+                levels.push_back(std::move(TextureFile::buildLevels(data, x, y, channels, dropped_levels + 1).back()));
+            }
+
+            stbi_image_free(data);
+            data = nullptr;
+        }
+
+        // failures are queued as well, to keep the pending count right
+        std::lock_guard<std::mutex> lock(_mutex);
+        _decoded.push_back({target, data, static_cast<uint>(x), static_cast<uint>(y), std::move(levels), "", dropped_levels});
+    }
+
+    uint TextureLoader::update(uint max_uploads)
+    {
+        // completed reads go to the decoding threads
+        _reader.poll();
+
+        std::vector<Image> images;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            const size_t count = std::min<size_t>(max_uploads, _decoded.size());
+            images.assign(std::make_move_iterator(_decoded.begin()), std::make_move_iterator(_decoded.begin() + count));
+            _decoded.erase(_decoded.begin(), _decoded.begin() + count);
+        }
+
+        uint uploaded = 0;
+        for (Image& image : images)
+        {
+            --_pending;
+
+            Texture* texture = image.texture;
+            texture->_loading = false;
+
+            if (!image.cooked_filename.empty())
+            {
+                // restored textures keep their levels if the file cannot be loaded anymore
+                const bool loaded = texture->load(image.dropped_levels);
+                texture->_resident |= loaded;
+                uploaded += loaded ? 1 : 0;
+                continue;
+            }
+
+            if (isCompressed(texture->_format) && !image.levels.empty())
+            {
+                texture->createCompressed(std::max(1u, image.width >> image.dropped_levels), std::max(1u, image.height >> image.dropped_levels), image.levels);
+                texture->_width = image.width;
+                texture->_height = image.height;
+                texture->_dropped_levels = image.dropped_levels;
+                texture->_resident = true;
+                ++uploaded;
+                continue;
+            }
+
+            // keep the placeholder (or the current levels) of textures which failed to load
+            const uchar* pixels = image.levels.empty() ? image.pixels : image.levels[0].data();
+            if (pixels == nullptr)
+                continue;
+
+            // decoded images are tightly packed, the first resident level has rows aligned to 4 bytes
+            const size_t size = image.levels.empty() ? static_cast<size_t>(image.width) * image.height * texture->channels() : image.levels[0].size();
+
+            // orphan the previous storage, so the driver never waits for the previous transfer
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pbo);
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+
+            void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+            if (mapped != nullptr)
+            {
+                std::memcpy(mapped, pixels, size);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+                RenderStats::add(RenderStats::BUFFER_BYTES, size);
+
+                // with a bound unpack buffer, the pixels pointer is an offset in the buffer
+                if (image.levels.empty())
+                {
+                    texture->create(image.width, image.height, nullptr);
+                    texture->_dropped_levels = 0;
+                }
+                else
+                {
+                    texture->createLevels(image.width, image.height, image.dropped_levels, nullptr);
+                }
+
+                texture->_resident = true;
+                ++uploaded;
+            }
+            else
+            {
+                utils::Logger::write("ERROR::TEXTURE::PBO_MAPPING_FAILED");
+            }
+
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+            stbi_image_free(image.pixels);
+        }
+
+        return uploaded;
+    }
+
+    uint TextureLoader::pending() const
+    {
+        return _pending;
+    }
+}
@@ -0,0 +1,144 @@
+#include <sandbox/graphics/TextureResidency.hpp>
+#include <sandbox/graphics/GpuMemory.hpp>
+#include <sandbox/graphics/BlockCompression.hpp>
+#include <sandbox/utils/Logger.hpp>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <cassert>
+
+namespace sb
+{
+    TextureResidency::TextureResidency(TextureLoader& loader, size_t budget)
+        : _loader(&loader), _budget(budget)
+    {
+
+    }
+
+    void TextureResidency::setBudget(size_t budget)
+    {
+        _budget = budget;
+    }
+
+    size_t TextureResidency::budget() const
+    {
+        return _budget;
+    }
+
+    size_t TextureResidency::used() const
+    {
+        size_t total = 0;
+        for (const auto& [texture, entry] : _textures)
+            total += texture->memory();
+
+        return total;
+    }
+
+    void TextureResidency::add(Texture& texture)
+    {
+        if (texture._filename.empty())
+        {
+            utils::Logger::write("ERROR::TEXTURERESIDENCY::NO_IMAGE_FILE");
+            return;
+        }
+
+        _textures.try_emplace(&texture);
+    }
+
+    void TextureResidency::remove(Texture& texture)
+    {
+        _textures.erase(&texture);
+    }
+
+    void TextureResidency::request(const Texture& texture, real coverage)
+    {
+        auto it = _textures.find(const_cast<Texture*>(&texture));
+        assert(it != _textures.end());
+
+        it->second.coverage = std::max(it->second.coverage, coverage);
+    }
+
+    uint TextureResidency::update(uint max_changes)
+    {
+        uint changes = 0;
+        size_t total = used();
+
+        // over budget: the least recently bound textures lose their largest level first
+        while (total > _budget && changes < max_changes)
+        {
+            Texture* victim = nullptr;
+            for (const auto& [texture, entry] : _textures)
+                if (texture->_resident && !texture->_loading && texture->_resident_levels > 1 && (victim == nullptr || texture->_last_bound < victim->_last_bound))
+                    victim = texture;
+
+            if (victim == nullptr)
+                break;
+
+            const size_t memory = victim->memory();
+            if (!victim->drop(victim->_dropped_levels + 1))
+            {
+                utils::Logger::write("ERROR::TEXTURERESIDENCY::DROP_FAILED " + victim->_filename);
+                break;
+            }
+
+            total = total - memory + victim->memory();
+            ++changes;
+        }
+
+        // the textures covering more pixels get their levels back first
+        std::vector<std::pair<real, Texture*>> requested;
+        for (auto& [texture, entry] : _textures)
+        {
+            if (entry.coverage > 0 && texture->_resident && !texture->_loading && droppable(*texture, entry.coverage) < texture->_dropped_levels)
+                requested.emplace_back(entry.coverage, texture);
+
+            entry.coverage = 0;
+        }
+
+        std::sort(requested.begin(), requested.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+        for (const auto& [coverage, texture] : requested)
+        {
+            if (changes >= max_changes)
+                break;
+
+            // one level at a time: the budget check is exact and the upload cost bounded
+            const uint dropped_levels = texture->_dropped_levels - 1;
+            const int internal_format = isCompressed(texture->_format) ? texture->_format : GL_RGBA8;
+            const size_t memory = GpuMemory::textureSize(std::max(1u, texture->_width >> dropped_levels), std::max(1u, texture->_height >> dropped_levels),
+                                                         texture->_resident_levels + 1, internal_format);
+
+            if (total - texture->memory() + memory > _budget)
+                continue;
+
+            // the restored levels are accounted now, so the queued restores fit together
+            total = total - texture->memory() + memory;
+            _loader->restore(*texture, dropped_levels);
+            ++changes;
+        }
+
+        return changes;
+    }
+
+    real TextureResidency::coverage(const Camera& camera, const Vector3& center, real radius, uint viewport_height)
+    {
+        const real distance = (center - camera.position()).norm();
+
+        // the camera is inside the sphere: the object fills the viewport
+        if (distance <= radius)
+            return static_cast<real>(viewport_height);
+
+        // projection(1, 1) is the cotangent of half the vertical field of view
+        return std::min(static_cast<real>(viewport_height), radius / distance * camera.projection().at(1, 1) * viewport_height);
+    }
+
+    uint TextureResidency::droppable(const Texture& texture, real coverage)
+    {
+        const real size = static_cast<real>(std::max(texture._width, texture._height));
+        if (coverage >= size)
+            return 0;
+
+        // each dropped level halves the resolution
+        return static_cast<uint>(std::floor(std::log2(size / coverage)));
+    }
+}
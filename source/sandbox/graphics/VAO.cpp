@@ -1,5 +1,10 @@
 #include <sandbox/graphics/VAO.hpp>
 #include <sandbox/core/opengl.hpp>
+#include <sandbox/graphics/GpuMemory.hpp>
+#include <sandbox/graphics/RenderStats.hpp>
+#include <sandbox/math/convert.hpp>
+#include <sandbox/utils/Profiler.hpp>
+#include <type_traits>
 #include <cassert>
 
 namespace sb
@@ -8,64 +13,130 @@ namespace sb
     {
         assert(vertices.size() > 0);
         assert(stride > 0);
+        assert(vertices.size() % stride == 0);
 
-#ifdef __DOUBLE_PRECISION
-        GLenum dtype = GL_DOUBLE;
-#else
-        GLenum dtype = GL_FLOAT;
-#endif
+        // vertex attributes are always uploaded in single precision
+        std::vector<float> buffer(std::is_same_v<real, float> ? 0 : vertices.size());
+        const float* data = asFloat(vertices.data(), buffer.data(), vertices.size());
+
+        init(data, sizeof(float) * vertices.size(), VertexLayout::fromStride(stride), indices);
+    }
+
+    VAO::VAO(const void* vertices, size_t size, const VertexLayout& layout, const std::vector<uint>& indices)
+    {
+        init(vertices, size, layout, indices);
+    }
+
+    VAO::VAO(const StreamBuffer& buffer, const VertexLayout& layout, bool indexed)
+    {
+        assert(layout.stride() > 0);
+
+        glGenVertexArrays(1, &_vao);
+        glBindVertexArray(_vao);
+
+        // the buffer is owned by the caller: _vbo and _ebo stay unset
+        glBindBuffer(GL_ARRAY_BUFFER, buffer.id());
+        if (indexed)
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer.id());
+
+        layout.apply();
+
+        glBindVertexArray(0);
+    }
+
+    VAO::~VAO()
+    {
+        GpuMemory::release(GpuMemory::BUFFERS, _memory);
+
+        glBindVertexArray(0);
+        glDeleteVertexArrays(1, &_vao);
+        glDeleteBuffers(1, &_vbo);
+        glDeleteBuffers(1, &_ebo);
+    }
+
+    void VAO::init(const void* vertices, size_t size, const VertexLayout& layout, const std::vector<uint>& indices)
+    {
+        assert(vertices != nullptr);
+        assert(size > 0);
+        assert(layout.stride() > 0);
+        assert(size % layout.stride() == 0);
 
         glGenVertexArrays(1, &_vao);
         glBindVertexArray(_vao);
 
         glGenBuffers(1, &_vbo);
         glBindBuffer(GL_ARRAY_BUFFER, _vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(real) * vertices.size(), vertices.data(), GL_STATIC_DRAW);
+        glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+        RenderStats::add(RenderStats::BUFFER_BYTES, size);
 
         if (!indices.empty())
         {
             glGenBuffers(1, &_ebo);
             glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
             glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices[0]) * indices.size(), indices.data(), GL_STATIC_DRAW);
+            RenderStats::add(RenderStats::BUFFER_BYTES, sizeof(indices[0]) * indices.size());
         }
 
-        uint loc_vertex_position = 0;
-        glVertexAttribPointer(loc_vertex_position, 3, dtype, GL_FALSE, stride * sizeof(real), (void*)0);
-        glEnableVertexAttribArray(loc_vertex_position);
-
-        uint loc_vertex_normal = 1;
-        glVertexAttribPointer(loc_vertex_normal, 3, dtype, GL_FALSE, stride * sizeof(real), (void*)(3 * sizeof(real)));
-        glEnableVertexAttribArray(loc_vertex_normal);
+        layout.apply();
 
-        uint loc_vertex_color = 2;
-        glVertexAttribPointer(loc_vertex_color, 3, dtype, GL_FALSE, stride * sizeof(real), (void*)(6 * sizeof(real)));
-        glEnableVertexAttribArray(loc_vertex_color);
-
-        uint loc_texcoords = 3;
-        glVertexAttribPointer(loc_texcoords, 2, dtype, GL_FALSE, stride * sizeof(real), (void*)(9 * sizeof(real)));
-        glEnableVertexAttribArray(loc_texcoords);
+        glBindVertexArray(0);
 
-        _num_vertices = vertices.size() / stride;
+        _num_vertices = size / layout.stride();
         _num_elements = indices.size();
-    }
 
-    VAO::~VAO()
-    {
-        glBindVertexArray(0);
-        glDeleteVertexArrays(1, &_vao);
-        glDeleteBuffers(1, &_vbo);
-        glDeleteBuffers(1, &_ebo);
+        _memory = size + sizeof(indices[0]) * indices.size();
+        GpuMemory::allocate(GpuMemory::BUFFERS, _memory);
     }
 
     void VAO::draw() const
     {
+        SB_PROFILE_SCOPE("VAO::draw");
+
         glBindVertexArray(_vao);
 
         if (_ebo == 0)
             glDrawArrays(GL_TRIANGLES, 0, _num_vertices);
         else
             glDrawElements(GL_TRIANGLES, _num_elements, GL_UNSIGNED_INT, 0);
-        
+
+        RenderStats::add(RenderStats::DRAW_CALLS);
+        RenderStats::add(RenderStats::TRIANGLES, (_ebo == 0 ? _num_vertices : _num_elements) / 3);
+
+        glBindVertexArray(0);
+    }
+
+    void VAO::draw(uint first, uint count, uint instances) const
+    {
+        SB_PROFILE_SCOPE("VAO::draw");
+
+        glBindVertexArray(_vao);
+
+        if (instances == 1)
+            glDrawArrays(GL_TRIANGLES, first, count);
+        else
+            glDrawArraysInstanced(GL_TRIANGLES, first, count, instances);
+
+        RenderStats::add(RenderStats::DRAW_CALLS);
+        RenderStats::add(RenderStats::TRIANGLES, static_cast<ulong>(count / 3) * instances);
+
+        glBindVertexArray(0);
+    }
+
+    void VAO::drawIndexed(size_t offset, uint count, int base_vertex, uint instances) const
+    {
+        SB_PROFILE_SCOPE("VAO::drawIndexed");
+
+        glBindVertexArray(_vao);
+
+        const void* indices = reinterpret_cast<const void*>(offset);
+        if (instances == 1)
+            glDrawElementsBaseVertex(GL_TRIANGLES, count, GL_UNSIGNED_INT, indices, base_vertex);
+        else
+            glDrawElementsInstancedBaseVertex(GL_TRIANGLES, count, GL_UNSIGNED_INT, indices, instances, base_vertex);
+
+        RenderStats::add(RenderStats::DRAW_CALLS);
+        RenderStats::add(RenderStats::TRIANGLES, static_cast<ulong>(count / 3) * instances);
+
         glBindVertexArray(0);
     }
 }
\ No newline at end of file
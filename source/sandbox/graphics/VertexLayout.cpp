@@ -0,0 +1,166 @@
+#include <sandbox/graphics/VertexLayout.hpp>
+#include <sandbox/core/opengl.hpp>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <cassert>
+
+namespace sb
+{
+    VertexLayout& VertexLayout::add(uint location, uint components, uint type, bool normalized)
+    {
+        assert(components >= 1 && components <= 4);
+
+        if (type == GL_INT_2_10_10_10_REV || type == GL_UNSIGNED_INT_2_10_10_10_REV)
+            assert(components == 4);
+
+        VertexAttribute attribute;
+        attribute.location = location;
+        attribute.components = components;
+        attribute.type = type;
+        attribute.normalized = normalized;
+        attribute.offset = _stride;
+
+        // keep every attribute (and so the whole vertex) 4 bytes aligned
+        _stride += (size(type, components) + 3) & ~3u;
+        _attributes.push_back(attribute);
+
+        return *this;
+    }
+
+    VertexLayout VertexLayout::fromStride(uint stride)
+    {
+        assert(stride > 0);
+
+        // position > normal > color > texture
+        const uint components[] = { 3, 3, 3, 2 };
+
+        VertexLayout layout;
+        uint used = 0;
+        for (uint loc = 0; loc < 4 && used + components[loc] <= stride; ++loc)
+        {
+            layout.add(loc, components[loc], GL_FLOAT);
+            used += components[loc];
+        }
+
+        // per-vertex data not covered by any attribute is still part of the vertex
+        layout._stride = stride * sizeof(float);
+
+        return layout;
+    }
+
+    uint VertexLayout::stride() const
+    {
+        return _stride;
+    }
+
+    const std::vector<VertexAttribute>& VertexLayout::attributes() const
+    {
+        return _attributes;
+    }
+
+    void VertexLayout::apply(size_t base_offset) const
+    {
+        for (const VertexAttribute& a : _attributes)
+        {
+            glVertexAttribPointer(a.location, a.components, a.type, a.normalized, _stride, (void*)(base_offset + a.offset));
+            glEnableVertexAttribArray(a.location);
+        }
+    }
+
+    uint VertexLayout::size(uint type, uint components)
+    {
+        switch (type)
+        {
+            case GL_BYTE:
+            case GL_UNSIGNED_BYTE:
+                return components;
+            case GL_SHORT:
+            case GL_UNSIGNED_SHORT:
+            case GL_HALF_FLOAT:
+                return components * 2;
+            case GL_INT:
+            case GL_UNSIGNED_INT:
+            case GL_FLOAT:
+                return components * 4;
+            case GL_DOUBLE:
+                return components * 8;
+            case GL_INT_2_10_10_10_REV:
+            case GL_UNSIGNED_INT_2_10_10_10_REV:
+                return 4;
+            default:
+                assert(false && "unsupported vertex attribute type");
+                return 0;
+        }
+    }
+
+    ushort packHalf(float v)
+    {
+        uint x;
+        memcpy(&x, &v, sizeof(x));
+
+        uint sign = (x >> 16) & 0x8000;
+        uint mantissa = x & 0x7fffff;
+        int exponent = static_cast<int>((x >> 23) & 0xff) - 127 + 15;
+
+        // infinity and nan
+        if (((x >> 23) & 0xff) == 0xff)
+            return sign | 0x7c00 | (mantissa ? 0x200 : 0);
+
+        // too large: infinity
+        if (exponent >= 31)
+            return sign | 0x7c00;
+
+        // too small: subnormal half or zero
+        if (exponent <= 0)
+        {
+            if (exponent < -10)
+                return sign;
+
+            mantissa |= 0x800000;
+            uint shift = 14 - exponent;
+            uint half = mantissa >> shift;
+            uint remainder = mantissa & ((1u << shift) - 1);
+            uint halfway = 1u << (shift - 1);
+            if (remainder > halfway || (remainder == halfway && (half & 1)))
+                ++half;
+            return sign | half;
+        }
+
+        // a carry out of the mantissa correctly bumps the exponent
+        uint half = sign | (exponent << 10) | (mantissa >> 13);
+        uint remainder = mantissa & 0x1fff;
+        if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+            ++half;
+        return half;
+    }
+
+    signed char packSnorm8(float v)
+    {
+        return static_cast<signed char>(std::lround(std::clamp(v, -1.f, 1.f) * 127.f));
+    }
+
+    uchar packUnorm8(float v)
+    {
+        return static_cast<uchar>(std::lround(std::clamp(v, 0.f, 1.f) * 255.f));
+    }
+
+    short packSnorm16(float v)
+    {
+        return static_cast<short>(std::lround(std::clamp(v, -1.f, 1.f) * 32767.f));
+    }
+
+    ushort packUnorm16(float v)
+    {
+        return static_cast<ushort>(std::lround(std::clamp(v, 0.f, 1.f) * 65535.f));
+    }
+
+    uint packSnorm2_10_10_10(float x, float y, float z, float w)
+    {
+        uint px = static_cast<uint>(std::lround(std::clamp(x, -1.f, 1.f) * 511.f)) & 0x3ff;
+        uint py = static_cast<uint>(std::lround(std::clamp(y, -1.f, 1.f) * 511.f)) & 0x3ff;
+        uint pz = static_cast<uint>(std::lround(std::clamp(z, -1.f, 1.f) * 511.f)) & 0x3ff;
+        uint pw = static_cast<uint>(std::lround(std::clamp(w, -1.f, 1.f))) & 0x3;
+        return px | (py << 10) | (pz << 20) | (pw << 30);
+    }
+}
@@ -0,0 +1,77 @@
+#include <sandbox/math/MappedMatrix.hpp>
+#include <sandbox/math/serialize.hpp>
+#include <sandbox/utils/Logger.hpp>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace sb
+{
+    template <typename T>
+    MappedMatrixT<T>::MappedMatrixT(const std::string& filename)
+    {
+        const int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            utils::Logger::write("Unable to open file: " + filename);
+            return;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(MatrixHeader))
+        {
+            utils::Logger::write("ERROR::MAPPEDMATRIX::INVALID_FILE " + filename);
+            ::close(fd);
+            return;
+        }
+
+        // private writable mapping: modified pages are copied, the file is never written
+        void* mapping = mmap(nullptr, info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+
+        if (mapping == MAP_FAILED)
+        {
+            utils::Logger::write("ERROR::MAPPEDMATRIX::MMAP_FAILED " + filename);
+            return;
+        }
+
+        MatrixHeader header;
+        std::memcpy(&header, mapping, sizeof(MatrixHeader));
+        if (!validHeader(header, info.st_size) || header.scalar_size != sizeof(T))
+        {
+            utils::Logger::write("ERROR::MAPPEDMATRIX::INVALID_FILE " + filename);
+            munmap(mapping, info.st_size);
+            return;
+        }
+
+        _mapping = mapping;
+        _mapping_size = info.st_size;
+
+        // elements are used in place, right after the header: the base destructor must not free them
+        this->_data = reinterpret_cast<T*>(static_cast<uchar*>(mapping) + sizeof(MatrixHeader));
+        this->_owner = false;
+        this->_rows = header.rows;
+        this->_cols = header.cols;
+        this->_size = header.rows * header.cols;
+    }
+
+    template <typename T>
+    MappedMatrixT<T>::~MappedMatrixT()
+    {
+        if (_mapping != nullptr)
+            munmap(_mapping, _mapping_size);
+
+        this->_data = nullptr;
+    }
+
+    template <typename T>
+    bool MappedMatrixT<T>::isOpen() const
+    {
+        return _mapping != nullptr;
+    }
+
+    template class MappedMatrixT<float>;
+    template class MappedMatrixT<double>;
+}
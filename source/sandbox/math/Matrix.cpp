@@ -1,13 +1,15 @@
 #include <sandbox/core/constants.hpp>
 #include <sandbox/math/Matrix.hpp>
 #include <sandbox/math/Vector.hpp>
+#include <sandbox/math/serialize.hpp>
 #include <cmath>
 #include <cstring>
 #include <cassert>
 
 namespace sb
 {
-    Matrix::Matrix(const uint rows, const uint cols)
+    template <typename T>
+    MatrixT<T>::MatrixT(const uint rows, const uint cols)
     {
         assert(rows > 0);
         assert(cols > 0);
@@ -16,12 +18,13 @@ namespace sb
         _rows = rows;
         _cols = cols;
 
-        _data = new real[_size];
+        _data = new T[_size];
 
-        memset(_data, 0, _size * sizeof(real));
+        memset(_data, 0, _size * sizeof(T));
     }
 
-    Matrix::Matrix(const std::vector<real>& v, const uint rows, const uint cols)
+    template <typename T>
+    MatrixT<T>::MatrixT(const std::vector<T>& v, const uint rows, const uint cols)
     {
         if (rows * cols > 0)
         {
@@ -42,27 +45,29 @@ namespace sb
             _cols = n;
         }
 
-        _data = new real[_size];
+        _data = new T[_size];
 
-        memcpy(_data, v.data(), v.size() * sizeof(real));
+        memcpy(_data, v.data(), v.size() * sizeof(T));
     }
 
-    Matrix::Matrix(const Matrix& m)
+    template <typename T>
+    MatrixT<T>::MatrixT(const MatrixT<T>& m)
     {
         _size = m._rows * m._cols;
         _rows = m._rows;
         _cols = m._cols;
 
-        _data = new real[m._rows * m._cols];
+        _data = new T[m._rows * m._cols];
 
-        memcpy(_data, m._data, _size * sizeof(real));
+        memcpy(_data, m._data, _size * sizeof(T));
     }
 
-    Matrix::~Matrix()
+    template <typename T>
+    MatrixT<T>::~MatrixT()
     {
-        if (_data != nullptr)
+        if (_data != nullptr && _owner)
         {
-            delete _data;
+            delete[] _data;
             _data = nullptr;
         }
 
@@ -71,82 +76,122 @@ namespace sb
         _cols = 0;
     }
 
-    Matrix Matrix::identity(const uint size)
+    template <typename T>
+    MatrixT<T> MatrixT<T>::identity(const uint size)
     {
-        Matrix m(size, size);
+        MatrixT<T> m(size, size);
         for (uint i = 0; i < size; ++i)
             m(i, i) = 1.0;
         return m;
     }
 
-    std::string Matrix::toString() const
+    template <typename T>
+    std::string MatrixT<T>::toString() const
     {
-        std::stringstream ss("");
-        for (uint i = 0; i < _rows; ++i)
-        {
-            for (uint j = 0; j < _cols; ++j)
-                ss << std::to_string(_data[_rows * i + j]) + " ";
-            ss << "\n";
-        }
-        return ss.str();
+        std::string text;
+        formatText(text, _data, _rows, _cols);
+        return text;
+    }
+
+    template <typename T>
+    void MatrixT<T>::write(std::ostream& stream, char separator) const
+    {
+        writeText(stream, _data, _rows, _cols, separator);
     }
 
-    Vector Matrix::diag() const
+    template <typename T>
+    MatrixT<T> MatrixT<T>::read(std::istream& stream, char separator)
+    {
+        std::vector<T> data;
+        uint rows, cols;
+        if (!readText(stream, data, rows, cols, separator))
+            return MatrixT<T>();
+
+        return MatrixT<T>(data, rows, cols);
+    }
+
+    template <typename T>
+    bool MatrixT<T>::save(const std::string& filename) const
+    {
+        return writeBinary(filename, _data, _rows, _cols);
+    }
+
+    template <typename T>
+    MatrixT<T> MatrixT<T>::load(const std::string& filename)
+    {
+        std::vector<T> data;
+        uint rows, cols;
+        if (!readBinary(filename, data, rows, cols))
+            return MatrixT<T>();
+
+        return MatrixT<T>(data, rows, cols);
+    }
+
+    template <typename T>
+    VectorT<T> MatrixT<T>::diag() const
     {
         const uint n = std::min(_rows, _cols);
-        Vector d(n);
+        VectorT<T> d(n);
         for (uint i = 0; i < n; ++i)
             d[i] = _data[_rows * i + i];
         return d;
     }
 
-    const real* Matrix::data() const
+    template <typename T>
+    const T* MatrixT<T>::data() const
     {
         return _data;
     }
 
-    uint Matrix::rows() const
+    template <typename T>
+    uint MatrixT<T>::rows() const
     {
         return _rows;
     }
 
-    uint Matrix::cols() const
+    template <typename T>
+    uint MatrixT<T>::cols() const
     {
         return _cols;
     }
 
-    uint Matrix::size() const
+    template <typename T>
+    uint MatrixT<T>::size() const
     {
         return _size;
     }
 
-    Vector Matrix::row(const uint i) const
+    template <typename T>
+    VectorT<T> MatrixT<T>::row(const uint i) const
     {
         assert(i < _rows);
 
-        Vector row(_cols);
+        VectorT<T> row(_cols);
         for (uint j = 0; j < _cols; ++j)
             row[j] = _data[_rows * i + j];
         return row;
     }
 
-    Vector Matrix::col(const uint i) const
+    template <typename T>
+    VectorT<T> MatrixT<T>::col(const uint i) const
     {
         assert(i < _cols);
 
-        Vector col(_rows);
+        VectorT<T> col(_rows);
         for (uint j = 0; j < _rows; ++j)
             col[j] = _data[_rows * j + i];
         return col;
     }
 
-    real& Matrix::operator[](const uint i)
+    template <typename T>
+    T& MatrixT<T>::operator[](const uint i)
     {
         assert(i < _size);
         return _data[i];
     }
 
-    real& Matrix::operator()(const uint i, const uint j)
+    template <typename T>
+    T& MatrixT<T>::operator()(const uint i, const uint j)
     {
         assert(i < _rows);
         assert(j < _cols);
@@ -154,13 +199,15 @@ namespace sb
         return _data[_rows * i + j];
     }
 
-    real Matrix::at(const uint i) const
+    template <typename T>
+    T MatrixT<T>::at(const uint i) const
     {
         assert(i < _size);
         return _data[i];
     }
 
-    real Matrix::at(const uint i, const uint j) const
+    template <typename T>
+    T MatrixT<T>::at(const uint i, const uint j) const
     {
         assert(i < _rows);
         assert(j < _cols);
@@ -168,14 +215,15 @@ namespace sb
         return _data[_rows * i + j];
     }
 
-    Matrix Matrix::get(const uint i, const uint j, const uint rows, const uint cols) const
+    template <typename T>
+    MatrixT<T> MatrixT<T>::get(const uint i, const uint j, const uint rows, const uint cols) const
     {
         assert(rows > 0);
         assert(cols > 0);
         assert(i + rows < _cols);
         assert(j + cols < _cols);
 
-        Matrix res(rows, cols);
+        MatrixT<T> res(rows, cols);
 
         for (uint v = i; v < rows; ++v)
             for (uint u = j; u < cols; ++u)
@@ -184,7 +232,8 @@ namespace sb
         return res;
     }
 
-    void Matrix::set(const std::vector<uint>& indices, real value)
+    template <typename T>
+    void MatrixT<T>::set(const std::vector<uint>& indices, T value)
     {
         for (auto& i : indices)
         {
@@ -193,7 +242,8 @@ namespace sb
         }
     }
 
-    void Matrix::set(const std::vector<uint>& indices, const std::vector<real>& values)
+    template <typename T>
+    void MatrixT<T>::set(const std::vector<uint>& indices, const std::vector<T>& values)
     {
         assert(indices.size() == values.size());
 
@@ -204,7 +254,8 @@ namespace sb
         }
     }
 
-    void Matrix::set(const uint i, const uint j, const Matrix& m)
+    template <typename T>
+    void MatrixT<T>::set(const uint i, const uint j, const MatrixT<T>& m)
     {
         assert(i < _rows && j < _cols);
         assert(i + m._rows <= _rows);
@@ -219,7 +270,8 @@ namespace sb
                 _data[r * _rows + c] = m._data[count++];
     }
 
-    bool Matrix::operator==(const Matrix& m) const
+    template <typename T>
+    bool MatrixT<T>::operator==(const MatrixT<T>& m) const
     {
         assert(_rows == m._rows);
         assert(_cols == m._cols);
@@ -232,42 +284,48 @@ namespace sb
         return res;
     }
 
-    void Matrix::operator=(const Matrix& m)
+    template <typename T>
+    void MatrixT<T>::operator=(const MatrixT<T>& m)
     {
         assert(_rows == m._rows);
         assert(_cols == m._cols);
-        memcpy(_data, m._data, _size * sizeof(real));
+        memcpy(_data, m._data, _size * sizeof(T));
     }
 
-    Matrix Matrix::operator+(const real& v) const
+    template <typename T>
+    MatrixT<T> MatrixT<T>::operator+(const T& v) const
     {
-        Matrix res(_rows, _cols);
+        MatrixT<T> res(_rows, _cols);
         for (uint i = 0; i < _size; ++i)
             res._data[i] = _data[i] + v;
         return res;
     }
 
-    void Matrix::operator+=(const real& v)
+    template <typename T>
+    void MatrixT<T>::operator+=(const T& v)
     {
         for (uint i = 0; i < _size; ++i)
             _data[i] += v;
     }
 
-    Matrix Matrix::operator-(const real& v) const
+    template <typename T>
+    MatrixT<T> MatrixT<T>::operator-(const T& v) const
     {
-        Matrix res(_rows, _cols);
+        MatrixT<T> res(_rows, _cols);
         for (uint i = 0; i < _size; ++i)
             res._data[i] = _data[i] - v;
         return res;
     }
 
-    void Matrix::operator-=(const real& v)
+    template <typename T>
+    void MatrixT<T>::operator-=(const T& v)
     {
         for (uint i = 0; i < _size; ++i)
             _data[i] -= v;
     }
 
-    void Matrix::operator-=(const Matrix& m)
+    template <typename T>
+    void MatrixT<T>::operator-=(const MatrixT<T>& m)
     {
         assert(_rows == m._rows);
         assert(_cols == m._cols);
@@ -276,31 +334,35 @@ namespace sb
             _data[i] -= m._data[i];
     }
 
-    Matrix Matrix::operator*(const real& v) const
+    template <typename T>
+    MatrixT<T> MatrixT<T>::operator*(const T& v) const
     {
-        Matrix res(_rows, _cols);
+        MatrixT<T> res(_rows, _cols);
         for (uint i = 0; i < _size; ++i)
             res._data[i] = _data[i] * v;
         return res;
     }
 
-    void Matrix::operator*=(const real& v)
+    template <typename T>
+    void MatrixT<T>::operator*=(const T& v)
     {
         for (uint i = 0; i < _size; ++i)
             _data[i] *= v;
     }
 
-    Matrix Matrix::operator/(const real& v) const
+    template <typename T>
+    MatrixT<T> MatrixT<T>::operator/(const T& v) const
     {
         assert(std::abs(v) >= EPS);
 
-        Matrix res(_rows, _cols);
+        MatrixT<T> res(_rows, _cols);
         for (uint i = 0; i < _size; ++i)
             res._data[i] = _data[i] / v;
         return res;
     }
 
-    void Matrix::operator/=(const real& v)
+    template <typename T>
+    void MatrixT<T>::operator/=(const T& v)
     {
         assert(std::abs(v) >= EPS);
 
@@ -308,18 +370,20 @@ namespace sb
             _data[i] /= v;
     }
 
-    Matrix Matrix::operator+(const Matrix& m) const
+    template <typename T>
+    MatrixT<T> MatrixT<T>::operator+(const MatrixT<T>& m) const
     {
         assert(_rows == m._rows);
         assert(_cols == m._cols);
 
-        Matrix res(_rows, _cols);
+        MatrixT<T> res(_rows, _cols);
         for (uint i = 0; i < _size; ++i)
             res._data[i] = _data[i] + m._data[i];
         return res;
     }
 
-    void Matrix::operator+=(const Matrix& m)
+    template <typename T>
+    void MatrixT<T>::operator+=(const MatrixT<T>& m)
     {
         assert(_rows == m._rows);
         assert(_cols == m._cols);
@@ -328,20 +392,22 @@ namespace sb
             _data[i] += m._data[i];
     }
 
-    Matrix Matrix::operator-(const Matrix& m) const
+    template <typename T>
+    MatrixT<T> MatrixT<T>::operator-(const MatrixT<T>& m) const
     {
         assert(_rows == m._rows);
         assert(_cols == m._cols);
 
-        Matrix res(_rows, _cols);
+        MatrixT<T> res(_rows, _cols);
         for (uint i = 0; i < _size; ++i)
             res._data[i] = _data[i] - m._data[i];
         return res;
     }
 
-    Matrix Matrix::operator-() const
+    template <typename T>
+    MatrixT<T> MatrixT<T>::operator-() const
     {
-        Matrix res(_rows, _cols);
+        MatrixT<T> res(_rows, _cols);
 
         for (uint i = 0; i < _size; ++i)
             res._data[i] = -_data[i];
@@ -349,18 +415,20 @@ namespace sb
         return res;
     }
 
-    Matrix Matrix::operator*(const Matrix& m) const
+    template <typename T>
+    MatrixT<T> MatrixT<T>::operator*(const MatrixT<T>& m) const
     {
         assert(_rows == m._rows);
         assert(_cols == m._cols);
 
-        Matrix res(_rows, _cols);
+        MatrixT<T> res(_rows, _cols);
         for (uint i = 0; i < _size; ++i)
             res._data[i] = _data[i] * m._data[i];
         return res;
     }
 
-    void Matrix::operator*=(const Matrix& m)
+    template <typename T>
+    void MatrixT<T>::operator*=(const MatrixT<T>& m)
     {
         assert(_rows == m._rows);
         assert(_cols == m._cols);
@@ -369,18 +437,20 @@ namespace sb
             _data[i] *= m._data[i];
     }
 
-    Matrix Matrix::operator/(const Matrix& m) const
+    template <typename T>
+    MatrixT<T> MatrixT<T>::operator/(const MatrixT<T>& m) const
     {
         assert(_rows == m._rows);
         assert(_cols == m._cols);
 
-        Matrix res(_rows, _cols);
+        MatrixT<T> res(_rows, _cols);
         for (uint i = 0; i < _size; ++i)
             res._data[i] = _data[i] / m._data[i];
         return res;
     }
 
-    void Matrix::operator/=(const Matrix& m)
+    template <typename T>
+    void MatrixT<T>::operator/=(const MatrixT<T>& m)
     {
         assert(_rows == m._rows);
         assert(_cols == m._cols);
@@ -389,18 +459,19 @@ namespace sb
             _data[i] /= m._data[i];
     }
 
-    Matrix Matrix::matmul(const Matrix& m) const
+    template <typename T>
+    MatrixT<T> MatrixT<T>::matmul(const MatrixT<T>& m) const
     {
         assert(_cols == m._rows);
 
-        Matrix res(_rows, m._cols);
+        MatrixT<T> res(_rows, m._cols);
 
         for (uint i = 0; i < _rows; ++i)
         {
             for (uint j = 0; j < m._cols; ++j)
             {
-                Vector&& v1 = row(i);
-                Vector&& v2 = m.col(j);
+                VectorT<T>&& v1 = row(i);
+                VectorT<T>&& v2 = m.col(j);
                 res(i, j) = v1.dot(v2);
             }
         }
@@ -408,25 +479,28 @@ namespace sb
         return res;
     }
 
-    real Matrix::trace() const
+    template <typename T>
+    T MatrixT<T>::trace() const
     {
         const uint n = std::min(_rows, _cols);
-        real t = 0.;
+        T t = 0.;
         for (uint i = 0; i < n; ++i)
             t += _data[_rows * i + i];
         return t;
     }
 
-    Matrix Matrix::t() const
+    template <typename T>
+    MatrixT<T> MatrixT<T>::t() const
     {
-        Matrix res(_cols, _rows);
+        MatrixT<T> res(_cols, _rows);
         for (uint i = 0; i < _rows; ++i)
             for (uint j = 0; j < _cols; ++j)
                 res._data[_cols * j + i] = _data[_rows * i + j];
         return res;
     }
 
-    void Matrix::cofactors(Matrix& cfs, const uint row, const uint col, const uint n) const
+    template <typename T>
+    void MatrixT<T>::cofactors(MatrixT<T>& cfs, const uint row, const uint col, const uint n) const
     {
         uint i = 0, j = 0;
     
@@ -451,7 +525,8 @@ namespace sb
         }
     }
 
-    void Matrix::adjoint(Matrix& adj) const
+    template <typename T>
+    void MatrixT<T>::adjoint(MatrixT<T>& adj) const
     {
         const uint n = _rows;
 
@@ -461,7 +536,7 @@ namespace sb
             return;
         }
 
-        Matrix tmp(n, n);
+        MatrixT<T> tmp(n, n);
 
         for (uint i = 0; i < n; ++i)
         {
@@ -476,7 +551,8 @@ namespace sb
         }
     }
 
-    real Matrix::det() const
+    template <typename T>
+    T MatrixT<T>::det() const
     {
         assert(_rows == _cols);
         const uint n = _rows;
@@ -484,16 +560,17 @@ namespace sb
         return det(n);
     }
 
-    real Matrix::det(const uint n) const
+    template <typename T>
+    T MatrixT<T>::det(const uint n) const
     {
         const uint N = _rows;
-        real d = 0.;
+        T d = 0.;
 
         if (n == 1)
             d = _data[0];
         else
         {
-            Matrix tmp(N, N);
+            MatrixT<T> tmp(N, N);
 
             // iterate for each element of first row
             for (uint i = 0; i < n; ++i) 
@@ -508,22 +585,23 @@ namespace sb
         return d;
     }
 
-    Matrix Matrix::inv() const
+    template <typename T>
+    MatrixT<T> MatrixT<T>::inv() const
     {
         // source
         // https://www.geeksforgeeks.org/adjoint-inverse-matrix/
 
         assert(_rows == _cols);
 
-        real d = det();
+        T d = det();
         assert(d > EPS);
 
         const uint n = _rows;
 
-        Matrix adj(n, n);
+        MatrixT<T> adj(n, n);
         adjoint(adj);
 
-        Matrix inverse(n, n);
+        MatrixT<T> inverse(n, n);
         for (uint i = 0; i < n; ++i)
             for (uint j = 0; j < n; ++j)
                 inverse(i, j) = adj(i, j) / d;
@@ -531,7 +609,8 @@ namespace sb
         return inverse;
     }
 
-    void Matrix::translate(const Vector& v)
+    template <typename T>
+    void MatrixT<T>::translate(const VectorT<T>& v)
     {
         assert(_rows == 3 || _rows == 4);
         assert(_rows == _cols);
@@ -542,7 +621,8 @@ namespace sb
             _data[_rows * i + _cols - 1] += v.at(i);
     }
 
-    void Matrix::scale(const real& v)
+    template <typename T>
+    void MatrixT<T>::scale(const T& v)
     {
         assert(_rows == 3 || _rows == 4);
         assert(_rows == _cols);
@@ -552,7 +632,8 @@ namespace sb
             _data[_rows * i + i] *= v;
     }
 
-    void Matrix::scale(const Vector& v)
+    template <typename T>
+    void MatrixT<T>::scale(const VectorT<T>& v)
     {
         assert(_rows == 3 || _rows == 4);
         assert(_rows == _cols);
@@ -562,4 +643,7 @@ namespace sb
         for (uint i = 0; i < n; ++i)
             _data[_rows * i + i] *= v.at(i);
     }
+
+    template class MatrixT<float>;
+    template class MatrixT<double>;
 }
\ No newline at end of file
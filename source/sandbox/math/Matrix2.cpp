@@ -4,20 +4,22 @@
 
 namespace sb
 {
-    Matrix2::Matrix2()
+    template <typename T>
+    Matrix2T<T>::Matrix2T()
     {
         _size = 4;
         _rows = 2;
         _cols = 2;
 
-        _data = new real[_size];
+        _data = new T[_size];
 
-        memset(_data, 0, _size * sizeof(real));
-        _data[0] = (real)1.0;
-        _data[3] = (real)1.0;
+        memset(_data, 0, _size * sizeof(T));
+        _data[0] = (T)1.0;
+        _data[3] = (T)1.0;
     }
 
-    Matrix2::Matrix2(const std::vector<real>& v)
+    template <typename T>
+    Matrix2T<T>::Matrix2T(const std::vector<T>& v)
     {
         assert (v.size() == 4);
 
@@ -25,12 +27,13 @@ namespace sb
         _rows = 2;
         _cols = 2;
 
-        _data = new real[_size];
+        _data = new T[_size];
 
-        memcpy(_data, v.data(), _size * sizeof(real));
+        memcpy(_data, v.data(), _size * sizeof(T));
     }
 
-    Matrix2::Matrix2(const Matrix& m)
+    template <typename T>
+    Matrix2T<T>::Matrix2T(const MatrixT<T>& m)
     {
         assert (m.size() == 4);
 
@@ -38,27 +41,29 @@ namespace sb
         _rows = 2;
         _cols = 2;
 
-        _data = new real[_size];
+        _data = new T[_size];
 
-        memcpy(_data, m.data(), _size * sizeof(real));
+        memcpy(_data, m.data(), _size * sizeof(T));
     }
 
-    Matrix2::Matrix2(const Matrix2& m)
+    template <typename T>
+    Matrix2T<T>::Matrix2T(const Matrix2T<T>& m)
     {
         _size = 4;
         _rows = 2;
         _cols = 2;
 
-        _data = new real[_size];
+        _data = new T[_size];
 
-        memcpy(_data, m._data, _size * sizeof(real));
+        memcpy(_data, m._data, _size * sizeof(T));
     }
 
-    Matrix2::~Matrix2()
+    template <typename T>
+    Matrix2T<T>::~Matrix2T()
     {
         if (_data != nullptr)
         {
-            delete _data;
+            delete[] _data;
             _data = nullptr;
         }
 
@@ -66,4 +71,7 @@ namespace sb
         _rows = 0;
         _cols = 0;
     }
+
+    template class Matrix2T<float>;
+    template class Matrix2T<double>;
 }
\ No newline at end of file
@@ -4,21 +4,23 @@
 
 namespace sb
 {
-    Matrix3::Matrix3()
+    template <typename T>
+    Matrix3T<T>::Matrix3T()
     {
         _size = 9;
         _rows = 3;
         _cols = 3;
 
-        _data = new real[_size];
+        _data = new T[_size];
 
-        memset(_data, 0, _size * sizeof(real));
-        _data[0] = (real)1.0;
-        _data[4] = (real)1.0;
-        _data[8] = (real)1.0;
+        memset(_data, 0, _size * sizeof(T));
+        _data[0] = (T)1.0;
+        _data[4] = (T)1.0;
+        _data[8] = (T)1.0;
     }
 
-    Matrix3::Matrix3(const std::vector<real>& v)
+    template <typename T>
+    Matrix3T<T>::Matrix3T(const std::vector<T>& v)
     {
         assert (v.size() == 9);
 
@@ -26,12 +28,13 @@ namespace sb
         _rows = 3;
         _cols = 3;
 
-        _data = new real[_size];
+        _data = new T[_size];
 
-        memcpy(_data, v.data(), _size * sizeof(real));
+        memcpy(_data, v.data(), _size * sizeof(T));
     }
 
-    Matrix3::Matrix3(const Matrix& m)
+    template <typename T>
+    Matrix3T<T>::Matrix3T(const MatrixT<T>& m)
     {
         assert (m.size() == 9);
 
@@ -39,27 +42,29 @@ namespace sb
         _rows = 3;
         _cols = 3;
 
-        _data = new real[_size];
+        _data = new T[_size];
 
-        memcpy(_data, m.data(), _size * sizeof(real));
+        memcpy(_data, m.data(), _size * sizeof(T));
     }
 
-    Matrix3::Matrix3(const Matrix3& m)
+    template <typename T>
+    Matrix3T<T>::Matrix3T(const Matrix3T<T>& m)
     {
         _size = 9;
         _rows = 3;
         _cols = 3;
 
-        _data = new real[_size];
+        _data = new T[_size];
 
-        memcpy(_data, m._data, _size * sizeof(real));
+        memcpy(_data, m._data, _size * sizeof(T));
     }
 
-    Matrix3::~Matrix3()
+    template <typename T>
+    Matrix3T<T>::~Matrix3T()
     {
         if (_data != nullptr)
         {
-            delete _data;
+            delete[] _data;
             _data = nullptr;
         }
 
@@ -67,4 +72,7 @@ namespace sb
         _rows = 0;
         _cols = 0;
     }
+
+    template class Matrix3T<float>;
+    template class Matrix3T<double>;
 }
\ No newline at end of file
@@ -4,22 +4,24 @@
 
 namespace sb
 {
-    Matrix4::Matrix4()
+    template <typename T>
+    Matrix4T<T>::Matrix4T()
     {
         _size = 16;
         _rows = 4;
         _cols = 4;
 
-        _data = new real[_size];
+        _data = new T[_size];
 
-        memset(_data, 0, _size * sizeof(real));
-        _data[0] = (real)1.0;
-        _data[5] = (real)1.0;
-        _data[10] = (real)1.0;
-        _data[15] = (real)1.0;
+        memset(_data, 0, _size * sizeof(T));
+        _data[0] = (T)1.0;
+        _data[5] = (T)1.0;
+        _data[10] = (T)1.0;
+        _data[15] = (T)1.0;
     }
 
-    Matrix4::Matrix4(const std::vector<real>& v)
+    template <typename T>
+    Matrix4T<T>::Matrix4T(const std::vector<T>& v)
     {
         assert (v.size() == 16);
 
@@ -27,12 +29,13 @@ namespace sb
         _rows = 4;
         _cols = 4;
 
-        _data = new real[_size];
+        _data = new T[_size];
 
-        memcpy(_data, v.data(), _size * sizeof(real));
+        memcpy(_data, v.data(), _size * sizeof(T));
     }
 
-    Matrix4::Matrix4(const Matrix& m)
+    template <typename T>
+    Matrix4T<T>::Matrix4T(const MatrixT<T>& m)
     {
         assert (m.size() == 16);
 
@@ -40,27 +43,29 @@ namespace sb
         _rows = 4;
         _cols = 4;
 
-        _data = new real[_size];
+        _data = new T[_size];
 
-        memcpy(_data, m.data(), _size * sizeof(real));
+        memcpy(_data, m.data(), _size * sizeof(T));
     }
 
-    Matrix4::Matrix4(const Matrix4& m)
+    template <typename T>
+    Matrix4T<T>::Matrix4T(const Matrix4T<T>& m)
     {
         _size = 16;
         _rows = 4;
         _cols = 4;
 
-        _data = new real[_size];
+        _data = new T[_size];
 
-        memcpy(_data, m._data, _size * sizeof(real));
+        memcpy(_data, m._data, _size * sizeof(T));
     }
 
-    Matrix4::~Matrix4()
+    template <typename T>
+    Matrix4T<T>::~Matrix4T()
     {
         if (_data != nullptr)
         {
-            delete _data;
+            delete[] _data;
             _data = nullptr;
         }
 
@@ -68,4 +73,7 @@ namespace sb
         _rows = 0;
         _cols = 0;
     }
+
+    template class Matrix4T<float>;
+    template class Matrix4T<double>;
 }
\ No newline at end of file
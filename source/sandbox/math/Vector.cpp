@@ -1,92 +1,147 @@
 #include <sandbox/math/Vector.hpp>
+#include <sandbox/math/serialize.hpp>
 #include <cmath>
+#include <limits>
 #include <cstring>
 #include <cassert>
 
 namespace sb
 {
-    Vector::Vector(const uint size)
+    template <typename T>
+    VectorT<T>::VectorT(const uint size)
     {
         assert(size > 0);
 
-        _data = new real[size];
+        _data = new T[size];
         _size = size;
 
-        memset(_data, 0, _size * sizeof(real));
+        memset(_data, 0, _size * sizeof(T));
     }
 
-    Vector::Vector(const std::vector<real>& v)
+    template <typename T>
+    VectorT<T>::VectorT(const std::vector<T>& v)
     {
         assert(v.size() > 0);
 
-        _data = new real[v.size()];
+        _data = new T[v.size()];
         _size = v.size();
 
-        memcpy(_data, v.data(), _size * sizeof(real));
+        memcpy(_data, v.data(), _size * sizeof(T));
     }
 
-    Vector::Vector(const std::initializer_list<real>& list)
+    template <typename T>
+    VectorT<T>::VectorT(const std::initializer_list<T>& list)
     {
         assert(list.size() > 0);
 
-        _data = new real[list.size()];
+        _data = new T[list.size()];
         _size = list.size();
 
-        memcpy(_data, list.begin(), _size * sizeof(real));
+        memcpy(_data, list.begin(), _size * sizeof(T));
     }
 
-    Vector::Vector(const Vector& v)
+    template <typename T>
+    VectorT<T>::VectorT(const VectorT<T>& v)
     {
-        _data = new real[v._size];
+        _data = new T[v._size];
         _size = v._size;
 
-        memcpy(_data, v._data, _size * sizeof(real));
+        memcpy(_data, v._data, _size * sizeof(T));
     }
 
-    Vector::~Vector()
+    template <typename T>
+    VectorT<T>::~VectorT()
     {
         if (_data != nullptr)
         {
-            delete _data;
+            delete[] _data;
             _data = nullptr;
         }
 
         _size = 0;
     }
 
-    const real* Vector::data() const
+    template <typename T>
+    const T* VectorT<T>::data() const
     {
         return _data;
     }
 
-    uint Vector::size() const
+    template <typename T>
+    uint VectorT<T>::size() const
     {
         return _size;
     }
 
-    real& Vector::operator[](uint i)
+    template <typename T>
+    std::string VectorT<T>::toString() const
+    {
+        std::string text;
+        formatText(text, _data, 1, _size);
+        return text;
+    }
+
+    template <typename T>
+    void VectorT<T>::write(std::ostream& stream, char separator) const
+    {
+        writeText(stream, _data, 1, _size, separator);
+    }
+
+    template <typename T>
+    VectorT<T> VectorT<T>::read(std::istream& stream, char separator)
+    {
+        std::vector<T> data;
+        uint rows, cols;
+        if (!readText(stream, data, rows, cols, separator) || (rows != 1 && cols != 1))
+            return VectorT<T>();
+
+        return VectorT<T>(data);
+    }
+
+    template <typename T>
+    bool VectorT<T>::save(const std::string& filename) const
+    {
+        return writeBinary(filename, _data, 1, _size);
+    }
+
+    template <typename T>
+    VectorT<T> VectorT<T>::load(const std::string& filename)
+    {
+        std::vector<T> data;
+        uint rows, cols;
+        if (!readBinary(filename, data, rows, cols) || (rows != 1 && cols != 1))
+            return VectorT<T>();
+
+        return VectorT<T>(data);
+    }
+
+    template <typename T>
+    T& VectorT<T>::operator[](uint i)
     {
         assert(i < _size);
         return _data[i];
     }
 
-    real& Vector::operator()(const uint i)
+    template <typename T>
+    T& VectorT<T>::operator()(const uint i)
     {
         assert(i < _size);
         return _data[i];
     }
 
-    real Vector::at(const uint i) const
+    template <typename T>
+    T VectorT<T>::at(const uint i) const
     {
         assert(i < _size);
         return _data[i];
     }
 
-    real Vector::norm() const
+    template <typename T>
+    T VectorT<T>::norm() const
     {
         assert(_size > 0);
 
-        real sum_of_squares = 0;
+        T sum_of_squares = 0;
 
         for (uint i = 0; i < _size; ++i)
             sum_of_squares += _data[i] * _data[i];
@@ -94,28 +149,31 @@ namespace sb
         return sqrt(sum_of_squares);
     }
 
-    void Vector::normalize()
+    template <typename T>
+    void VectorT<T>::normalize()
     {
         assert(_size > 0);
 
-        const real n = norm();
+        const T n = norm();
         if (n > 0)
             for (uint i = 0; i < _size; ++i)
                 _data[i] /= n;
     }
 
-    Vector Vector::normalize(const Vector& v)
+    template <typename T>
+    VectorT<T> VectorT<T>::normalize(const VectorT<T>& v)
     {
         return v / v.norm();
     }
 
-    void Vector::equalize()
+    template <typename T>
+    void VectorT<T>::equalize()
     {
         assert(_size > 0);
 
         // get the min and max values of the array
-        real min_value = SB_REAL_MAX;
-        real max_value = SB_REAL_MIN;
+        T min_value = std::numeric_limits<T>::max();
+        T max_value = std::numeric_limits<T>::min();
         for (uint i = 0; i < _size; ++i)
         {
             if (_data[i] < min_value)
@@ -136,14 +194,15 @@ namespace sb
                 _data[i] /= max_value;
     }
 
-    Vector Vector::equalize(const Vector& v)
+    template <typename T>
+    VectorT<T> VectorT<T>::equalize(const VectorT<T>& v)
     {
         assert(v._size > 0);
 
-        Vector res(v);
+        VectorT<T> res(v);
 
-        real min_value = SB_REAL_MAX;
-        real max_value = SB_REAL_MIN;
+        T min_value = std::numeric_limits<T>::max();
+        T max_value = std::numeric_limits<T>::min();
         for (uint i = 0; i < v._size; ++i)
         {
             if (v._data[i] < min_value)
@@ -163,40 +222,44 @@ namespace sb
         return res;
     }
 
-    real Vector::dot(const Vector& v) const
+    template <typename T>
+    T VectorT<T>::dot(const VectorT<T>& v) const
     {
         assert(_size == v._size);
 
-        real res = 0;
+        T res = 0;
         for (uint i = 0; i < _size; ++i)
             res += _data[i] * v._data[i];
         return res;
     }
 
-    real Vector::angle(const Vector& v) const
+    template <typename T>
+    T VectorT<T>::angle(const VectorT<T>& v) const
     {
         assert(_size == v._size);
 
-        real l1 = norm();
-        real l2 = v.norm();
+        T l1 = norm();
+        T l2 = v.norm();
         assert(l1 > 0 && l2 > 0);
 
         return acos(dot(v) / (l1 * l2));
     }
 
-    Vector Vector::cross(const Vector& v) const
+    template <typename T>
+    VectorT<T> VectorT<T>::cross(const VectorT<T>& v) const
     {
         assert(_size == v._size);
         assert(_size == 3);
 
-        Vector res(3);
+        VectorT<T> res(3);
         res[0] = _data[1] * v._data[2] - _data[2] * v._data[1];
         res[1] = _data[2] * v._data[0] - _data[0] * v._data[2];
         res[2] = _data[0] * v._data[1] - _data[1] * v._data[0];
         return res;
     }
 
-    bool Vector::operator==(const Vector& v) const
+    template <typename T>
+    bool VectorT<T>::operator==(const VectorT<T>& v) const
     {
         assert(_size == v._size);
 
@@ -208,73 +271,83 @@ namespace sb
         return res;
     }
 
-    void Vector::operator=(const Vector& v)
+    template <typename T>
+    void VectorT<T>::operator=(const VectorT<T>& v)
     {
         assert(_size == v._size);
-        memcpy(_data, v._data, _size * sizeof(real));
+        memcpy(_data, v._data, _size * sizeof(T));
     }
 
-    Vector Vector::operator+(const real& v) const
+    template <typename T>
+    VectorT<T> VectorT<T>::operator+(const T& v) const
     {
-        Vector res(_size);
+        VectorT<T> res(_size);
         for (uint i = 0; i < _size; ++i)
             res._data[i] = _data[i] + v;
         return res;
     }
 
-    void Vector::operator+=(const real& v)
+    template <typename T>
+    void VectorT<T>::operator+=(const T& v)
     {
         for (uint i = 0; i < _size; ++i)
             _data[i] += v;
     }
 
-    Vector Vector::operator-(const real& v) const
+    template <typename T>
+    VectorT<T> VectorT<T>::operator-(const T& v) const
     {
-        Vector res(_size);
+        VectorT<T> res(_size);
         for (uint i = 0; i < _size; ++i)
             res._data[i] = _data[i] - v;
         return res;
     }
 
-    void Vector::operator-=(const real& v)
+    template <typename T>
+    void VectorT<T>::operator-=(const T& v)
     {
         for (uint i = 0; i < _size; ++i)
             _data[i] -= v;
     }
 
-    Vector Vector::operator-() const
+    template <typename T>
+    VectorT<T> VectorT<T>::operator-() const
     {
-        Vector res(_size);
+        VectorT<T> res(_size);
         for (uint i = 0; i < _size; ++i)
             res._data[i] = -_data[i];
         return res;
     }
 
-    Vector Vector::operator*(const real& v) const
+    template <typename T>
+    VectorT<T> VectorT<T>::operator*(const T& v) const
     {
-        Vector res(_size);
+        VectorT<T> res(_size);
         for (uint i = 0; i < _size; ++i)
             res._data[i] = _data[i] * v;
         return res;
     }
 
-    void Vector::operator*=(const real& v)
+    template <typename T>
+    void VectorT<T>::operator*=(const T& v)
     {
         for (uint i = 0; i < _size; ++i)
             _data[i] *= v;
     }
 
-    Vector Vector::operator/(const real& v) const
+    template <typename T>
+    VectorT<T> VectorT<T>::operator/(const T& v) const
     {
         assert(v != 0);
 
-        Vector res(_size);
+        VectorT<T> res(_size);
         for (uint i = 0; i < _size; ++i)
             res._data[i] = _data[i] / v;
         return res;
     }
 
-    void Vector::operator/=(const real& v)
+    template <typename T>
+    void VectorT<T>::operator/=(const T& v)
     {
         assert(v != 0);
 
@@ -282,17 +355,19 @@ namespace sb
             _data[i] /= v;
     }
 
-    Vector Vector::operator+(const Vector& v) const
+    template <typename T>
+    VectorT<T> VectorT<T>::operator+(const VectorT<T>& v) const
     {
         assert(_size == v._size);
 
-        Vector res(_size);
+        VectorT<T> res(_size);
         for (uint i = 0; i < _size; ++i)
             res._data[i] = _data[i] + v._data[i];
         return res;
     }
 
-    void Vector::operator+=(const Vector& v)
+    template <typename T>
+    void VectorT<T>::operator+=(const VectorT<T>& v)
     {
         assert(_size == v._size);
 
@@ -300,17 +375,19 @@ namespace sb
             _data[i] += v._data[i];
     }
 
-    Vector Vector::operator-(const Vector& v) const
+    template <typename T>
+    VectorT<T> VectorT<T>::operator-(const VectorT<T>& v) const
     {
         assert(_size == v._size);
 
-        Vector res(_size);
+        VectorT<T> res(_size);
         for (uint i = 0; i < _size; ++i)
             res._data[i] = _data[i] - v._data[i];
         return res;
     }
 
-    void Vector::operator-=(const Vector& v)
+    template <typename T>
+    void VectorT<T>::operator-=(const VectorT<T>& v)
     {
         assert(_size == v._size);
 
@@ -318,17 +395,19 @@ namespace sb
             _data[i] -= v._data[i];
     }
 
-    Vector Vector::operator*(const Vector& v) const
+    template <typename T>
+    VectorT<T> VectorT<T>::operator*(const VectorT<T>& v) const
     {
         assert(_size == v._size);
 
-        Vector res(_size);
+        VectorT<T> res(_size);
         for (uint i = 0; i < _size; ++i)
             res._data[i] = _data[i] * v._data[i];
         return res;
     }
 
-    void Vector::operator*=(const Vector& v)
+    template <typename T>
+    void VectorT<T>::operator*=(const VectorT<T>& v)
     {
         assert(_size == v._size);
 
@@ -336,11 +415,12 @@ namespace sb
             _data[i] *= v._data[i];
     }
 
-    Vector Vector::operator/(const Vector& v) const
+    template <typename T>
+    VectorT<T> VectorT<T>::operator/(const VectorT<T>& v) const
     {
         assert(_size == v._size);
 
-        Vector res(_size);
+        VectorT<T> res(_size);
         for (uint i = 0; i < _size; ++i)
         {
             assert(v._data[i] != 0);
@@ -349,7 +429,8 @@ namespace sb
         return res;
     }
 
-    void Vector::operator/=(const Vector& v)
+    template <typename T>
+    void VectorT<T>::operator/=(const VectorT<T>& v)
     {
         assert(_size == v._size);
 
@@ -359,4 +440,7 @@ namespace sb
             _data[i] /= v._data[i];
         }
     }
+
+    template class VectorT<float>;
+    template class VectorT<double>;
 }
\ No newline at end of file
@@ -4,64 +4,73 @@
 
 namespace sb
 {
-    Vector2::Vector2()
+    template <typename T>
+    Vector2T<T>::Vector2T()
     {
-        _data = new real[2];
+        _data = new T[2];
         _size = 2;
         
-        _data[0] = static_cast<real>(0.);
-        _data[1] = static_cast<real>(0.);
+        _data[0] = static_cast<T>(0.);
+        _data[1] = static_cast<T>(0.);
     }
 
-    Vector2::Vector2(const std::vector<real>& v)
+    template <typename T>
+    Vector2T<T>::Vector2T(const std::vector<T>& v)
     {
         assert(v.size() == 2);
 
-        _data = new real[2];
+        _data = new T[2];
         _size = 2;
 
         _data[0] = v[0];
         _data[1] = v[1];
     }
 
-    Vector2::Vector2(const std::initializer_list<real>& list)
+    template <typename T>
+    Vector2T<T>::Vector2T(const std::initializer_list<T>& list)
     {
         assert(list.size() == 2);
 
-        _data = new real[2];
+        _data = new T[2];
         _size = 2;
 
-        memcpy(_data, list.begin(), _size * sizeof(real));
+        memcpy(_data, list.begin(), _size * sizeof(T));
     }
 
-    Vector2::Vector2(const Vector& v)
+    template <typename T>
+    Vector2T<T>::Vector2T(const VectorT<T>& v)
     {
         assert(v.size() == 2);
 
-        _data = new real[2];
+        _data = new T[2];
         _size = 2;
 
         _data[0] = v.at(0);
         _data[1] = v.at(1);
     }
 
-    Vector2::Vector2(const Vector2& v)
+    template <typename T>
+    Vector2T<T>::Vector2T(const Vector2T<T>& v)
     {
-        _data = new real[2];
+        _data = new T[2];
         _size = 2;
 
         _data[0] = v._data[0];
         _data[1] = v._data[1];
     }
 
-    Vector2::~Vector2()
+    template <typename T>
+    Vector2T<T>::~Vector2T()
     {
         if (_data != nullptr)
         {
-            delete _data;
+            delete[] _data;
             _data = nullptr;
         }
 
         _size = 0;
     }
+
+    template class Vector2T<float>;
+    template class Vector2T<double>;
 }
\ No newline at end of file
@@ -4,21 +4,23 @@
 
 namespace sb
 {
-    Vector3::Vector3()
+    template <typename T>
+    Vector3T<T>::Vector3T()
     {
-        _data = new real[3];
+        _data = new T[3];
         _size = 3;
         
-        _data[0] = static_cast<real>(0.);
-        _data[1] = static_cast<real>(0.);
-        _data[2] = static_cast<real>(0.);
+        _data[0] = static_cast<T>(0.);
+        _data[1] = static_cast<T>(0.);
+        _data[2] = static_cast<T>(0.);
     }
 
-    Vector3::Vector3(const std::vector<real>& v)
+    template <typename T>
+    Vector3T<T>::Vector3T(const std::vector<T>& v)
     {
         assert(v.size() == 3);
 
-        _data = new real[3];
+        _data = new T[3];
         _size = 3;
 
         _data[0] = v[0];
@@ -26,21 +28,23 @@ namespace sb
         _data[2] = v[2];
     }
 
-    Vector3::Vector3(const std::initializer_list<real>& list)
+    template <typename T>
+    Vector3T<T>::Vector3T(const std::initializer_list<T>& list)
     {
         assert(list.size() == 3);
 
-        _data = new real[3];
+        _data = new T[3];
         _size = 3;
 
-        memcpy(_data, list.begin(), _size * sizeof(real));
+        memcpy(_data, list.begin(), _size * sizeof(T));
     }
 
-    Vector3::Vector3(const Vector& v)
+    template <typename T>
+    Vector3T<T>::Vector3T(const VectorT<T>& v)
     {
         assert(v.size() == 3);
 
-        _data = new real[3];
+        _data = new T[3];
         _size = 3;
 
         _data[0] = v.at(0);
@@ -48,9 +52,10 @@ namespace sb
         _data[2] = v.at(2);
     }
 
-    Vector3::Vector3(const Vector3& v)
+    template <typename T>
+    Vector3T<T>::Vector3T(const Vector3T<T>& v)
     {
-        _data = new real[3];
+        _data = new T[3];
         _size = 3;
 
         _data[0] = v._data[0];
@@ -58,14 +63,18 @@ namespace sb
         _data[2] = v._data[2];
     }
 
-    Vector3::~Vector3()
+    template <typename T>
+    Vector3T<T>::~Vector3T()
     {
         if (_data != nullptr)
         {
-            delete _data;
+            delete[] _data;
             _data = nullptr;
         }
 
         _size = 0;
     }
+
+    template class Vector3T<float>;
+    template class Vector3T<double>;
 }
\ No newline at end of file
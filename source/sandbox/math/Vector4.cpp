@@ -4,22 +4,24 @@
 
 namespace sb
 {
-    Vector4::Vector4()
+    template <typename T>
+    Vector4T<T>::Vector4T()
     {
-        _data = new real[4];
+        _data = new T[4];
         _size = 4;
         
-        _data[0] = static_cast<real>(0.);
-        _data[1] = static_cast<real>(0.);
-        _data[2] = static_cast<real>(0.);
-        _data[3] = static_cast<real>(0.);
+        _data[0] = static_cast<T>(0.);
+        _data[1] = static_cast<T>(0.);
+        _data[2] = static_cast<T>(0.);
+        _data[3] = static_cast<T>(0.);
     }
 
-    Vector4::Vector4(const std::vector<real>& v)
+    template <typename T>
+    Vector4T<T>::Vector4T(const std::vector<T>& v)
     {
         assert(v.size() == 4);
 
-        _data = new real[4];
+        _data = new T[4];
         _size = 4;
 
         _data[0] = v[0];
@@ -28,21 +30,23 @@ namespace sb
         _data[3] = v[3];
     }
 
-    Vector4::Vector4(const std::initializer_list<real>& list)
+    template <typename T>
+    Vector4T<T>::Vector4T(const std::initializer_list<T>& list)
     {
         assert(list.size() == 4);
 
-        _data = new real[4];
+        _data = new T[4];
         _size = 4;
 
-        memcpy(_data, list.begin(), _size * sizeof(real));
+        memcpy(_data, list.begin(), _size * sizeof(T));
     }
 
-    Vector4::Vector4(const Vector& v)
+    template <typename T>
+    Vector4T<T>::Vector4T(const VectorT<T>& v)
     {
         assert(v.size() == 4);
 
-        _data = new real[4];
+        _data = new T[4];
         _size = 4;
 
         _data[0] = v.at(0);
@@ -51,9 +55,10 @@ namespace sb
         _data[3] = v.at(3);
     }
 
-    Vector4::Vector4(const Vector4& v)
+    template <typename T>
+    Vector4T<T>::Vector4T(const Vector4T<T>& v)
     {
-        _data = new real[4];
+        _data = new T[4];
         _size = 4;
 
         _data[0] = v._data[0];
@@ -62,14 +67,18 @@ namespace sb
         _data[3] = v._data[3];
     }
 
-    Vector4::~Vector4()
+    template <typename T>
+    Vector4T<T>::~Vector4T()
     {
         if (_data != nullptr)
         {
-            delete _data;
+            delete[] _data;
             _data = nullptr;
         }
 
         _size = 0;
     }
+
+    template class Vector4T<float>;
+    template class Vector4T<double>;
 }
\ No newline at end of file
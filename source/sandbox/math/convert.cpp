@@ -0,0 +1,48 @@
+#include <sandbox/math/convert.hpp>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace sb
+{
+    void narrow(const double* src, float* dst, size_t n)
+    {
+        size_t i = 0;
+
+#if defined(__AVX__)
+        for (; i + 4 <= n; i += 4)
+            _mm_storeu_ps(dst + i, _mm256_cvtpd_ps(_mm256_loadu_pd(src + i)));
+#elif defined(__SSE2__)
+        for (; i + 4 <= n; i += 4)
+        {
+            __m128 lo = _mm_cvtpd_ps(_mm_loadu_pd(src + i));
+            __m128 hi = _mm_cvtpd_ps(_mm_loadu_pd(src + i + 2));
+            _mm_storeu_ps(dst + i, _mm_movelh_ps(lo, hi));
+        }
+#endif
+
+        for (; i < n; ++i)
+            dst[i] = static_cast<float>(src[i]);
+    }
+
+    void widen(const float* src, double* dst, size_t n)
+    {
+        size_t i = 0;
+
+#if defined(__AVX__)
+        for (; i + 4 <= n; i += 4)
+            _mm256_storeu_pd(dst + i, _mm256_cvtps_pd(_mm_loadu_ps(src + i)));
+#elif defined(__SSE2__)
+        for (; i + 4 <= n; i += 4)
+        {
+            __m128 v = _mm_loadu_ps(src + i);
+            _mm_storeu_pd(dst + i, _mm_cvtps_pd(v));
+            _mm_storeu_pd(dst + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+        }
+#endif
+
+        for (; i < n; ++i)
+            dst[i] = static_cast<double>(src[i]);
+    }
+}
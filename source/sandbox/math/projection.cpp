@@ -5,9 +5,10 @@
 
 namespace sb
 {
-    Matrix4 ortho(const real left, const real right, const real bottom, const real top, const real near, const real far)
+    template <typename T>
+    Matrix4T<T> ortho(const std::type_identity_t<T> left, const std::type_identity_t<T> right, const std::type_identity_t<T> bottom, const std::type_identity_t<T> top, const std::type_identity_t<T> near, const std::type_identity_t<T> far)
     {
-        Matrix4 m;
+        Matrix4T<T> m;
 
         m(0,0) = 2.0 / (right - left);
         m(1,1) = 2.0 / (top - bottom);
@@ -20,16 +21,17 @@ namespace sb
         return m;
     }
 
-    Matrix4 perspective(const real fov, const real aspect, const real near, const real far)
+    template <typename T>
+    Matrix4T<T> perspective(const std::type_identity_t<T> fov, const std::type_identity_t<T> aspect, const std::type_identity_t<T> near, const std::type_identity_t<T> far)
     {
         assert(fov > EPS);
         assert(aspect > EPS);
         assert(near >= 0);
         assert((far - near) > EPS);
 
-        const real tanHalfFov = tan(fov * 0.5);
+        const T tanHalfFov = tan(fov * 0.5);
 
-        Matrix4 m;
+        Matrix4T<T> m;
 
         m(0,0) = 1.0 / (aspect * tanHalfFov);
         m(1,1) = 1.0 / tanHalfFov;
@@ -41,13 +43,14 @@ namespace sb
         return m;
     }
 
-    Matrix4 lookAt(const Vector3& eye, const Vector3& center, const Vector3& up)
+    template <typename T>
+    Matrix4T<T> lookAt(const std::type_identity_t<Vector3T<T>>& eye, const std::type_identity_t<Vector3T<T>>& center, const std::type_identity_t<Vector3T<T>>& up)
     {
-        const Vector3 f = Vector::normalize(center - eye);
-        const Vector3 s = Vector::normalize(f.cross(up));
-        const Vector3 u = s.cross(f);
+        const Vector3T<T> f = VectorT<T>::normalize(center - eye);
+        const Vector3T<T> s = VectorT<T>::normalize(f.cross(up));
+        const Vector3T<T> u = s.cross(f);
 
-        Matrix4 m;
+        Matrix4T<T> m;
 
         m(0,0) =  s.at(0);
         m(0,1) =  s.at(1);
@@ -67,4 +70,12 @@ namespace sb
 
         return m;
     }
+
+    template Matrix4T<float> ortho<float>(const float, const float, const float, const float, const float, const float);
+    template Matrix4T<float> perspective<float>(const float, const float, const float, const float);
+    template Matrix4T<float> lookAt<float>(const Vector3T<float>&, const Vector3T<float>&, const Vector3T<float>&);
+
+    template Matrix4T<double> ortho<double>(const double, const double, const double, const double, const double, const double);
+    template Matrix4T<double> perspective<double>(const double, const double, const double, const double);
+    template Matrix4T<double> lookAt<double>(const Vector3T<double>&, const Vector3T<double>&, const Vector3T<double>&);
 }
\ No newline at end of file
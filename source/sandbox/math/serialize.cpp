@@ -0,0 +1,219 @@
+#include <sandbox/math/serialize.hpp>
+#include <sandbox/math/convert.hpp>
+#include <sandbox/utils/Loader.hpp>
+#include <sandbox/utils/Logger.hpp>
+#include <sandbox/utils/string.hpp>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <string_view>
+
+namespace sb
+{
+    static_assert(sizeof(MatrixHeader) == 64, "matrix header must be 64 bytes");
+    static_assert(std::endian::native == std::endian::little, "binary matrix files are little endian");
+
+    // text is written and read in chunks of this size
+    const size_t TEXT_CHUNK = 1 << 16;
+
+    template <typename T>
+    void formatText(std::string& text, const T* data, uint rows, uint cols, char separator)
+    {
+        // the shortest representation of a double takes at most 24 characters
+        char number[32];
+
+        for (uint i = 0; i < rows; ++i)
+        {
+            for (uint j = 0; j < cols; ++j)
+            {
+                const std::to_chars_result result = std::to_chars(number, number + sizeof(number), data[static_cast<size_t>(i) * cols + j]);
+                text.append(number, result.ptr);
+                text += (j + 1 < cols) ? separator : '\n';
+            }
+        }
+    }
+
+    template <typename T>
+    void writeText(std::ostream& stream, const T* data, uint rows, uint cols, char separator)
+    {
+        std::string text;
+        text.reserve(TEXT_CHUNK + 32 * cols);
+
+        for (uint i = 0; i < rows; ++i)
+        {
+            formatText(text, data + static_cast<size_t>(i) * cols, 1, cols, separator);
+            if (text.size() >= TEXT_CHUNK)
+            {
+                stream.write(text.data(), text.size());
+                text.clear();
+            }
+        }
+
+        stream.write(text.data(), text.size());
+    }
+
+    template <typename T>
+    bool readText(std::istream& stream, std::vector<T>& data, uint& rows, uint& cols, char separator)
+    {
+        data.clear();
+        rows = 0;
+        cols = 0;
+
+        std::string delimiters = " \t\r";
+        if (delimiters.find(separator) == std::string::npos)
+            delimiters += separator;
+
+        // parse complete lines, return false at the first invalid one
+        auto parse = [&](std::string_view lines)
+        {
+            std::string_view line;
+            while (!lines.empty())
+            {
+                const size_t end = lines.find('\n');
+                line = lines.substr(0, end);
+                lines.remove_prefix(end == std::string_view::npos ? lines.size() : end + 1);
+
+                const size_t first = data.size();
+                std::string_view token;
+                utils::Tokenizer tokenizer(line, delimiters);
+                while (tokenizer.next(token))
+                {
+                    T value;
+                    const std::from_chars_result result = std::from_chars(token.data(), token.data() + token.size(), value);
+                    if (result.ec != std::errc() || result.ptr != token.data() + token.size())
+                    {
+                        utils::Logger::write("ERROR::MATRIX::INVALID_NUMBER " + std::string(token));
+                        return false;
+                    }
+                    data.push_back(value);
+                }
+
+                const size_t count = data.size() - first;
+                if (count == 0)
+                    continue;
+
+                if (rows == 0)
+                    cols = static_cast<uint>(count);
+
+                if (count != cols)
+                {
+                    utils::Logger::write("ERROR::MATRIX::INVALID_ROW " + std::to_string(rows));
+                    return false;
+                }
+
+                ++rows;
+            }
+
+            return true;
+        };
+
+        // the partial line at the end of a chunk is completed by the next one
+        std::string pending;
+        std::vector<char> chunk(TEXT_CHUNK);
+        while (stream.read(chunk.data(), chunk.size()) || stream.gcount() > 0)
+        {
+            pending.append(chunk.data(), stream.gcount());
+
+            const size_t last = pending.rfind('\n');
+            if (last == std::string::npos)
+                continue;
+
+            if (!parse(std::string_view(pending).substr(0, last + 1)))
+                return false;
+            pending.erase(0, last + 1);
+        }
+
+        return parse(pending) && rows > 0;
+    }
+
+    template <typename T>
+    bool writeBinary(const std::string& filename, const T* data, uint rows, uint cols)
+    {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.is_open())
+        {
+            utils::Logger::write("Unable to open file: " + filename);
+            return false;
+        }
+
+        MatrixHeader header;
+        header.scalar_size = sizeof(T);
+        header.rows = rows;
+        header.cols = cols;
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(MatrixHeader));
+        file.write(reinterpret_cast<const char*>(data), sizeof(T) * rows * cols);
+
+        return file.good();
+    }
+
+    template <typename T>
+    bool readBinary(const std::string& filename, std::vector<T>& data, uint& rows, uint& cols)
+    {
+        utils::MappedFile file = utils::Loader::map(filename, utils::MappedFile::SEQUENTIAL);
+        if (!file.isOpen())
+            return false;
+
+        MatrixHeader header;
+        if (file.size() >= sizeof(MatrixHeader))
+            std::memcpy(&header, file.data(), sizeof(MatrixHeader));
+
+        if (file.size() < sizeof(MatrixHeader) || !validHeader(header, file.size()))
+        {
+            utils::Logger::write("ERROR::MATRIX::INVALID_FILE " + filename);
+            return false;
+        }
+
+        rows = header.rows;
+        cols = header.cols;
+        data.resize(static_cast<size_t>(rows) * cols);
+
+        const uchar* elements = file.data() + sizeof(MatrixHeader);
+        if (header.scalar_size == sizeof(T))
+        {
+            std::memcpy(data.data(), elements, sizeof(T) * data.size());
+        }
+        else if constexpr (std::is_same_v<T, float>)
+        {
+            std::vector<double> stored(data.size());
+            std::memcpy(stored.data(), elements, sizeof(double) * stored.size());
+            narrow(stored.data(), data.data(), data.size());
+        }
+        else
+        {
+            std::vector<float> stored(data.size());
+            std::memcpy(stored.data(), elements, sizeof(float) * stored.size());
+            widen(stored.data(), data.data(), data.size());
+        }
+
+        return true;
+    }
+
+    bool validHeader(const MatrixHeader& header, size_t file_size)
+    {
+        if (std::memcmp(header.magic, "SBMX", 4) != 0 || header.version != MatrixHeader().version)
+            return false;
+
+        if (header.scalar_size != sizeof(float) && header.scalar_size != sizeof(double))
+            return false;
+
+        if (header.rows == 0 || header.cols == 0)
+            return false;
+
+        return file_size == sizeof(MatrixHeader) + static_cast<size_t>(header.rows) * header.cols * header.scalar_size;
+    }
+
+    template void formatText<float>(std::string&, const float*, uint, uint, char);
+    template void formatText<double>(std::string&, const double*, uint, uint, char);
+    template void writeText<float>(std::ostream&, const float*, uint, uint, char);
+    template void writeText<double>(std::ostream&, const double*, uint, uint, char);
+    template bool readText<float>(std::istream&, std::vector<float>&, uint&, uint&, char);
+    template bool readText<double>(std::istream&, std::vector<double>&, uint&, uint&, char);
+    template bool writeBinary<float>(const std::string&, const float*, uint, uint);
+    template bool writeBinary<double>(const std::string&, const double*, uint, uint);
+    template bool readBinary<float>(const std::string&, std::vector<float>&, uint&, uint&);
+    template bool readBinary<double>(const std::string&, std::vector<double>&, uint&, uint&);
+}
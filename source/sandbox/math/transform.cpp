@@ -3,33 +3,34 @@
 #include <sandbox/math/Matrix.hpp>
 #include <cmath>
 #include <cassert>
-#include <iostream>
 
 namespace sb
 {
-    Matrix translate(const Matrix& m, const Vector& v)
+    template <typename T>
+    MatrixT<T> translate(const MatrixT<T>& m, const std::type_identity_t<VectorT<T>>& v)
     {
         const uint size = v.size();
         assert(size == 2 || size == 3);
         assert(m.rows() == m.cols());
         assert(m.rows() == size + 1);
 
-        Matrix res(m);
+        MatrixT<T> res(m);
         for (uint i = 0; i < size; ++i)
             res(i, size) += v.at(i);
 
         return res;
     }
 
-    Matrix rotate(const Matrix& m, const real angle, const Vector& axis)
+    template <typename T>
+    MatrixT<T> rotate(const MatrixT<T>& m, const std::type_identity_t<T> angle, const std::type_identity_t<VectorT<T>>& axis)
     {
         assert(m.rows() == m.cols());
         assert(m.rows() == 3 || m.rows() == 4);
 
-        const real c = cos(angle);
-        const real s = sin(angle);
+        const T c = cos(angle);
+        const T s = sin(angle);
 
-        Matrix r(m.rows(), m.cols());
+        MatrixT<T> r(m.rows(), m.cols());
 
         switch (m.rows())
         {
@@ -49,16 +50,16 @@ namespace sb
             {
                 assert(axis.size() == 3);
 
-                const Vector3 nax = Vector::normalize(axis);
-                const Vector3 tmp = nax * ((real)1. - c);
+                const Vector3T<T> nax = VectorT<T>::normalize(axis);
+                const Vector3T<T> tmp = nax * ((T)1. - c);
 
-                const real ax = nax.at(0);
-                const real ay = nax.at(1);
-                const real az = nax.at(2);
+                const T ax = nax.at(0);
+                const T ay = nax.at(1);
+                const T az = nax.at(2);
 
-                const real tx = tmp.at(0);
-                const real ty = tmp.at(1);
-                const real tz = tmp.at(2);
+                const T tx = tmp.at(0);
+                const T ty = tmp.at(1);
+                const T tz = tmp.at(2);
 
                 r(0,0) = c + tx * ax;
                 r(0,1) = tx * ay + s * az;
@@ -72,7 +73,7 @@ namespace sb
                 r(2,1) = tz * ay - s * ax;
                 r(2,2) = c + tz * az;
 
-                r(3,3) = (real)1.0;
+                r(3,3) = (T)1.0;
 
                 break;
             }
@@ -81,47 +82,62 @@ namespace sb
         return r.matmul(m);
     }
 
-    Vector rotate(const Vector& v, const real angle, const Vector& axis)
+    template <typename T>
+    VectorT<T> rotate(const VectorT<T>& v, const std::type_identity_t<T> angle, const std::type_identity_t<VectorT<T>>& axis)
     {
         const uint size = v.size();
         assert(size == 2 || size == 3);
 
-        Matrix m = Matrix::identity(size + 1);
+        MatrixT<T> m = MatrixT<T>::identity(size + 1);
         for (uint i = 0; i < size; ++i)
             m(i, size) = v.at(i);
 
         m = rotate(m, angle, axis);
-        Vector hres = m.col(size);
-        Vector res(size);
+        VectorT<T> hres = m.col(size);
+        VectorT<T> res(size);
         for (uint i = 0; i < size; ++i)
             res[i] = hres.at(i);
 
         return res;
     }
 
-    Matrix scale(const Matrix& m, const real s)
+    template <typename T>
+    MatrixT<T> scale(const MatrixT<T>& m, const std::type_identity_t<T> s)
     {
         assert(m.rows() == m.cols());
         assert(m.rows() == 3 || m.rows() == 4);
 
-        Matrix res(m);
+        MatrixT<T> res(m);
         for (uint i = 0; i < m.rows() - 1; ++i)
             res(i, i) *= s;
 
         return res;
     }
 
-    Matrix scale(const Matrix& m, const Vector& v)
+    template <typename T>
+    MatrixT<T> scale(const MatrixT<T>& m, const std::type_identity_t<VectorT<T>>& v)
     {
         const uint size = v.size();
         assert(size == 2 || size == 3);
         assert(m.rows() == m.cols());
         assert(m.rows() == size + 1);
 
-        Matrix res(m);
+        MatrixT<T> res(m);
         for (uint i = 0; i < size; ++i)
             res(i, i) *= v.at(i);
 
         return res;
     }
+
+    template MatrixT<float> translate<float>(const MatrixT<float>&, const VectorT<float>&);
+    template MatrixT<float> rotate<float>(const MatrixT<float>&, const float, const VectorT<float>&);
+    template VectorT<float> rotate<float>(const VectorT<float>&, const float, const VectorT<float>&);
+    template MatrixT<float> scale<float>(const MatrixT<float>&, const float);
+    template MatrixT<float> scale<float>(const MatrixT<float>&, const VectorT<float>&);
+
+    template MatrixT<double> translate<double>(const MatrixT<double>&, const VectorT<double>&);
+    template MatrixT<double> rotate<double>(const MatrixT<double>&, const double, const VectorT<double>&);
+    template VectorT<double> rotate<double>(const VectorT<double>&, const double, const VectorT<double>&);
+    template MatrixT<double> scale<double>(const MatrixT<double>&, const double);
+    template MatrixT<double> scale<double>(const MatrixT<double>&, const VectorT<double>&);
 }
\ No newline at end of file
@@ -0,0 +1,338 @@
+#include <sandbox/utils/Archive.hpp>
+#include <sandbox/utils/compression.hpp>
+#include <sandbox/utils/hash.hpp>
+#include <sandbox/utils/Logger.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+
+namespace sb::utils
+{
+    const std::string Archive::EXTENSION = ".sbpak";
+
+    bool Archive::open(const std::string& filename)
+    {
+        close();
+
+        // lookups and entries are accessed at random
+        if (!_file.open(filename, MappedFile::RANDOM))
+        {
+            Logger::write("Unable to open file: " + filename);
+            return false;
+        }
+
+        Header header;
+        if (_file.size() < sizeof(Header))
+        {
+            Logger::write("ERROR::ARCHIVE::INVALID_FILE " + filename);
+            close();
+            return false;
+        }
+        std::memcpy(&header, _file.data(), sizeof(Header));
+
+        // ranges are checked as differences: sums of values read from the file could overflow
+        const size_t index_size = sizeof(Entry) * header.entries + sizeof(uint) * header.buckets;
+        if (std::memcmp(header.magic, "SBPK", 4) != 0 || header.version != VERSION || header.buckets == 0 || (header.buckets & (header.buckets - 1)) != 0
+            || header.buckets <= header.entries || header.index_offset % alignof(Entry) != 0
+            || header.index_offset > header.paths_offset || index_size > header.paths_offset - header.index_offset
+            || header.paths_offset > _file.size() || header.paths_size > _file.size() - header.paths_offset)
+        {
+            Logger::write("ERROR::ARCHIVE::INVALID_HEADER " + filename);
+            close();
+            return false;
+        }
+
+        // the index is used in place, from the mapping
+        _entries = reinterpret_cast<const Entry*>(_file.data() + header.index_offset);
+        _buckets = reinterpret_cast<const uint*>(_file.data() + header.index_offset + sizeof(Entry) * header.entries);
+        _paths = reinterpret_cast<const char*>(_file.data() + header.paths_offset);
+        _num_entries = header.entries;
+        _num_buckets = header.buckets;
+
+        for (uint i = 0; i < _num_entries; ++i)
+        {
+            const Entry& e = _entries[i];
+            if (e.offset > header.index_offset || e.size > header.index_offset - e.offset || static_cast<ulong>(e.path_offset) + e.path_size > header.paths_size)
+            {
+                Logger::write("ERROR::ARCHIVE::TRUNCATED_FILE " + filename);
+                close();
+                return false;
+            }
+        }
+
+        // 'find' indexes the entries with the buckets and probes until an empty one
+        uint empty_buckets = 0;
+        for (uint b = 0; b < _num_buckets; ++b)
+        {
+            if (_buckets[b] > _num_entries)
+            {
+                Logger::write("ERROR::ARCHIVE::INVALID_INDEX " + filename);
+                close();
+                return false;
+            }
+
+            empty_buckets += (_buckets[b] == 0) ? 1 : 0;
+        }
+
+        if (empty_buckets == 0)
+        {
+            Logger::write("ERROR::ARCHIVE::INVALID_INDEX " + filename);
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    void Archive::close()
+    {
+        _file.close();
+        _entries = nullptr;
+        _buckets = nullptr;
+        _paths = nullptr;
+        _num_entries = 0;
+        _num_buckets = 0;
+    }
+
+    uint Archive::size() const
+    {
+        return _num_entries;
+    }
+
+    std::string_view Archive::path(uint i) const
+    {
+        return std::string_view(_paths + _entries[i].path_offset, _entries[i].path_size);
+    }
+
+    bool Archive::contains(const std::string& path) const
+    {
+        return find(normalize(path)) != nullptr;
+    }
+
+    MappedFile Archive::map(const std::string& path) const
+    {
+        MappedFile file;
+
+        const Entry* entry = find(normalize(path));
+        if (entry == nullptr)
+            return file;
+
+        if (!(entry->flags & COMPRESSED))
+        {
+            file.borrow(_file.data() + entry->offset, entry->size);
+            return file;
+        }
+
+        std::vector<uchar> buffer;
+        if (!decompress(*entry, buffer))
+        {
+            Logger::write("ERROR::ARCHIVE::CORRUPTED_ENTRY " + path);
+            return file;
+        }
+
+        file.adopt(std::move(buffer));
+
+        return file;
+    }
+
+    bool Archive::write(const std::string& filename, const std::vector<std::pair<std::string, std::string>>& files, bool compress)
+    {
+        std::ofstream stream(filename, std::ios::binary);
+        if (!stream.is_open())
+        {
+            Logger::write("Unable to open file: " + filename);
+            return false;
+        }
+
+        std::vector<Entry> entries;
+        std::string paths;
+
+        // the header is rewritten at the end, once offsets are known
+        Header header;
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+        const std::vector<char> padding(ALIGNMENT, 0);
+        size_t position = sizeof(Header);
+
+        for (const auto& [archive_path, disk_path] : files)
+        {
+            MappedFile file;
+            if (!file.open(disk_path, MappedFile::SEQUENTIAL))
+            {
+                Logger::write("Unable to open file: " + disk_path);
+                return false;
+            }
+
+            Entry entry;
+            entry.original_size = file.size();
+            entry.path_offset = static_cast<uint>(paths.size());
+
+            const std::string path = normalize(archive_path);
+            entry.path_size = static_cast<uint>(path.size());
+            entry.hash = hash(path);
+            paths += path;
+
+            // compression is kept only if it saves at least 1/8 of the file
+            std::vector<uchar> blocks;
+            if (compress && file.size() > 0)
+                blocks = Archive::compress(file.data(), file.size());
+
+            const bool compressed = !blocks.empty() && blocks.size() < file.size() - file.size() / 8;
+            const uchar* data = compressed ? blocks.data() : file.data();
+            entry.size = compressed ? blocks.size() : file.size();
+            entry.flags = compressed ? COMPRESSED : 0;
+
+            const size_t aligned = (position + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+            stream.write(padding.data(), aligned - position);
+            entry.offset = aligned;
+
+            if (entry.size > 0)
+                stream.write(reinterpret_cast<const char*>(data), entry.size);
+            position = aligned + entry.size;
+
+            entries.push_back(entry);
+        }
+
+        // at most half of the buckets are used, so probe sequences stay short
+        uint num_buckets = 1;
+        while (num_buckets < entries.size() * 2)
+            num_buckets <<= 1;
+
+        std::vector<uint> buckets(num_buckets, 0);
+        for (uint i = 0; i < entries.size(); ++i)
+        {
+            uint b = entries[i].hash & (num_buckets - 1);
+            while (buckets[b] != 0)
+            {
+                const Entry& other = entries[buckets[b] - 1];
+                if (other.hash == entries[i].hash && paths.compare(other.path_offset, other.path_size, paths, entries[i].path_offset, entries[i].path_size) == 0)
+                {
+                    Logger::write("ERROR::ARCHIVE::DUPLICATED_PATH " + paths.substr(entries[i].path_offset, entries[i].path_size));
+                    return false;
+                }
+                b = (b + 1) & (num_buckets - 1);
+            }
+            buckets[b] = i + 1;
+        }
+
+        const size_t index_offset = (position + 7) / 8 * 8;
+        stream.write(padding.data(), index_offset - position);
+        stream.write(reinterpret_cast<const char*>(entries.data()), sizeof(Entry) * entries.size());
+        stream.write(reinterpret_cast<const char*>(buckets.data()), sizeof(uint) * buckets.size());
+        stream.write(paths.data(), paths.size());
+
+        header.entries = static_cast<uint>(entries.size());
+        header.buckets = num_buckets;
+        header.index_offset = index_offset;
+        header.paths_offset = index_offset + sizeof(Entry) * entries.size() + sizeof(uint) * buckets.size();
+        header.paths_size = paths.size();
+
+        stream.seekp(0);
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+        return stream.good();
+    }
+
+    std::string Archive::normalize(const std::string& path)
+    {
+        // lexical only: no system call, so paths of files which exist only in archives work too
+        std::string normalized = std::filesystem::path(path).lexically_normal().generic_string();
+
+        if (normalized.starts_with("./"))
+            normalized.erase(0, 2);
+
+        return normalized;
+    }
+
+    const Archive::Entry* Archive::find(const std::string& path) const
+    {
+        if (_num_buckets == 0)
+            return nullptr;
+
+        const ulong h = hash(path);
+
+        // linear probing: the sequence ends at the first empty bucket
+        for (uint b = h & (_num_buckets - 1); _buckets[b] != 0; b = (b + 1) & (_num_buckets - 1))
+        {
+            const Entry& entry = _entries[_buckets[b] - 1];
+            if (entry.hash == h && path.compare(0, std::string::npos, _paths + entry.path_offset, entry.path_size) == 0)
+                return &entry;
+        }
+
+        return nullptr;
+    }
+
+    std::vector<uchar> Archive::compress(const uchar* data, size_t size)
+    {
+        const uint num_blocks = static_cast<uint>((size + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+        // block table first, then the blocks
+        std::vector<uchar> output(sizeof(uint) * (num_blocks + 1));
+        std::memcpy(output.data(), &num_blocks, sizeof(uint));
+
+        std::vector<uchar> block(boundLZ(BLOCK_SIZE));
+        for (uint i = 0; i < num_blocks; ++i)
+        {
+            const size_t offset = static_cast<size_t>(i) * BLOCK_SIZE;
+            const size_t length = std::min<size_t>(BLOCK_SIZE, size - offset);
+            size_t compressed = compressLZ(data + offset, length, block.data());
+
+            uint stored = static_cast<uint>(compressed);
+            const uchar* source = block.data();
+            if (compressed >= length)
+            {
+                stored = static_cast<uint>(length) | RAW_BLOCK;
+                source = data + offset;
+                compressed = length;
+            }
+
+            std::memcpy(output.data() + sizeof(uint) * (i + 1), &stored, sizeof(uint));
+            output.insert(output.end(), source, source + compressed);
+        }
+
+        return output;
+    }
+
+    bool Archive::decompress(const Entry& entry, std::vector<uchar>& buffer) const
+    {
+        const uchar* data = _file.data() + entry.offset;
+        if (entry.size < sizeof(uint))
+            return false;
+
+        uint num_blocks;
+        std::memcpy(&num_blocks, data, sizeof(uint));
+        if (num_blocks != (entry.original_size + BLOCK_SIZE - 1) / BLOCK_SIZE || sizeof(uint) * (num_blocks + 1) > entry.size)
+            return false;
+
+        buffer.resize(entry.original_size);
+
+        size_t position = sizeof(uint) * (num_blocks + 1);
+        for (uint i = 0; i < num_blocks; ++i)
+        {
+            uint stored;
+            std::memcpy(&stored, data + sizeof(uint) * (i + 1), sizeof(uint));
+
+            const size_t size = stored & ~RAW_BLOCK;
+            const size_t offset = static_cast<size_t>(i) * BLOCK_SIZE;
+            const size_t length = std::min<size_t>(BLOCK_SIZE, entry.original_size - offset);
+            if (position + size > entry.size)
+                return false;
+
+            if (stored & RAW_BLOCK)
+            {
+                if (size != length)
+                    return false;
+                std::memcpy(buffer.data() + offset, data + position, length);
+            }
+            else if (!decompressLZ(data + position, size, buffer.data() + offset, length))
+            {
+                return false;
+            }
+
+            position += size;
+        }
+
+        return true;
+    }
+}
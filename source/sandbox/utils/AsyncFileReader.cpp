@@ -0,0 +1,451 @@
+#include <sandbox/utils/AsyncFileReader.hpp>
+#include <sandbox/utils/Logger.hpp>
+#include <sandbox/utils/VirtualFileSystem.hpp>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+namespace sb::utils
+{
+    AsyncFileReader::AsyncFileReader(uint queue_depth, uint num_threads)
+        : _queue_depth(std::max(1u, queue_depth))
+    {
+        // one more entry for the no-op which stops the completion thread
+        if (setup(_queue_depth + 1))
+        {
+            _reaper = std::thread(&AsyncFileReader::reap, this);
+        }
+        else
+        {
+            SB_WARNING(Logger::UTILS, "WARNING::ASYNCFILEREADER::IO_URING_NOT_AVAILABLE fallback to pread");
+            _pool = std::make_unique<ThreadPool>(num_threads);
+        }
+    }
+
+    AsyncFileReader::~AsyncFileReader()
+    {
+        // the workers complete their jobs before joining
+        if (_pool)
+        {
+            _pool.reset();
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _queued.clear();
+            _stop = true;
+
+            // wake up the completion thread, which exits once the reads in flight are completed
+            io_uring_sqe* sqes = static_cast<io_uring_sqe*>(_ring.sqes);
+            const uint tail = *_ring.sq_tail;
+            const uint index = tail & *_ring.sq_mask;
+            std::memset(&sqes[index], 0, sizeof(io_uring_sqe));
+            sqes[index].opcode = IORING_OP_NOP;
+            _ring.sq_array[index] = index;
+            std::atomic_ref<uint>(*_ring.sq_tail).store(tail + 1, std::memory_order_release);
+            enter(1);
+        }
+
+        _reaper.join();
+        teardown();
+    }
+
+    void AsyncFileReader::read(const std::string& filename, Callback callback)
+    {
+        std::unique_ptr<Request> request = std::make_unique<Request>();
+        request->filename = filename;
+        request->callback = std::move(callback);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            ++_pending;
+        }
+
+        submit(std::move(request));
+    }
+
+    std::future<std::vector<uchar>> AsyncFileReader::read(const std::string& filename)
+    {
+        std::unique_ptr<Request> request = std::make_unique<Request>();
+        request->filename = filename;
+        std::future<std::vector<uchar>> future = request->promise.get_future();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            ++_pending;
+        }
+
+        submit(std::move(request));
+
+        return future;
+    }
+
+    uint AsyncFileReader::poll()
+    {
+        std::vector<std::unique_ptr<Request>> completed;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            completed.swap(_completed);
+        }
+
+        // callbacks run without the lock: they can queue new reads
+        for (std::unique_ptr<Request>& request : completed)
+            request->callback(request->data, request->success);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending -= static_cast<uint>(completed.size());
+
+        return static_cast<uint>(completed.size());
+    }
+
+    void AsyncFileReader::wait()
+    {
+        while (true)
+        {
+            poll();
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_pending == 0)
+                return;
+
+            _done.wait(lock, [this]() { return !_completed.empty() || _pending == 0; });
+        }
+    }
+
+    uint AsyncFileReader::pending() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _pending;
+    }
+
+    bool AsyncFileReader::uring() const
+    {
+        return _ring.fd >= 0;
+    }
+
+    void AsyncFileReader::submit(std::unique_ptr<Request> request)
+    {
+        // files in the mounted archives are already in memory: no read to schedule
+        MappedFile packed = VirtualFileSystem::map(request->filename);
+        if (packed.isOpen())
+        {
+            request->data.assign(packed.data(), packed.data() + packed.size());
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            complete(request.release(), true);
+            return;
+        }
+
+        if (_pool)
+        {
+            Request* r = request.release();
+            _pool->push([this, r]() { readBlocking(r); });
+            return;
+        }
+
+        // files are opened when they get a slot in the ring, to bound the open descriptors
+        std::unique_lock<std::mutex> lock(_mutex);
+        _queued.push_back(std::move(request));
+        pump(lock);
+    }
+
+    bool AsyncFileReader::open(Request* request)
+    {
+        request->fd = ::open(request->filename.c_str(), O_RDONLY | O_CLOEXEC);
+        if (request->fd < 0)
+        {
+            Logger::write("Unable to open file: " + request->filename);
+            return false;
+        }
+
+        struct stat info;
+        if (fstat(request->fd, &info) != 0 || !S_ISREG(info.st_mode))
+        {
+            Logger::write("ERROR::ASYNCFILEREADER::NOT_A_FILE " + request->filename);
+            return false;
+        }
+
+        request->data.resize(static_cast<size_t>(info.st_size));
+
+        return true;
+    }
+
+    bool AsyncFileReader::setup(uint entries)
+    {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+
+        _ring.fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (_ring.fd < 0)
+            return false;
+
+        // IORING_OP_READ (5.6) cannot be probed here: fast poll (5.7) implies it, so older kernels use the fallback
+        if (!(params.features & IORING_FEAT_FAST_POLL))
+        {
+            teardown();
+            return false;
+        }
+
+        _ring.entries = params.sq_entries;
+        _ring.sq_memory_size = params.sq_off.array + params.sq_entries * sizeof(uint);
+        _ring.cq_memory_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        _ring.sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+        // both rings can share the same mapping
+        const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_mmap)
+            _ring.sq_memory_size = _ring.cq_memory_size = std::max(_ring.sq_memory_size, _ring.cq_memory_size);
+
+        _ring.sq_memory = mmap(nullptr, _ring.sq_memory_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring.fd, IORING_OFF_SQ_RING);
+        if (_ring.sq_memory == MAP_FAILED)
+        {
+            _ring.sq_memory = nullptr;
+            teardown();
+            return false;
+        }
+
+        if (single_mmap)
+            _ring.cq_memory = _ring.sq_memory;
+        else
+            _ring.cq_memory = mmap(nullptr, _ring.cq_memory_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring.fd, IORING_OFF_CQ_RING);
+
+        _ring.sqes = mmap(nullptr, _ring.sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring.fd, IORING_OFF_SQES);
+
+        if (_ring.cq_memory == MAP_FAILED || _ring.sqes == MAP_FAILED)
+        {
+            _ring.cq_memory = (_ring.cq_memory == MAP_FAILED) ? nullptr : _ring.cq_memory;
+            _ring.sqes = (_ring.sqes == MAP_FAILED) ? nullptr : _ring.sqes;
+            teardown();
+            return false;
+        }
+
+        uchar* sq = static_cast<uchar*>(_ring.sq_memory);
+        _ring.sq_head = reinterpret_cast<uint*>(sq + params.sq_off.head);
+        _ring.sq_tail = reinterpret_cast<uint*>(sq + params.sq_off.tail);
+        _ring.sq_mask = reinterpret_cast<uint*>(sq + params.sq_off.ring_mask);
+        _ring.sq_array = reinterpret_cast<uint*>(sq + params.sq_off.array);
+
+        uchar* cq = static_cast<uchar*>(_ring.cq_memory);
+        _ring.cq_head = reinterpret_cast<uint*>(cq + params.cq_off.head);
+        _ring.cq_tail = reinterpret_cast<uint*>(cq + params.cq_off.tail);
+        _ring.cq_mask = reinterpret_cast<uint*>(cq + params.cq_off.ring_mask);
+        _ring.cqes = cq + params.cq_off.cqes;
+
+        return true;
+    }
+
+    void AsyncFileReader::teardown()
+    {
+        if (_ring.sqes != nullptr)
+            munmap(_ring.sqes, _ring.sqes_size);
+        if (_ring.cq_memory != nullptr && _ring.cq_memory != _ring.sq_memory)
+            munmap(_ring.cq_memory, _ring.cq_memory_size);
+        if (_ring.sq_memory != nullptr)
+            munmap(_ring.sq_memory, _ring.sq_memory_size);
+        if (_ring.fd >= 0)
+            ::close(_ring.fd);
+
+        _ring = Ring();
+    }
+
+    void AsyncFileReader::pump(std::unique_lock<std::mutex>& lock)
+    {
+        uint count = 0;
+
+        while (!_queued.empty() && _in_flight < _queue_depth && !_stop)
+        {
+            Request* request = _queued.front().release();
+            _queued.pop_front();
+
+            // the slot is taken first: a slow open must not block 'poll' or the completions
+            ++_in_flight;
+            lock.unlock();
+            const bool opened = open(request);
+            lock.lock();
+
+            // empty files need no read, and nothing is submitted once stopping
+            if (!opened || request->data.empty() || _stop)
+            {
+                --_in_flight;
+                complete(request, opened && !_stop);
+                continue;
+            }
+
+            push(request);
+            ++count;
+        }
+
+        // a single system call submits the whole batch
+        if (count > 0)
+            enter(count);
+    }
+
+    void AsyncFileReader::push(Request* request)
+    {
+        io_uring_sqe* sqes = static_cast<io_uring_sqe*>(_ring.sqes);
+
+        // the ring has a slot for each read in flight, so it is never full
+        const uint tail = *_ring.sq_tail;
+        const uint index = tail & *_ring.sq_mask;
+
+        // a single read transfers at most 2GB, larger files are completed by resubmission
+        const size_t remaining = request->data.size() - request->offset;
+
+        io_uring_sqe& sqe = sqes[index];
+        std::memset(&sqe, 0, sizeof(io_uring_sqe));
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = request->fd;
+        sqe.off = request->offset;
+        sqe.addr = reinterpret_cast<ulong>(request->data.data() + request->offset);
+        sqe.len = static_cast<uint>(std::min<size_t>(remaining, 1u << 30));
+        sqe.user_data = reinterpret_cast<ulong>(request);
+
+        _ring.sq_array[index] = index;
+
+        // the kernel must see the entry before the new tail
+        std::atomic_ref<uint>(*_ring.sq_tail).store(tail + 1, std::memory_order_release);
+    }
+
+    void AsyncFileReader::enter(uint count)
+    {
+        while (syscall(__NR_io_uring_enter, _ring.fd, count, 0, 0, nullptr, 0) < 0 && errno == EINTR);
+    }
+
+    void AsyncFileReader::reap()
+    {
+        const io_uring_cqe* cqes = static_cast<const io_uring_cqe*>(_ring.cqes);
+
+        while (true)
+        {
+            if (syscall(__NR_io_uring_enter, _ring.fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno != EINTR)
+            {
+                Logger::write("ERROR::ASYNCFILEREADER::WAIT_FAILED " + std::string(std::strerror(errno)));
+                return;
+            }
+
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            // only this thread moves the completion head
+            uint head = *_ring.cq_head;
+            const uint tail = std::atomic_ref<uint>(*_ring.cq_tail).load(std::memory_order_acquire);
+            uint count = 0;
+
+            for (; head != tail; ++head)
+            {
+                const io_uring_cqe& cqe = cqes[head & *_ring.cq_mask];
+                Request* request = reinterpret_cast<Request*>(cqe.user_data);
+
+                // the no-op which wakes up this thread
+                if (request == nullptr)
+                    continue;
+
+                if (cqe.res == -EINTR || cqe.res == -EAGAIN)
+                {
+                    push(request);
+                    ++count;
+                    continue;
+                }
+
+                if (cqe.res < 0)
+                {
+                    Logger::write("ERROR::ASYNCFILEREADER::READ_FAILED " + request->filename + " " + std::strerror(-cqe.res));
+                    --_in_flight;
+                    complete(request, false);
+                    continue;
+                }
+
+                // partial read: ask for the rest, unless the file has been truncated meanwhile
+                request->offset += static_cast<size_t>(cqe.res);
+                if (cqe.res > 0 && request->offset < request->data.size())
+                {
+                    push(request);
+                    ++count;
+                    continue;
+                }
+
+                request->data.resize(request->offset);
+                --_in_flight;
+                complete(request, true);
+            }
+
+            std::atomic_ref<uint>(*_ring.cq_head).store(head, std::memory_order_release);
+
+            if (count > 0)
+                enter(count);
+
+            // completed reads free slots for the queued ones
+            pump(lock);
+
+            if (_stop && _in_flight == 0)
+                return;
+        }
+    }
+
+    void AsyncFileReader::readBlocking(Request* request)
+    {
+        bool success = open(request);
+
+        while (success && request->offset < request->data.size())
+        {
+            ssize_t count = pread(request->fd, request->data.data() + request->offset, request->data.size() - request->offset, request->offset);
+            if (count < 0 && errno == EINTR)
+                continue;
+
+            if (count < 0)
+            {
+                Logger::write("ERROR::ASYNCFILEREADER::READ_FAILED " + request->filename + " " + std::strerror(errno));
+                success = false;
+            }
+            else if (count == 0)
+            {
+                request->data.resize(request->offset);
+            }
+            else
+            {
+                request->offset += static_cast<size_t>(count);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        complete(request, success);
+    }
+
+    void AsyncFileReader::complete(Request* request, bool success)
+    {
+        if (request->fd >= 0)
+        {
+            ::close(request->fd);
+            request->fd = -1;
+        }
+
+        if (!success)
+            request->data.clear();
+
+        if (request->callback)
+        {
+            request->success = success;
+            _completed.emplace_back(request);
+        }
+        else
+        {
+            if (success)
+                request->promise.set_value(std::move(request->data));
+            else
+                request->promise.set_exception(std::make_exception_ptr(std::runtime_error("Cannot read file: " + request->filename)));
+
+            delete request;
+            --_pending;
+        }
+
+        _done.notify_all();
+    }
+}
@@ -0,0 +1,337 @@
+#include <sandbox/utils/BinaryLog.hpp>
+#include <sandbox/utils/Loader.hpp>
+#include <sandbox/utils/Logger.hpp>
+#include <sandbox/utils/Timer.hpp>
+#include <charconv>
+#include <cstdlib>
+#include <cerrno>
+#include <ostream>
+#include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace sb::utils
+{
+    // file header: magic and version
+    const char BLOG_MAGIC[4] = {'S', 'B', 'L', 'G'};
+    const uint BLOG_VERSION = 1;
+
+    // bytes before the strings of a format definition
+    const size_t BLOG_DEFINITION_SIZE = 24;
+
+    const std::string BinaryLog::EXTENSION = ".sblog";
+    std::atomic<bool> BinaryLog::_open{false};
+    std::mutex BinaryLog::_mutex;
+    std::string BinaryLog::_definitions;
+    size_t BinaryLog::_written_definitions = 0;
+    int BinaryLog::_fd = -1;
+
+    bool BinaryLog::open(const std::string& filename)
+    {
+        close();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (_fd < 0)
+        {
+            Logger::write("Unable to open file: " + filename);
+            return false;
+        }
+
+        writeFile(BLOG_MAGIC, sizeof(BLOG_MAGIC));
+        writeFile(reinterpret_cast<const char*>(&BLOG_VERSION), sizeof(uint));
+
+        // call sites keep their ids: the formats defined so far are written again
+        _written_definitions = 0;
+
+        _open = true;
+        writer().start();
+
+        // the writer must be joined before the static objects are destroyed
+        static std::once_flag registered;
+        std::call_once(registered, []() { std::atexit(close); });
+
+        return true;
+    }
+
+    void BinaryLog::close()
+    {
+        if (!_open)
+            return;
+
+        _open = false;
+        writer().stop();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        ::close(_fd);
+        _fd = -1;
+    }
+
+    bool BinaryLog::isOpen()
+    {
+        return _open;
+    }
+
+    void BinaryLog::flush()
+    {
+        writer().flush();
+    }
+
+    void BinaryLog::setPolicy(uint policy)
+    {
+        writer().setPolicy(policy);
+    }
+
+    ulong BinaryLog::dropped()
+    {
+        return writer().dropped();
+    }
+
+    uint BinaryLog::define(const char* format, const char* file, uint line, const char* types)
+    {
+        const std::string_view format_view(format);
+        const std::string_view file_view(file);
+        const std::string_view types_view(types);
+
+        const uint entry_id = FORMAT_ID;
+        const uint size = static_cast<uint>(BLOG_DEFINITION_SIZE + types_view.size() + file_view.size() + format_view.size());
+        const ushort lengths[4] = {static_cast<ushort>(types_view.size()), static_cast<ushort>(file_view.size()), static_cast<ushort>(format_view.size()), 0};
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // ids are given in order of definition
+        static uint num_formats = 0;
+        const uint id = num_formats++;
+
+        _definitions.append(reinterpret_cast<const char*>(&size), sizeof(uint));
+        _definitions.append(reinterpret_cast<const char*>(&entry_id), sizeof(uint));
+        _definitions.append(reinterpret_cast<const char*>(&id), sizeof(uint));
+        _definitions.append(reinterpret_cast<const char*>(&line), sizeof(uint));
+        _definitions.append(reinterpret_cast<const char*>(lengths), sizeof(lengths));
+        _definitions.append(types_view);
+        _definitions.append(file_view);
+        _definitions.append(format_view);
+
+        return id;
+    }
+
+    char* BinaryLog::reserve(size_t size)
+    {
+        return writer().reserve(size);
+    }
+
+    void BinaryLog::commit(char* record, uint id, size_t size)
+    {
+        const uint record_size = static_cast<uint>(size);
+        const ulong timestamp = Timer::getFastTime();
+        const uint thread = writer().thread();
+        std::memcpy(record, &record_size, sizeof(uint));
+        std::memcpy(record + 4, &id, sizeof(uint));
+        std::memcpy(record + 8, &timestamp, sizeof(ulong));
+        std::memcpy(record + 16, &thread, sizeof(uint));
+
+        writer().commit();
+    }
+
+    LogWriter& BinaryLog::writer()
+    {
+        // never destroyed: close runs at exit, after which records are discarded
+        static LogWriter* binary_writer = new LogWriter(writeBatch);
+        return *binary_writer;
+    }
+
+    void BinaryLog::writeBatch(std::vector<char>& batch)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // a record is copied after the definition of its format: both are in the file before the record
+        if (_written_definitions < _definitions.size())
+        {
+            writeFile(_definitions.data() + _written_definitions, _definitions.size() - _written_definitions);
+            _written_definitions = _definitions.size();
+        }
+
+        writeFile(batch.data(), batch.size());
+    }
+
+    void BinaryLog::writeFile(const char* data, size_t size)
+    {
+        if (_fd < 0)
+            return;
+
+        while (size > 0)
+        {
+            const ssize_t count = ::write(_fd, data, size);
+            if (count < 0 && errno == EINTR)
+                continue;
+            if (count <= 0)
+                return;
+
+            data += count;
+            size -= static_cast<size_t>(count);
+        }
+    }
+
+    bool BinaryLog::decode(const std::string& filename, std::ostream& output)
+    {
+        MappedFile file = Loader::map(filename, MappedFile::SEQUENTIAL);
+        if (!file.isOpen())
+            return false;
+
+        const char* data = reinterpret_cast<const char*>(file.data());
+        const size_t file_size = file.size();
+
+        uint version = 0;
+        if (file_size >= 8)
+            std::memcpy(&version, data + 4, sizeof(uint));
+
+        if (file_size < 8 || std::memcmp(data, BLOG_MAGIC, 4) != 0 || version != BLOG_VERSION)
+        {
+            Logger::write("ERROR::BINARYLOG::INVALID_FILE " + filename);
+            return false;
+        }
+
+        struct Format
+        {
+            uint line;
+            std::string_view types;
+            std::string_view file;
+            std::string_view format;
+        };
+        std::unordered_map<uint, Format> formats;
+
+        std::string text;
+        char number[32];
+        auto append = [&text, &number](auto value)
+        {
+            const std::to_chars_result result = std::to_chars(number, number + sizeof(number), value);
+            text.append(number, result.ptr);
+        };
+
+        size_t position = 8;
+        while (position + 8 <= file_size)
+        {
+            uint size, id;
+            std::memcpy(&size, data + position, sizeof(uint));
+            std::memcpy(&id, data + position + 4, sizeof(uint));
+            if (size < 8 || position + size > file_size)
+                break;
+
+            const char* entry = data + position;
+            position += size;
+
+            if (id == FORMAT_ID)
+            {
+                uint format_id, line;
+                ushort lengths[4];
+                if (size < BLOG_DEFINITION_SIZE)
+                    break;
+                std::memcpy(&format_id, entry + 8, sizeof(uint));
+                std::memcpy(&line, entry + 12, sizeof(uint));
+                std::memcpy(lengths, entry + 16, sizeof(lengths));
+                if (BLOG_DEFINITION_SIZE + lengths[0] + lengths[1] + lengths[2] > size)
+                    break;
+
+                const char* strings = entry + BLOG_DEFINITION_SIZE;
+                formats[format_id] = {line, std::string_view(strings, lengths[0]), std::string_view(strings + lengths[0], lengths[1]),
+                                      std::string_view(strings + lengths[0] + lengths[1], lengths[2])};
+                continue;
+            }
+
+            auto it = formats.find(id);
+            if (it == formats.end() || size < HEADER_SIZE)
+                break;
+            const Format& format = it->second;
+
+            ulong timestamp;
+            uint thread;
+            std::memcpy(&timestamp, entry + 8, sizeof(ulong));
+            std::memcpy(&thread, entry + 16, sizeof(uint));
+
+            text.clear();
+            append(thread);
+            text += ' ';
+            append(timestamp);
+            text += ' ';
+            text.append(format.file);
+            text += ':';
+            append(format.line);
+            text += ' ';
+
+            // each "{}" is replaced by the next argument
+            const char* p = entry + HEADER_SIZE;
+            const char* end = entry + size;
+            std::string_view remaining = format.format;
+            bool valid = true;
+
+            for (char type : format.types)
+            {
+                const size_t placeholder = remaining.find("{}");
+                text.append(remaining.substr(0, placeholder));
+                remaining.remove_prefix(placeholder == std::string_view::npos ? remaining.size() : placeholder + 2);
+
+                const size_t argument_size = (type == 'b' || type == 'c') ? 1 : (type == 's' ? sizeof(uint) : 8);
+                if (end - p < static_cast<ptrdiff_t>(argument_size))
+                {
+                    valid = false;
+                    break;
+                }
+
+                if (type == 'b')
+                {
+                    text += *p ? "true" : "false";
+                }
+                else if (type == 'c')
+                {
+                    text += *p;
+                }
+                else if (type == 'i' || type == 'u' || type == 'd')
+                {
+                    long i;
+                    ulong u;
+                    double d;
+                    std::memcpy(&i, p, 8);
+                    std::memcpy(&u, p, 8);
+                    std::memcpy(&d, p, 8);
+                    if (type == 'i')
+                        append(i);
+                    else if (type == 'u')
+                        append(u);
+                    else
+                        append(d);
+                }
+                else
+                {
+                    uint length;
+                    std::memcpy(&length, p, sizeof(uint));
+                    if (static_cast<size_t>(end - p) < sizeof(uint) + length)
+                    {
+                        valid = false;
+                        break;
+                    }
+                    text.append(p + sizeof(uint), length);
+                    p += length;
+                }
+
+                p += argument_size;
+            }
+
+            if (!valid)
+                break;
+
+            text.append(remaining);
+            text += '\n';
+            output.write(text.data(), text.size());
+        }
+
+        // a crash can leave the last record incomplete: the previous ones are decoded anyway
+        if (position != file_size)
+        {
+            Logger::write("ERROR::BINARYLOG::TRUNCATED_FILE " + filename);
+            return false;
+        }
+
+        return true;
+    }
+}
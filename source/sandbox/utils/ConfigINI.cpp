@@ -0,0 +1,219 @@
+#include <sandbox/utils/ConfigINI.hpp>
+#include <sandbox/utils/hash.hpp>
+#include <sandbox/utils/Logger.hpp>
+#include <charconv>
+
+namespace sb::utils
+{
+    // blanks trimmed around sections, keys and values
+    const std::string_view BLANKS = " \t\r\f\v";
+
+    std::string_view ConfigINI::trimmed(std::string_view str)
+    {
+        const size_t first = str.find_first_not_of(BLANKS);
+        if (first == std::string_view::npos)
+            return {};
+
+        return str.substr(first, str.find_last_not_of(BLANKS) - first + 1);
+    }
+
+    bool ConfigINI::parse(MappedFile&& file)
+    {
+        _file = std::move(file);
+        _entries.clear();
+        _buckets.assign(16, 0);
+
+        std::string_view content = _file.view();
+        std::string_view section;
+
+        while (!content.empty())
+        {
+            // lines are sliced from the mapped content, comments removed
+            size_t pos = content.find('\n');
+            std::string_view line = content.substr(0, pos);
+            content.remove_prefix(pos == std::string_view::npos ? content.size() : pos + 1);
+
+            line = trimmed(line.substr(0, line.find_first_of(";#")));
+            if (line.empty())
+                continue;
+
+            if (line.front() == '[')
+            {
+                if (line.back() != ']')
+                {
+                    Logger::write("ERROR::CONFIGINI::INVALID_SECTION " + std::string(line));
+                    return false;
+                }
+
+                section = trimmed(line.substr(1, line.size() - 2));
+                continue;
+            }
+
+            pos = line.find('=');
+            if (pos == std::string_view::npos)
+            {
+                Logger::write("ERROR::CONFIGINI::INVALID_LINE " + std::string(line));
+                return false;
+            }
+
+            insert(section, trimmed(line.substr(0, pos)), trimmed(line.substr(pos + 1)));
+        }
+
+        return true;
+    }
+
+    uint ConfigINI::size() const
+    {
+        return static_cast<uint>(_entries.size());
+    }
+
+    bool ConfigINI::contains(std::string_view section, std::string_view key) const
+    {
+        return find(section, key) != nullptr;
+    }
+
+    std::string_view ConfigINI::get(std::string_view section, std::string_view key, std::string_view fallback) const
+    {
+        const Entry* entry = find(section, key);
+        return entry != nullptr ? entry->value : fallback;
+    }
+
+    int ConfigINI::getInt(std::string_view section, std::string_view key, int fallback) const
+    {
+        const Entry* entry = find(section, key);
+        if (entry == nullptr)
+            return fallback;
+
+        // real numbers are truncated
+        if (integer(*entry))
+            return static_cast<int>(entry->integer);
+        if (real(*entry))
+            return static_cast<int>(entry->real);
+
+        return fallback;
+    }
+
+    float ConfigINI::getFloat(std::string_view section, std::string_view key, float fallback) const
+    {
+        const Entry* entry = find(section, key);
+        return entry != nullptr && real(*entry) ? static_cast<float>(entry->real) : fallback;
+    }
+
+    double ConfigINI::getDouble(std::string_view section, std::string_view key, double fallback) const
+    {
+        const Entry* entry = find(section, key);
+        return entry != nullptr && real(*entry) ? entry->real : fallback;
+    }
+
+    bool ConfigINI::getBool(std::string_view section, std::string_view key, bool fallback) const
+    {
+        const Entry* entry = find(section, key);
+        if (entry == nullptr)
+            return fallback;
+
+        return !(entry->value == "0" || entry->value == "false" || entry->value == "False");
+    }
+
+    ulong ConfigINI::hash(std::string_view section, std::string_view key)
+    {
+        // the separator keeps ("ab", "c") and ("a", "bc") apart
+        const char separator = '\0';
+        ulong h = utils::hash(section.data(), section.size());
+        h = utils::hash(&separator, 1, h);
+        return utils::hash(key.data(), key.size(), h);
+    }
+
+    const ConfigINI::Entry* ConfigINI::find(std::string_view section, std::string_view key) const
+    {
+        if (_buckets.empty())
+            return nullptr;
+
+        const ulong h = hash(section, key);
+        const size_t mask = _buckets.size() - 1;
+
+        // linear probing: the sequence ends at the first empty bucket
+        for (size_t b = h & mask; _buckets[b] != 0; b = (b + 1) & mask)
+        {
+            const Entry& entry = _entries[_buckets[b] - 1];
+            if (entry.hash == h && entry.key == key && entry.section == section)
+                return &entry;
+        }
+
+        return nullptr;
+    }
+
+    void ConfigINI::insert(std::string_view section, std::string_view key, std::string_view value)
+    {
+        const ulong h = hash(section, key);
+        const size_t mask = _buckets.size() - 1;
+
+        size_t b = h & mask;
+        for (; _buckets[b] != 0; b = (b + 1) & mask)
+        {
+            Entry& entry = _entries[_buckets[b] - 1];
+            if (entry.hash == h && entry.key == key && entry.section == section)
+            {
+                entry.value = value;
+                return;
+            }
+        }
+
+        _entries.push_back({h, section, key, value});
+        _buckets[b] = static_cast<uint>(_entries.size());
+
+        // at most half of the buckets are used, so probe sequences stay short
+        if (_entries.size() * 2 > _buckets.size())
+            rehash();
+    }
+
+    void ConfigINI::rehash()
+    {
+        _buckets.assign(_buckets.size() * 2, 0);
+        const size_t mask = _buckets.size() - 1;
+
+        for (uint i = 0; i < _entries.size(); ++i)
+        {
+            size_t b = _entries[i].hash & mask;
+            while (_buckets[b] != 0)
+                b = (b + 1) & mask;
+            _buckets[b] = i + 1;
+        }
+    }
+
+    bool ConfigINI::integer(const Entry& entry)
+    {
+        if (!(entry.parsed & INTEGER) && !(entry.invalid & INTEGER))
+        {
+            // from_chars does not accept the plus sign
+            std::string_view value = entry.value;
+            if (value.starts_with('+'))
+                value.remove_prefix(1);
+
+            auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), entry.integer);
+            if (error == std::errc() && end == value.data() + value.size() && !value.empty())
+                entry.parsed |= INTEGER;
+            else
+                entry.invalid |= INTEGER;
+        }
+
+        return entry.parsed & INTEGER;
+    }
+
+    bool ConfigINI::real(const Entry& entry)
+    {
+        if (!(entry.parsed & REAL) && !(entry.invalid & REAL))
+        {
+            std::string_view value = entry.value;
+            if (value.starts_with('+'))
+                value.remove_prefix(1);
+
+            auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), entry.real);
+            if (error == std::errc() && end == value.data() + value.size() && !value.empty())
+                entry.parsed |= REAL;
+            else
+                entry.invalid |= REAL;
+        }
+
+        return entry.parsed & REAL;
+    }
+}
@@ -0,0 +1,231 @@
+#include <sandbox/utils/FrameStats.hpp>
+#include <sandbox/utils/Logger.hpp>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+namespace sb::utils
+{
+    FrameStats::FrameStats(uint window)
+    {
+        _histogram.resize(bucket(MAX_VALUE) + 1);
+        _window.resize(std::max(window, 1u));
+        reset();
+    }
+
+    void FrameStats::add(ulong frame_time)
+    {
+        if (frame_time > MAX_VALUE)
+            frame_time = MAX_VALUE;
+
+        ++_histogram[bucket(frame_time)];
+
+        if (_count > 0)
+            _sum_jitter += (frame_time > _last) ? frame_time - _last : _last - frame_time;
+
+        ++_count;
+        _min = std::min(_min, frame_time);
+        _max = std::max(_max, frame_time);
+        _sum += frame_time;
+        _sum_squares += static_cast<double>(frame_time) * frame_time;
+        _last = frame_time;
+
+        _window[_window_next] = frame_time;
+        _window_next = (_window_next + 1) % _window.size();
+        _window_count = std::min<uint>(_window_count + 1, _window.size());
+    }
+
+    void FrameStats::reset()
+    {
+        std::fill(_histogram.begin(), _histogram.end(), 0);
+        _count = 0;
+        _min = MAX_VALUE;
+        _max = 0;
+        _sum = 0;
+        _sum_squares = 0;
+        _sum_jitter = 0;
+        _last = 0;
+        _window_next = 0;
+        _window_count = 0;
+    }
+
+    ulong FrameStats::count() const
+    {
+        return _count;
+    }
+
+    ulong FrameStats::percentile(double p) const
+    {
+        if (_count == 0)
+            return 0;
+
+        // rank of the frame: the smallest one with p% of the frames not greater
+        const ulong rank = std::max<ulong>(1, static_cast<ulong>(std::ceil(std::clamp(p, 0., 100.) / 100. * _count)));
+        if (rank >= _count)
+            return _max;
+
+        ulong cumulative = 0;
+        for (uint i = 0; i < _histogram.size(); ++i)
+        {
+            cumulative += _histogram[i];
+            if (cumulative >= rank)
+            {
+                // middle of the bucket, within the observed range
+                const ulong value = (lowerBound(i) + lowerBound(i + 1) - 1) / 2;
+                return std::clamp(value, _min, _max);
+            }
+        }
+
+        return _max;
+    }
+
+    FrameStats::Summary FrameStats::summary() const
+    {
+        Summary s;
+        if (_count == 0)
+            return s;
+
+        s.count = _count;
+        s.mean = _sum / _count;
+        s.stddev = std::sqrt(std::max(0., _sum_squares / _count - s.mean * s.mean));
+        s.jitter = _count > 1 ? _sum_jitter / (_count - 1) : 0;
+        s.min = _min;
+        s.p50 = percentile(50);
+        s.p95 = percentile(95);
+        s.p99 = percentile(99);
+        s.p999 = percentile(99.9);
+        s.max = _max;
+
+        return s;
+    }
+
+    FrameStats::Summary FrameStats::window() const
+    {
+        Summary s;
+        if (_window_count == 0)
+            return s;
+
+        // frames in order of arrival, for the jitter
+        std::vector<ulong> frames;
+        recent(frames);
+
+        double sum = 0, sum_squares = 0, sum_jitter = 0;
+        for (size_t i = 0; i < frames.size(); ++i)
+        {
+            sum += frames[i];
+            sum_squares += static_cast<double>(frames[i]) * frames[i];
+            if (i > 0)
+                sum_jitter += (frames[i] > frames[i - 1]) ? frames[i] - frames[i - 1] : frames[i - 1] - frames[i];
+        }
+
+        s.count = frames.size();
+        s.mean = sum / s.count;
+        s.stddev = std::sqrt(std::max(0., sum_squares / s.count - s.mean * s.mean));
+        s.jitter = s.count > 1 ? sum_jitter / (s.count - 1) : 0;
+
+        std::sort(frames.begin(), frames.end());
+        auto rank = [&frames](double p) { return frames[std::max<size_t>(1, static_cast<size_t>(std::ceil(p / 100. * frames.size()))) - 1]; };
+        s.min = frames.front();
+        s.p50 = rank(50);
+        s.p95 = rank(95);
+        s.p99 = rank(99);
+        s.p999 = rank(99.9);
+        s.max = frames.back();
+
+        return s;
+    }
+
+    void FrameStats::recent(std::vector<ulong>& frames) const
+    {
+        frames.resize(_window_count);
+        const uint oldest = (_window_count < _window.size()) ? 0 : _window_next;
+        for (uint i = 0; i < _window_count; ++i)
+            frames[i] = _window[(oldest + i) % _window.size()];
+    }
+
+    bool FrameStats::save(const std::string& filename) const
+    {
+        const bool json = filename.ends_with(".json");
+        if (!json && !filename.ends_with(".csv"))
+        {
+            Logger::write("ERROR::FRAMESTATS::UNKNOWN_FORMAT " + filename);
+            return false;
+        }
+
+        std::ofstream file(filename);
+        if (!file.is_open())
+        {
+            Logger::write("Unable to open file: " + filename);
+            return false;
+        }
+        file << std::fixed << std::setprecision(3);
+
+        auto writeSummary = [&file](const Summary& s)
+        {
+            file << "{\"count\":" << s.count << ",\"mean\":" << s.mean << ",\"stddev\":" << s.stddev << ",\"jitter\":" << s.jitter
+                 << ",\"min\":" << s.min << ",\"p50\":" << s.p50 << ",\"p95\":" << s.p95 << ",\"p99\":" << s.p99
+                 << ",\"p99.9\":" << s.p999 << ",\"max\":" << s.max << "}";
+        };
+
+        if (json)
+        {
+            file << "{\n\"unit\":\"ns\",\n\"summary\":";
+            writeSummary(summary());
+            file << ",\n\"window\":";
+            writeSummary(window());
+            file << ",\n\"histogram\":[";
+        }
+        else
+        {
+            file << "lower_ns,upper_ns,count,cumulative_percent\n";
+        }
+
+        ulong cumulative = 0;
+        bool first = true;
+        for (uint i = 0; i < _histogram.size(); ++i)
+        {
+            if (_histogram[i] == 0)
+                continue;
+
+            cumulative += _histogram[i];
+            const double percent = 100. * cumulative / _count;
+
+            if (json)
+            {
+                file << (first ? "\n" : ",\n") << "[" << lowerBound(i) << "," << lowerBound(i + 1) - 1 << "," << _histogram[i] << "]";
+                first = false;
+            }
+            else
+            {
+                file << lowerBound(i) << "," << lowerBound(i + 1) - 1 << "," << _histogram[i] << "," << percent << "\n";
+            }
+        }
+
+        if (json)
+            file << "\n]\n}\n";
+
+        return file.good();
+    }
+
+    uint FrameStats::bucket(ulong value)
+    {
+        // values below 2 * SUB_BUCKETS have a bucket each
+        if (value < 2 * SUB_BUCKETS)
+            return static_cast<uint>(value);
+
+        // then SUB_BUCKETS buckets per power of two
+        const uint shift = std::bit_width(value) - (SUB_BUCKET_BITS + 1);
+        return (shift + 1) * SUB_BUCKETS + static_cast<uint>((value >> shift) - SUB_BUCKETS);
+    }
+
+    ulong FrameStats::lowerBound(uint bucket)
+    {
+        if (bucket < 2 * SUB_BUCKETS)
+            return bucket;
+
+        const uint shift = bucket / SUB_BUCKETS - 1;
+        return static_cast<ulong>(bucket % SUB_BUCKETS + SUB_BUCKETS) << shift;
+    }
+}
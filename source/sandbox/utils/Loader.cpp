@@ -1,77 +1,51 @@
 #include <sandbox/utils/Loader.hpp>
 #include <sandbox/utils/Logger.hpp>
-#include <sandbox/utils/string.hpp>
-#include <fstream>
+#include <sandbox/utils/VirtualFileSystem.hpp>
 #include <stdexcept>
 
 namespace sb::utils
 {
-    std::string Loader::readFileTXT(const std::string& filename)
+    MappedFile Loader::map(const std::string& filename, uint advice)
     {
-        std::ifstream file(filename);
-        if (!file.is_open())
-        {
-            Logger::write("Unable to open file: " + filename);
-            return "";
-        }
-
-        std::string text("");
-        std::string line("");
+        // mounted archives take precedence over the disk
+        MappedFile file = VirtualFileSystem::map(filename);
+        if (file.isOpen())
+            return file;
 
-        while (getline(file, line))
-            text += line + '\n';
-        
-        file.close();
+        if (!file.open(filename, advice))
+            Logger::write("Unable to open file: " + filename);
 
-        return text;
+        return file;
     }
 
-    ConfigINI Loader::readFileINI(std::string& i_filename)
+    std::string Loader::readFileTXT(const std::string& filename)
     {
-        ConfigINI ini;
-
-        std::ifstream stream(i_filename);
-        if (!stream.is_open())
-            throw std::logic_error("Cannot open file: " + i_filename);
-
-        // aux variables
-        std::string line;
-        std::string param;
-        std::string value;
-        size_t pos;
-
-        while (!stream.eof())
-        {
-            getline(stream, line);
-            sb::utils::trim(line);
+        MappedFile file = map(filename);
+        if (!file.isOpen())
+            return "";
 
-            // skip empty lines
-            if (line.empty())
-                continue;
+        // a single copy from the page cache, reserving room for the last line break
+        std::string_view content = file.view();
+        std::string text;
+        text.reserve(content.size() + 1);
+        text.assign(content);
 
-            // skip comment lines
-            if (line.at(0) == ';' || line.at(0) == '#')
-                continue;
+        if (!text.empty() && text.back() != '\n')
+            text += '\n';
 
-            // remove comments (if any)
-            pos = line.find_first_of(";#");
-            if (pos != std::string::npos)
-                line = line.substr(0, pos);
+        return text;
+    }
 
-            // find separator between key and value
-            pos = line.find('=');
-            if (pos == std::string::npos)
-                throw std::logic_error("Invalid line: " + line);
-            
-            // prepare key and value
-            param = line.substr(0, pos);
-            value = line.substr(pos+1, line.size());
-            sb::utils::trim(param);
-            sb::utils::trim(value);
+    ConfigINI Loader::readFileINI(const std::string& filename)
+    {
+        MappedFile file = map(filename);
+        if (!file.isOpen())
+            throw std::logic_error("Cannot open file: " + filename);
 
-            // save variable
-            ini[param] = value;
-        }
+        // values are views of the mapped content, kept by the configuration
+        ConfigINI ini;
+        if (!ini.parse(std::move(file)))
+            throw std::logic_error("Invalid file: " + filename);
 
         return ini;
     }
@@ -0,0 +1,333 @@
+#include <sandbox/utils/LogWriter.hpp>
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+#include <unistd.h>
+
+namespace sb::utils
+{
+    // size of the ring of each thread, a power of two: a record of MAX_RECORD bytes fits in an empty one
+    const size_t LOGWRITER_RING_SIZE = 1 << 16;
+
+    // ring record headers: record size, or padding up to the end of the ring
+    const uint32_t LOGWRITER_PAD_RECORD = 0xFFFFFFFF;
+
+    // records are written in batches of this size (at least)
+    const size_t LOGWRITER_BATCH_SIZE = 1 << 18;
+
+    // the writer checks the rings at least this often
+    const std::chrono::milliseconds LOGWRITER_IDLE_WAIT(10);
+
+    struct LogWriter::Ring
+    {
+        //! Write position, in bytes since the ring creation. Updated by the owner thread only.
+        alignas(64) std::atomic<size_t> head{0};
+
+        //! Read position, in bytes since the ring creation. Updated by the writer only.
+        alignas(64) std::atomic<size_t> tail{0};
+
+        //! Position and size of the record being written, not yet published. Used by the owner thread only.
+        size_t reserved{0};
+        size_t reserved_size{0};
+
+        //! Index of the owner thread.
+        uint thread{0};
+
+        //! Set when the owner thread exits.
+        std::atomic<bool> closed{false};
+
+        //! Records: 4 bytes header and the record, padded to 4 bytes.
+        std::vector<char> data = std::vector<char>(LOGWRITER_RING_SIZE);
+    };
+
+    std::atomic<uint> LogWriter::_num_writers{0};
+    thread_local LogWriter::RingHandle LogWriter::_handle;
+
+    LogWriter::RingHandle::~RingHandle()
+    {
+        // the writers release the rings once drained
+        for (Ring*& ring : rings)
+        {
+            if (ring != nullptr)
+                ring->closed.store(true, std::memory_order_release);
+            ring = nullptr;
+        }
+    }
+
+    LogWriter::LogWriter(std::function<void(std::vector<char>& batch)> output) :
+        _output(std::move(output)),
+        _index(_num_writers++)
+    {
+        assert(_index < std::size(_handle.rings));
+    }
+
+    LogWriter::~LogWriter()
+    {
+        stop();
+    }
+
+    void LogWriter::start()
+    {
+        std::lock_guard<std::mutex> lock(_wake_mutex);
+        if (_running)
+            return;
+
+        _running = true;
+        _writer = std::thread(&LogWriter::run, this);
+    }
+
+    void LogWriter::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_wake_mutex);
+            _running = false;
+        }
+        _wake.notify_one();
+        _flushed.notify_all();
+
+        if (_writer.joinable())
+            _writer.join();
+
+        // records committed while the writer was stopping
+        std::vector<char> batch;
+        drain(batch);
+    }
+
+    bool LogWriter::running() const
+    {
+        return _running.load(std::memory_order_acquire);
+    }
+
+    char* LogWriter::reserve(size_t size)
+    {
+        if (size > MAX_RECORD)
+        {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Ring* r = ring();
+        const size_t mask = LOGWRITER_RING_SIZE - 1;
+        const size_t needed = sizeof(uint32_t) + ((size + 3) & ~size_t(3));
+
+        size_t head = r->head.load(std::memory_order_relaxed);
+        size_t offset = head & mask;
+        size_t padding = 0;
+
+        while (true)
+        {
+            // a record is contiguous: the end of the ring is skipped if too short
+            offset = head & mask;
+            padding = (LOGWRITER_RING_SIZE - offset < needed) ? LOGWRITER_RING_SIZE - offset : 0;
+
+            const size_t used = head - r->tail.load(std::memory_order_acquire);
+            if (LOGWRITER_RING_SIZE - used >= needed + padding)
+                break;
+
+            if (_policy.load(std::memory_order_relaxed) == DROP || !_running.load(std::memory_order_relaxed))
+            {
+                _dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            // backpressure: wait for the writer to make room
+            _wake.notify_one();
+            std::this_thread::yield();
+        }
+
+        if (padding > 0)
+        {
+            std::memcpy(r->data.data() + offset, &LOGWRITER_PAD_RECORD, sizeof(uint32_t));
+            head += padding;
+            offset = 0;
+        }
+
+        const uint32_t header = static_cast<uint32_t>(size);
+        std::memcpy(r->data.data() + offset, &header, sizeof(uint32_t));
+        r->reserved = head;
+        r->reserved_size = needed;
+
+        return r->data.data() + offset + sizeof(uint32_t);
+    }
+
+    void LogWriter::commit()
+    {
+        Ring* r = _handle.rings[_index];
+
+        const size_t head = r->reserved + r->reserved_size;
+        r->head.store(head, std::memory_order_release);
+
+        // the writer is woken up early only when the ring fills up
+        if (head - r->tail.load(std::memory_order_relaxed) > LOGWRITER_RING_SIZE / 2)
+            _wake.notify_one();
+    }
+
+    uint LogWriter::thread()
+    {
+        return ring()->thread;
+    }
+
+    void LogWriter::flush()
+    {
+        if (!_running.load(std::memory_order_acquire))
+            return;
+
+        std::unique_lock<std::mutex> lock(_wake_mutex);
+        const ulong request = ++_flush_requested;
+        _wake.notify_one();
+        _flushed.wait(lock, [this, request]() { return _flush_done >= request || !_running; });
+    }
+
+    void LogWriter::setPolicy(uint policy)
+    {
+        _policy = policy;
+    }
+
+    ulong LogWriter::dropped() const
+    {
+        return _dropped.load(std::memory_order_relaxed);
+    }
+
+    void LogWriter::pause()
+    {
+        while (_draining.test_and_set(std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+
+    void LogWriter::resume()
+    {
+        _draining.clear(std::memory_order_release);
+    }
+
+    void LogWriter::drainAfterCrash()
+    {
+        for (uint i = 0; i < 100 && _draining.test_and_set(std::memory_order_acquire); ++i)
+            ::usleep(1000);
+
+        std::vector<char> batch;
+        for (const std::unique_ptr<Ring>& r : _rings)
+            drainRing(*r, batch);
+
+        output(batch);
+    }
+
+    LogWriter::Ring* LogWriter::ring()
+    {
+        Ring*& ring = _handle.rings[_index];
+        if (ring == nullptr)
+        {
+            std::unique_ptr<Ring> r = std::make_unique<Ring>();
+            ring = r.get();
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            r->thread = _num_threads++;
+            _rings.push_back(std::move(r));
+        }
+
+        return ring;
+    }
+
+    void LogWriter::run()
+    {
+        std::vector<char> batch;
+        batch.reserve(LOGWRITER_BATCH_SIZE * 2);
+
+        while (true)
+        {
+            const bool running = _running.load(std::memory_order_acquire);
+
+            ulong request;
+            {
+                std::lock_guard<std::mutex> lock(_wake_mutex);
+                request = _flush_requested;
+            }
+
+            const bool written = drain(batch);
+
+            std::unique_lock<std::mutex> lock(_wake_mutex);
+            if (_flush_done < request)
+            {
+                _flush_done = request;
+                _flushed.notify_all();
+            }
+
+            // the last drain after the stop request wrote every record
+            if (!running)
+                break;
+
+            if (!written && _flush_requested == request)
+                _wake.wait_for(lock, LOGWRITER_IDLE_WAIT);
+        }
+    }
+
+    bool LogWriter::drain(std::vector<char>& batch)
+    {
+        std::vector<Ring*> rings;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            rings.reserve(_rings.size());
+            for (const std::unique_ptr<Ring>& r : _rings)
+                rings.push_back(r.get());
+        }
+
+        pause();
+
+        bool drained = false;
+        for (Ring* r : rings)
+        {
+            drained |= r->tail.load(std::memory_order_relaxed) != r->head.load(std::memory_order_acquire);
+            drainRing(*r, batch);
+        }
+
+        // called even without records: the output may have its own entries to write
+        output(batch);
+
+        resume();
+
+        // rings of the exited threads are released once empty
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::erase_if(_rings, [](const std::unique_ptr<Ring>& r)
+        {
+            return r->closed.load(std::memory_order_acquire) && r->tail.load(std::memory_order_relaxed) == r->head.load(std::memory_order_acquire);
+        });
+
+        return drained;
+    }
+
+    void LogWriter::drainRing(Ring& ring, std::vector<char>& batch)
+    {
+        const size_t mask = LOGWRITER_RING_SIZE - 1;
+        size_t tail = ring.tail.load(std::memory_order_relaxed);
+        const size_t head = ring.head.load(std::memory_order_acquire);
+
+        while (tail != head)
+        {
+            const size_t offset = tail & mask;
+
+            uint32_t header;
+            std::memcpy(&header, ring.data.data() + offset, sizeof(uint32_t));
+
+            if (header == LOGWRITER_PAD_RECORD)
+            {
+                tail += LOGWRITER_RING_SIZE - offset;
+                continue;
+            }
+
+            const char* record = ring.data.data() + offset + sizeof(uint32_t);
+            batch.insert(batch.end(), record, record + header);
+
+            // the record is copied: its room can be reused by the thread
+            tail += sizeof(uint32_t) + ((header + 3) & ~size_t(3));
+            ring.tail.store(tail, std::memory_order_release);
+
+            if (batch.size() >= LOGWRITER_BATCH_SIZE)
+                output(batch);
+        }
+    }
+
+    void LogWriter::output(std::vector<char>& batch)
+    {
+        _output(batch);
+        batch.clear();
+    }
+}
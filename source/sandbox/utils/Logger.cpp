@@ -1,7 +1,11 @@
 #include <sandbox/utils/Logger.hpp>
 #include <sandbox/utils/Timer.hpp>
-#include <thread>
-#include <fstream>
+#include <algorithm>
+#include <charconv>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <sstream>
 #include <execinfo.h>
 #include <fcntl.h>
@@ -15,25 +19,93 @@ namespace sb::utils
     std::string Logger::_log_fn = "sandbox.log";
     std::string Logger::_stack_trace_fn = "stacktrace.log";
     std::mutex Logger::_mutex;
+    int Logger::_fd = -1;
+    std::atomic<uint> Logger::_categories{Logger::ALL};
 
-    void Logger::write(std::string message, bool append)
+    void Logger::write(std::string_view message, bool append)
     {
-        std::ios::openmode flags = std::ios::in | std::ios::out;
-        if (append)
-            flags |= std::fstream::app;
+        start();
 
-        std::stringstream ss;
-        ss << std::this_thread::get_id() << " " << Timer::getSystemTime();
-        std::string text = ss.str() + " " + message + "\n";
+        // lines are formatted out of the ring, in a buffer reused by the thread
+        thread_local std::string line;
+        format(line, message);
+        const size_t max_line = LogWriter::MAX_RECORD;
+        if (line.size() > max_line)
+        {
+            line.resize(max_line);
+            line.back() = '\n';
+        }
 
-        _mutex.lock();
+        LogWriter& w = writer();
+        if (!w.running())
+        {
+            // the writer is stopped (eg. at exit): write straight to the file
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!append && _fd >= 0 && ftruncate(_fd, 0) != 0)
+                std::perror("ERROR::LOGGER::TRUNCATE_FAILED");
+            writeFile(line.data(), line.size());
+            return;
+        }
 
-        std::fstream fs;
-        fs.open(_log_fn, flags);
-        fs.write(text.c_str(), text.size());
-        fs.close();
+        if (!append)
+        {
+            // the lines logged so far go to the file before it is cleared
+            w.flush();
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_fd >= 0 && ftruncate(_fd, 0) != 0)
+                std::perror("ERROR::LOGGER::TRUNCATE_FAILED");
+        }
 
-        _mutex.unlock();
+        char* record = w.reserve(line.size());
+        if (record == nullptr)
+            return;
+
+        std::memcpy(record, line.data(), line.size());
+        w.commit();
+    }
+
+    void Logger::flush()
+    {
+        writer().flush();
+    }
+
+    void Logger::setCategories(uint mask)
+    {
+        _categories.store(mask, std::memory_order_relaxed);
+    }
+
+    uint Logger::categories()
+    {
+        return _categories.load(std::memory_order_relaxed);
+    }
+
+    void Logger::setPolicy(uint policy)
+    {
+        writer().setPolicy(policy);
+    }
+
+    ulong Logger::dropped()
+    {
+        return writer().dropped();
+    }
+
+    void Logger::setFilename(const std::string& filename)
+    {
+        flush();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _log_fn = filename;
+
+        if (_fd < 0)
+            return;
+
+        // the writer is not writing while paused
+        writer().pause();
+
+        ::close(_fd);
+        _fd = ::open(_log_fn.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+
+        writer().resume();
     }
 
     void Logger::setSignalHandler(int signal_code)
@@ -49,9 +121,14 @@ namespace sb::utils
         // get void*'s for all entries on the stack
         size_t stack_trace_length = backtrace(array, max_stack_trace_length);
 
+        // write the pending lines first
+        writer().drainAfterCrash();
+
         // print out all the frames to stderr
         std::string s = "ERROR: signal " + std::to_string(signal_code) + "\n";
-        write(s);
+        std::string line;
+        format(line, s);
+        writeFile(line.data(), line.size());
 
         backtrace_symbols_fd(array, stack_trace_length, STDERR_FILENO);
 
@@ -65,6 +142,85 @@ namespace sb::utils
         free(fun_names);
         fclose(fp);
 
-        exit(EXIT_FAILURE);
+        // exit handlers would wait for the writer thread, which may be the crashed one
+        std::_Exit(EXIT_FAILURE);
+    }
+
+    void Logger::start()
+    {
+        static std::once_flag started;
+        std::call_once(started, []()
+        {
+            _fd = ::open(_log_fn.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+
+            writer().start();
+            std::atexit(stop);
+        });
+    }
+
+    void Logger::stop()
+    {
+        writer().stop();
+    }
+
+    LogWriter& Logger::writer()
+    {
+        // created on first use, as lines can be logged during the static initialization, and never destroyed, as during the destruction
+        static LogWriter* logger_writer = new LogWriter(output);
+        return *logger_writer;
+    }
+
+    void Logger::output(std::vector<char>& batch)
+    {
+        static ulong reported_drops = 0;
+
+        const ulong drops = writer().dropped();
+        if (drops != reported_drops)
+        {
+            std::string line;
+            format(line, "WARNING::LOGGER::DROPPED_MESSAGES " + std::to_string(drops - reported_drops));
+            batch.insert(batch.end(), line.begin(), line.end());
+            reported_drops = drops;
+        }
+
+        writeFile(batch.data(), batch.size());
+    }
+
+    void Logger::format(std::string& line, std::string_view message)
+    {
+        // the thread id is formatted once per thread
+        thread_local const std::string thread_id = []()
+        {
+            std::stringstream ss;
+            ss << std::this_thread::get_id() << " ";
+            return ss.str();
+        }();
+
+        char timestamp[24];
+        const std::to_chars_result result = std::to_chars(timestamp, timestamp + sizeof(timestamp), Timer::getFastTime());
+
+        line.assign(thread_id);
+        line.append(timestamp, result.ptr);
+        line += ' ';
+        line.append(message);
+        line += '\n';
+    }
+
+    void Logger::writeFile(const char* data, size_t size)
+    {
+        if (_fd < 0)
+            return;
+
+        while (size > 0)
+        {
+            const ssize_t count = ::write(_fd, data, size);
+            if (count < 0 && errno == EINTR)
+                continue;
+            if (count <= 0)
+                return;
+
+            data += count;
+            size -= static_cast<size_t>(count);
+        }
     }
-}
\ No newline at end of file
+}
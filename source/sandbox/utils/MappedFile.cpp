@@ -0,0 +1,195 @@
+#include <sandbox/utils/MappedFile.hpp>
+#include <utility>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace sb::utils
+{
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+
+        close();
+
+        // moving the vector keeps its heap block, so the data pointer stays valid
+        _data = other._data;
+        _size = other._size;
+        _mapped = other._mapped;
+        _owner = other._owner;
+        _open = other._open;
+        _buffer = std::move(other._buffer);
+
+        other._data = nullptr;
+        other._size = 0;
+        other._mapped = false;
+        other._owner = false;
+        other._open = false;
+
+        return *this;
+    }
+
+    bool MappedFile::open(const std::string& filename, uint advice)
+    {
+        close();
+
+        int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return false;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        const size_t size = static_cast<size_t>(info.st_size);
+
+        // empty files cannot be mapped, but they are valid files
+        if (size == 0 && S_ISREG(info.st_mode))
+        {
+            ::close(fd);
+            _open = true;
+            return true;
+        }
+
+        if (advice != READ && S_ISREG(info.st_mode))
+        {
+            // the mapping stays valid after closing the descriptor
+            void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED)
+            {
+                ::close(fd);
+
+                if (advice == SEQUENTIAL)
+                    madvise(mapped, size, MADV_SEQUENTIAL);
+                else if (advice == RANDOM)
+                    madvise(mapped, size, MADV_RANDOM);
+                else if (advice == WILLNEED)
+                    madvise(mapped, size, MADV_WILLNEED);
+
+                _data = static_cast<const uchar*>(mapped);
+                _size = size;
+                _mapped = true;
+                _owner = true;
+                _open = true;
+
+                return true;
+            }
+        }
+
+        _open = read(fd, size);
+        ::close(fd);
+
+        return _open;
+    }
+
+    void MappedFile::close()
+    {
+        if (_mapped && _owner)
+            munmap(const_cast<uchar*>(_data), _size);
+
+        _data = nullptr;
+        _size = 0;
+        _mapped = false;
+        _owner = false;
+        _open = false;
+        _buffer.clear();
+        _buffer.shrink_to_fit();
+    }
+
+    bool MappedFile::isOpen() const
+    {
+        return _open;
+    }
+
+    bool MappedFile::mapped() const
+    {
+        return _mapped;
+    }
+
+    const uchar* MappedFile::data() const
+    {
+        return _data;
+    }
+
+    size_t MappedFile::size() const
+    {
+        return _size;
+    }
+
+    std::string_view MappedFile::view() const
+    {
+        return std::string_view(reinterpret_cast<const char*>(_data), _size);
+    }
+
+    bool MappedFile::read(int fd, size_t size)
+    {
+        // special files report no size: grow the buffer until the end of file
+        _buffer.resize(size > 0 ? size : 4096);
+
+        size_t total = 0;
+        while (true)
+        {
+            if (total == _buffer.size())
+            {
+                if (size > 0)
+                    break;
+                _buffer.resize(_buffer.size() * 2);
+            }
+
+            ssize_t count = ::read(fd, _buffer.data() + total, _buffer.size() - total);
+            if (count < 0 && errno == EINTR)
+                continue;
+            if (count < 0)
+            {
+                _buffer.clear();
+                return false;
+            }
+            if (count == 0)
+                break;
+
+            total += static_cast<size_t>(count);
+        }
+
+        _buffer.resize(total);
+        _data = _buffer.empty() ? nullptr : _buffer.data();
+        _size = total;
+
+        return true;
+    }
+
+    void MappedFile::borrow(const uchar* data, size_t size)
+    {
+        close();
+
+        _data = (size > 0) ? data : nullptr;
+        _size = size;
+        _mapped = true;
+        _open = true;
+    }
+
+    void MappedFile::adopt(std::vector<uchar>&& buffer)
+    {
+        close();
+
+        _buffer = std::move(buffer);
+        _data = _buffer.empty() ? nullptr : _buffer.data();
+        _size = _buffer.size();
+        _open = true;
+    }
+}
@@ -0,0 +1,208 @@
+#include <sandbox/utils/Profiler.hpp>
+#include <sandbox/utils/Logger.hpp>
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+
+namespace sb::utils
+{
+    // name of the frame zones
+    const char* const PROFILER_FRAME = "Frame";
+
+    std::atomic<bool> Profiler::_enabled{false};
+    std::atomic<ulong> Profiler::_dropped{0};
+    std::mutex Profiler::_mutex;
+    std::vector<std::unique_ptr<Profiler::Buffer>> Profiler::_buffers;
+    thread_local Profiler::Buffer* Profiler::_buffer = nullptr;
+
+    void Profiler::setEnabled(bool enable)
+    {
+        _enabled.store(enable, std::memory_order_relaxed);
+    }
+
+    void Profiler::frame()
+    {
+        if (!enabled())
+        {
+            // the next frame starts from scratch once enabled
+            if (_buffer != nullptr)
+                _buffer->frame_begin = 0;
+            return;
+        }
+
+        Buffer* b = buffer();
+        const ulong now = Timer::getTicks();
+
+        if (b->frame_begin != 0)
+            record(PROFILER_FRAME, b->frame_begin, now);
+        b->frame_begin = now;
+    }
+
+    void Profiler::setThreadName(const std::string& name)
+    {
+        Buffer* b = buffer();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        b->name = name;
+    }
+
+    bool Profiler::save(const std::string& filename)
+    {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.is_open())
+        {
+            Logger::write("Unable to open file: " + filename);
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // zones of each thread, sorted by begin time: parents before their children
+        std::vector<std::vector<Zone>> threads;
+        ulong t0 = ~0ul;
+        for (const std::unique_ptr<Buffer>& b : _buffers)
+        {
+            const size_t size = b->size.load(std::memory_order_acquire);
+            std::vector<Zone>& zones = threads.emplace_back(b->zones.begin(), b->zones.begin() + size);
+            std::sort(zones.begin(), zones.end(), [](const Zone& a, const Zone& b)
+            {
+                return a.begin < b.begin || (a.begin == b.begin && a.end > b.end);
+            });
+
+            if (!zones.empty())
+                t0 = std::min(t0, zones.front().begin);
+        }
+        t0 = Timer::toNanoseconds(t0);
+
+        std::string json;
+        json.reserve(1 << 20);
+        json += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+        bool first = true;
+        for (size_t i = 0; i < _buffers.size(); ++i)
+        {
+            const Buffer& b = *_buffers[i];
+            const std::string tid = std::to_string(b.thread);
+
+            json += first ? "\n" : ",\n";
+            first = false;
+            json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid + ",\"args\":{\"name\":";
+            appendString(json, b.name.empty() ? "thread " + tid : b.name);
+            json += "}}";
+
+            uint frame = 0;
+            for (const Zone& zone : threads[i])
+            {
+                json += ",\n{\"name\":";
+                appendString(json, zone.name);
+                json += ",\"ph\":\"X\",\"pid\":1,\"tid\":" + tid + ",\"ts\":";
+                const ulong begin = Timer::toNanoseconds(zone.begin);
+                appendMicroseconds(json, begin - t0);
+                json += ",\"dur\":";
+                appendMicroseconds(json, Timer::toNanoseconds(zone.end) - begin);
+                if (zone.name == PROFILER_FRAME)
+                    json += ",\"args\":{\"frame\":" + std::to_string(frame++) + "}";
+                json += '}';
+
+                if (json.size() >= (1 << 20))
+                {
+                    file.write(json.data(), json.size());
+                    json.clear();
+                }
+            }
+        }
+
+        json += "\n]}\n";
+        file.write(json.data(), json.size());
+
+        if (!file)
+        {
+            Logger::write("ERROR::PROFILER::WRITE_FAILED " + filename);
+            return false;
+        }
+
+        return true;
+    }
+
+    void Profiler::clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (const std::unique_ptr<Buffer>& b : _buffers)
+        {
+            b->size.store(0, std::memory_order_relaxed);
+            b->frame_begin = 0;
+        }
+        _dropped = 0;
+    }
+
+    ulong Profiler::dropped()
+    {
+        return _dropped.load(std::memory_order_relaxed);
+    }
+
+    void Profiler::record(const char* name, ulong begin, ulong end)
+    {
+        Buffer* b = buffer();
+
+        const size_t size = b->size.load(std::memory_order_relaxed);
+        if (size == CAPACITY)
+        {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        b->zones[size] = {name, begin, end};
+        b->size.store(size + 1, std::memory_order_release);
+    }
+
+    Profiler::Buffer* Profiler::buffer()
+    {
+        if (_buffer == nullptr)
+        {
+            std::unique_ptr<Buffer> b = std::make_unique<Buffer>();
+            b->zones.resize(CAPACITY);
+            _buffer = b.get();
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            b->thread = static_cast<uint>(_buffers.size());
+            _buffers.push_back(std::move(b));
+        }
+
+        return _buffer;
+    }
+
+    void Profiler::appendString(std::string& json, std::string_view str)
+    {
+        json += '"';
+        for (char c : str)
+        {
+            if (c == '"' || c == '\\')
+            {
+                json += '\\';
+                json += c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                json += ' ';
+            }
+            else
+            {
+                json += c;
+            }
+        }
+        json += '"';
+    }
+
+    void Profiler::appendMicroseconds(std::string& json, ulong ns)
+    {
+        char number[32];
+        std::to_chars_result result = std::to_chars(number, number + sizeof(number), ns / 1000);
+        json.append(number, result.ptr);
+
+        const ulong decimals = ns % 1000;
+        json += '.';
+        json += static_cast<char>('0' + decimals / 100);
+        json += static_cast<char>('0' + decimals / 10 % 10);
+        json += static_cast<char>('0' + decimals % 10);
+    }
+}
@@ -0,0 +1,74 @@
+#include <sandbox/utils/ThreadPool.hpp>
+#include <algorithm>
+
+namespace sb::utils
+{
+    ThreadPool::ThreadPool(uint num_threads)
+    {
+        if (num_threads == 0)
+            num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+        for (uint i = 0; i < num_threads; ++i)
+            _workers.emplace_back(&ThreadPool::work, this);
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _job_available.notify_all();
+
+        for (std::thread& worker : _workers)
+            worker.join();
+    }
+
+    void ThreadPool::push(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _jobs.push(std::move(job));
+        }
+        _job_available.notify_one();
+    }
+
+    void ThreadPool::wait()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _job_done.wait(lock, [this]{ return _jobs.empty() && _running == 0; });
+    }
+
+    uint ThreadPool::size() const
+    {
+        return static_cast<uint>(_workers.size());
+    }
+
+    void ThreadPool::work()
+    {
+        while (true)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _job_available.wait(lock, [this]{ return _stop || !_jobs.empty(); });
+
+                // queued jobs are completed before exiting
+                if (_jobs.empty())
+                    return;
+
+                job = std::move(_jobs.front());
+                _jobs.pop();
+                ++_running;
+            }
+
+            job();
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                --_running;
+            }
+            _job_done.notify_all();
+        }
+    }
+}
@@ -1,11 +1,28 @@
 #include <sandbox/utils/Timer.hpp>
+#include <mutex>
 #include <thread>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
 namespace sb::utils
 {
     // timer resolution: milliseconds, microseconds, nanoseconds
     using timeres = std::chrono::nanoseconds;
 
+    // length of the calibration: the frequency error is about the width of a counter read bracket (~20 ns) over this interval
+    const std::chrono::milliseconds TSC_CALIBRATION_TIME(5);
+
+    // counter reads at each end of the calibration, the most precise one is kept
+    const uint TSC_CALIBRATION_SAMPLES = 16;
+
+    bool Timer::_tsc = false;
+    ulong Timer::_tsc_base = 0;
+    ulong Timer::_ns_base = 0;
+    ulong Timer::_tsc_scale = 1ul << 32;
+    std::atomic<bool> Timer::_calibrated{false};
+
     Timer::Timer()
     {
         restart();
@@ -47,8 +64,81 @@ namespace sb::utils
         std::this_thread::sleep_for<int64_t, std::micro>(std::chrono::microseconds(us));
     }
 
-    std::chrono::steady_clock::time_point Timer::getTime()
+    bool Timer::usesTSC()
+    {
+        if (!_calibrated.load(std::memory_order_acquire))
+            initialize();
+
+        return _tsc;
+    }
+
+    double Timer::tickFrequency()
+    {
+        if (!_calibrated.load(std::memory_order_acquire))
+            initialize();
+
+        return _tsc ? 1e9 * 4294967296. / _tsc_scale : 1e9;
+    }
+
+    void Timer::initialize()
+    {
+        // not during the static initialization: the calibration sleeps, and only programs which read ticks pay for it
+        static std::once_flag calibrated;
+        std::call_once(calibrated, []()
+        {
+            calibrate();
+            _calibrated.store(true, std::memory_order_release);
+        });
+    }
+
+    bool Timer::calibrate()
     {
-        return std::chrono::steady_clock::now();
+#if defined(__x86_64__) || defined(__i386__)
+        // invariant TSC: extended leaf 0x80000007, EDX bit 8
+        uint eax, ebx, ecx, edx;
+        if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007)
+            return false;
+        __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+        if ((edx & (1u << 8)) == 0)
+            return false;
+
+        // each counter read is bracketed by two clock reads: their midpoint is its system time.
+        // The narrowest bracket is kept, so a preemption between the reads does not skew the rate
+        auto sample = [](ulong& ticks, ulong& ns)
+        {
+            ulong width = ~0ul;
+            for (uint i = 0; i < TSC_CALIBRATION_SAMPLES; ++i)
+            {
+                const ulong t0 = getSystemTime();
+                const ulong counter = __rdtsc();
+                const ulong t1 = getSystemTime();
+                if (t1 - t0 < width)
+                {
+                    width = t1 - t0;
+                    ticks = counter;
+                    ns = t0 + (t1 - t0) / 2;
+                }
+            }
+        };
+
+        ulong ticks0 = 0, ns0 = 0, ticks1 = 0, ns1 = 0;
+        sample(ticks0, ns0);
+        std::this_thread::sleep_for(TSC_CALIBRATION_TIME);
+        sample(ticks1, ns1);
+
+        // implausible rates (eg. a broken virtualized counter) keep steady_clock
+        const double frequency = (ticks1 - ticks0) * 1e9 / (ns1 - ns0);
+        if (ns1 <= ns0 || frequency < 1e8 || frequency > 1e11)
+            return false;
+
+        _tsc_base = ticks1;
+        _ns_base = ns1;
+        _tsc_scale = static_cast<ulong>((ns1 - ns0) * 4294967296. / (ticks1 - ticks0));
+        _tsc = true;
+
+        return true;
+#else
+        return false;
+#endif
     }
 }
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include <sandbox/utils/VirtualFileSystem.hpp>
+#include <sandbox/utils/Logger.hpp>
+#include <mutex>
+
+namespace sb::utils
+{
+    std::vector<std::pair<std::string, std::unique_ptr<Archive>>> VirtualFileSystem::_archives;
+    std::atomic<uint> VirtualFileSystem::_num_archives{0};
+    std::shared_mutex VirtualFileSystem::_mutex;
+
+    bool VirtualFileSystem::mount(const std::string& filename)
+    {
+        std::unique_ptr<Archive> archive = std::make_unique<Archive>();
+        if (!archive->open(filename))
+        {
+            Logger::write("ERROR::VFS::MOUNT_FAILED " + filename);
+            return false;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(_mutex);
+        _archives.emplace_back(filename, std::move(archive));
+        _num_archives = static_cast<uint>(_archives.size());
+
+        return true;
+    }
+
+    void VirtualFileSystem::unmount(const std::string& filename)
+    {
+        std::unique_lock<std::shared_mutex> lock(_mutex);
+        std::erase_if(_archives, [&filename](const auto& archive) { return archive.first == filename; });
+        _num_archives = static_cast<uint>(_archives.size());
+    }
+
+    bool VirtualFileSystem::mounted()
+    {
+        return _num_archives > 0;
+    }
+
+    bool VirtualFileSystem::contains(const std::string& path)
+    {
+        if (!mounted())
+            return false;
+
+        const std::string normalized = Archive::normalize(path);
+
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+        for (const auto& archive : _archives)
+            if (archive.second->contains(normalized))
+                return true;
+
+        return false;
+    }
+
+    MappedFile VirtualFileSystem::map(const std::string& path)
+    {
+        if (!mounted())
+            return MappedFile();
+
+        const std::string normalized = Archive::normalize(path);
+
+        // the last mounted archive wins
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+        for (auto it = _archives.rbegin(); it != _archives.rend(); ++it)
+        {
+            MappedFile file = it->second->map(normalized);
+            if (file.isOpen())
+                return file;
+        }
+
+        return MappedFile();
+    }
+}
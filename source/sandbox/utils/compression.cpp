@@ -0,0 +1,183 @@
+#include <sandbox/utils/compression.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace sb::utils
+{
+    // shortest match worth a back reference
+    const size_t MIN_MATCH = 4;
+
+    // the last bytes of a block are always literals, the last match starts before
+    const size_t LAST_LITERALS = 5;
+    const size_t MATCH_SEARCH_LIMIT = 12;
+
+    // largest offset of a back reference
+    const size_t MAX_DISTANCE = 65535;
+
+    // the hash table maps 4-byte sequences to their last position (16KB on the stack)
+    const uint HASH_BITS = 12;
+
+    size_t boundLZ(size_t i_size)
+    {
+        return i_size + i_size / 255 + 16;
+    }
+
+    size_t compressLZ(const uchar* i_src, size_t i_size, uchar* o_dst)
+    {
+        const uchar* ip = i_src;
+        const uchar* anchor = i_src;
+        uchar* op = o_dst;
+
+        // write a run of literals longer than 15 bytes
+        auto writeLength = [&op](size_t length)
+        {
+            for (; length >= 255; length -= 255)
+                *op++ = 255;
+            *op++ = static_cast<uchar>(length);
+        };
+
+        if (i_size > MATCH_SEARCH_LIMIT)
+        {
+            uint table[1 << HASH_BITS] = {};
+            const uchar* search_end = i_src + i_size - MATCH_SEARCH_LIMIT;
+            const uchar* match_end = i_src + i_size - LAST_LITERALS;
+
+            while (ip < search_end)
+            {
+                uint sequence;
+                std::memcpy(&sequence, ip, 4);
+
+                const uint h = (sequence * 2654435761u) >> (32 - HASH_BITS);
+                const uchar* ref = i_src + table[h];
+                table[h] = static_cast<uint>(ip - i_src);
+
+                uint candidate;
+                std::memcpy(&candidate, ref, 4);
+                if (ref >= ip || static_cast<size_t>(ip - ref) > MAX_DISTANCE || candidate != sequence)
+                {
+                    ++ip;
+                    continue;
+                }
+
+                // extend the match backwards over the pending literals, then forwards
+                while (ip > anchor && ref > i_src && ip[-1] == ref[-1])
+                {
+                    --ip;
+                    --ref;
+                }
+
+                const uchar* end = ip + MIN_MATCH;
+                for (const uchar* r = ref + MIN_MATCH; end < match_end && *end == *r; ++end, ++r);
+
+                const size_t literals = ip - anchor;
+                const size_t match = end - ip - MIN_MATCH;
+                const size_t offset = ip - ref;
+
+                uchar* token = op++;
+                *token = static_cast<uchar>(std::min<size_t>(literals, 15) << 4);
+                if (literals >= 15)
+                    writeLength(literals - 15);
+
+                std::memcpy(op, anchor, literals);
+                op += literals;
+
+                *op++ = static_cast<uchar>(offset & 0xFF);
+                *op++ = static_cast<uchar>(offset >> 8);
+
+                *token |= static_cast<uchar>(std::min<size_t>(match, 15));
+                if (match >= 15)
+                    writeLength(match - 15);
+
+                ip = end;
+                anchor = ip;
+            }
+        }
+
+        // the last sequence has literals only
+        const size_t literals = i_src + i_size - anchor;
+        *op++ = static_cast<uchar>(std::min<size_t>(literals, 15) << 4);
+        if (literals >= 15)
+            writeLength(literals - 15);
+
+        if (literals > 0)
+            std::memcpy(op, anchor, literals);
+        op += literals;
+
+        return op - o_dst;
+    }
+
+    bool decompressLZ(const uchar* i_src, size_t i_size, uchar* o_dst, size_t i_dst_size)
+    {
+        const uchar* ip = i_src;
+        const uchar* ip_end = i_src + i_size;
+        uchar* op = o_dst;
+        uchar* op_end = o_dst + i_dst_size;
+
+        // lengths longer than 15 continue with bytes of 255
+        auto readLength = [&ip, ip_end](size_t& length)
+        {
+            uchar b = 255;
+            while (b == 255)
+            {
+                if (ip >= ip_end)
+                    return false;
+                b = *ip++;
+                length += b;
+            }
+            return true;
+        };
+
+        while (ip < ip_end)
+        {
+            const uchar token = *ip++;
+
+            size_t literals = token >> 4;
+            if (literals == 15 && !readLength(literals))
+                return false;
+
+            if (literals > static_cast<size_t>(ip_end - ip) || literals > static_cast<size_t>(op_end - op))
+                return false;
+
+            if (literals > 0)
+                std::memcpy(op, ip, literals);
+            ip += literals;
+            op += literals;
+
+            // the last sequence has no match
+            if (ip == ip_end)
+                break;
+
+            if (ip_end - ip < 2)
+                return false;
+
+            const size_t offset = ip[0] | (ip[1] << 8);
+            ip += 2;
+
+            if (offset == 0 || offset > static_cast<size_t>(op - o_dst))
+                return false;
+
+            size_t match = token & 15;
+            if (match == 15 && !readLength(match))
+                return false;
+            match += MIN_MATCH;
+
+            if (match > static_cast<size_t>(op_end - op))
+                return false;
+
+            // overlapping references repeat the last bytes, so they are copied forward one by one
+            const uchar* ref = op - offset;
+            if (offset >= match)
+            {
+                std::memcpy(op, ref, match);
+                op += match;
+            }
+            else
+            {
+                for (size_t i = 0; i < match; ++i)
+                    *op++ = *ref++;
+            }
+        }
+
+        return op == op_end;
+    }
+}
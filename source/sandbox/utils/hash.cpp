@@ -0,0 +1,24 @@
+#include <sandbox/utils/hash.hpp>
+
+namespace sb::utils
+{
+    // 64-bit FNV prime
+    const ulong HASH_PRIME = 1099511628211UL;
+
+    ulong hash(const void* i_data, size_t i_size, ulong i_seed)
+    {
+        const uchar* bytes = static_cast<const uchar*>(i_data);
+        ulong h = i_seed;
+        for (size_t i = 0; i < i_size; ++i)
+        {
+            h ^= bytes[i];
+            h *= HASH_PRIME;
+        }
+        return h;
+    }
+
+    ulong hash(const std::string& i_str, ulong i_seed)
+    {
+        return hash(i_str.data(), i_str.size(), i_seed);
+    }
+}
@@ -1,8 +1,14 @@
 #include <sandbox/utils/string.hpp>
+#include <sandbox/core/types.hpp>
 #include <sstream>
 #include <iomanip>
+#include <charconv>
 #include <cmath>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace sb::utils
 {
     void trim(std::string &o_str)
@@ -54,29 +60,105 @@ namespace sb::utils
         return list;
     }
 
-    int toInt(const std::string &i_str)
+    const char* findFirstOf(const char* i_begin, const char* i_end, std::string_view i_delimiters)
     {
-        return (int)toFloat(i_str);
-    }
+        const char* p = i_begin;
 
-    float toFloat(const std::string &i_str)
-    {
-        try
-        {
-            return std::atof(i_str.c_str());
-        }
-        catch(...)
+#if defined(__SSE2__)
+        if (!i_delimiters.empty() && i_delimiters.size() <= 4)
         {
-            return std::nanf("0");
+            // unused lanes repeat the first delimiter
+            const char d0 = i_delimiters[0];
+            const __m128i c0 = _mm_set1_epi8(d0);
+            const __m128i c1 = _mm_set1_epi8(i_delimiters.size() > 1 ? i_delimiters[1] : d0);
+            const __m128i c2 = _mm_set1_epi8(i_delimiters.size() > 2 ? i_delimiters[2] : d0);
+            const __m128i c3 = _mm_set1_epi8(i_delimiters.size() > 3 ? i_delimiters[3] : d0);
+
+            for (; i_end - p >= 16; p += 16)
+            {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                const __m128i match = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, c0), _mm_cmpeq_epi8(chunk, c1)),
+                                                   _mm_or_si128(_mm_cmpeq_epi8(chunk, c2), _mm_cmpeq_epi8(chunk, c3)));
+
+                const int mask = _mm_movemask_epi8(match);
+                if (mask != 0)
+                    return p + __builtin_ctz(mask);
+            }
         }
+#endif
+
+        for (; p < i_end; ++p)
+            if (i_delimiters.find(*p) != std::string_view::npos)
+                return p;
+
+        return i_end;
+    }
+
+    Tokenizer::Tokenizer(std::string_view i_str, std::string_view i_delimiters)
+        : _pos(i_str.data())
+        , _end(i_str.data() + i_str.size())
+        , _delimiters(i_delimiters)
+    {
+        for (char c : i_delimiters)
+            _is_delimiter[static_cast<uchar>(c)] = true;
+    }
+
+    bool Tokenizer::next(std::string_view& o_token)
+    {
+        // runs of delimiters are short (eg. a space between numbers): a table lookup is enough
+        while (_pos < _end && _is_delimiter[static_cast<uchar>(*_pos)])
+            ++_pos;
+
+        if (_pos == _end)
+            return false;
+
+        const char* stop = findFirstOf(_pos, _end, _delimiters);
+        o_token = std::string_view(_pos, stop - _pos);
+        _pos = stop;
+
+        return true;
+    }
+
+    void tokenize(std::string_view i_str, std::vector<std::string_view>& o_tokens, std::string_view i_delimiters)
+    {
+        std::string_view token;
+        Tokenizer tokenizer(i_str, i_delimiters);
+        while (tokenizer.next(token))
+            o_tokens.push_back(token);
+    }
+
+    template <class T>
+    T parse(std::string_view i_str)
+    {
+        // from_chars accepts neither leading blanks nor the plus sign
+        const size_t first = i_str.find_first_not_of(" \t\r\n");
+        if (first == std::string_view::npos)
+            return T(0);
+        i_str.remove_prefix(first);
+        if (i_str.front() == '+')
+            i_str.remove_prefix(1);
+
+        T value(0);
+        std::from_chars(i_str.data(), i_str.data() + i_str.size(), value);
+        return value;
+    }
+
+    int toInt(std::string_view i_str)
+    {
+        return parse<int>(i_str);
+    }
+
+    float toFloat(std::string_view i_str)
+    {
+        return parse<float>(i_str);
     }
 
-    double toDouble(const std::string &i_str)
+    double toDouble(std::string_view i_str)
     {
-        return (double)toFloat(i_str);
+        return parse<double>(i_str);
     }
 
-    bool toBool(const std::string &i_str)
+    bool toBool(std::string_view i_str)
     {
         if (i_str == "0" || i_str == "false" || i_str == "False")
             return false;
@@ -85,17 +167,17 @@ namespace sb::utils
         return true;
     }
 
-    std::vector<int> toVeci(const std::string &i_str)
+    std::vector<int> toVeci(std::string_view i_str)
     {
         return toVec<int>(i_str);
     }
 
-    std::vector<float> toVecf(const std::string &i_str)
+    std::vector<float> toVecf(std::string_view i_str)
     {
         return toVec<float>(i_str);
     }
 
-    std::vector<double> toVecd(const std::string &i_str)
+    std::vector<double> toVecd(std::string_view i_str)
     {
         return toVec<double>(i_str);
     }
@@ -0,0 +1,83 @@
+/*
+    Pack asset files in a '.sbpak' archive.
+
+    Usage: asset_packer [--lz] <output.sbpak> <file or folder>...
+
+    Files are stored with their path relative to the working directory, as the
+    applications build it (eg. "assets/shaders/misc/quad.glsl"): run the tool from
+    the root directory. Folders are scanned recursively.
+
+    Options:
+    --lz   compress the files in 64KB blocks, kept only where they shrink enough
+*/
+#include <sandbox/utils/Archive.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace sb;
+
+int main(int argc, char* argv[])
+{
+    bool compress = false;
+    vector<string> args;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "--lz")
+            compress = true;
+        else
+            args.push_back(arg);
+    }
+
+    if (args.size() < 2)
+    {
+        cout << "Usage: " << argv[0] << " [--lz] <output" << utils::Archive::EXTENSION << "> <file or folder>..." << endl;
+        return 1;
+    }
+
+    const filesystem::path output = filesystem::absolute(args[0]);
+    vector<pair<string, string>> files;
+
+    for (size_t i = 1; i < args.size(); ++i)
+    {
+        const filesystem::path input = args[i];
+        if (filesystem::is_directory(input))
+        {
+            for (const filesystem::directory_entry& entry : filesystem::recursive_directory_iterator(input))
+                if (entry.is_regular_file() && filesystem::absolute(entry.path()) != output)
+                    files.emplace_back(utils::Archive::normalize(entry.path().string()), entry.path().string());
+        }
+        else if (filesystem::is_regular_file(input))
+        {
+            files.emplace_back(utils::Archive::normalize(input.string()), input.string());
+        }
+        else
+        {
+            cerr << "Unable to find " << input << endl;
+            return 1;
+        }
+    }
+
+    // sorted paths keep the files of a folder close in the archive
+    sort(files.begin(), files.end());
+    files.erase(unique(files.begin(), files.end()), files.end());
+
+    size_t input_size = 0;
+    for (const auto& file : files)
+        input_size += filesystem::file_size(file.second);
+
+    if (!utils::Archive::write(output.string(), files, compress))
+    {
+        cerr << "Unable to write " << args[0] << " (see sandbox.log)" << endl;
+        return 1;
+    }
+
+    cout << "[ OK ] " << files.size() << " files, " << input_size << " -> " << filesystem::file_size(output) << " bytes in " << args[0] << endl;
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+/*
+    Render a binary log as text.
+
+    Usage: log_decoder <input.sblog> [output.txt]
+
+    Each record becomes a line with the thread index, the timestamp, the
+    source location of the call site and the formatted message. Lines are
+    printed to the standard output when no output file is given.
+*/
+#include <sandbox/utils/BinaryLog.hpp>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace sb;
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2 || argc > 3)
+    {
+        cout << "Usage: " << argv[0] << " <input" << utils::BinaryLog::EXTENSION << "> [output.txt]" << endl;
+        return 1;
+    }
+
+    bool decoded;
+    if (argc == 3)
+    {
+        ofstream output(argv[2]);
+        if (!output.is_open())
+        {
+            cerr << "Unable to write " << argv[2] << endl;
+            return 1;
+        }
+        decoded = utils::BinaryLog::decode(argv[1], output);
+    }
+    else
+    {
+        decoded = utils::BinaryLog::decode(argv[1], cout);
+    }
+
+    if (!decoded)
+    {
+        cerr << "Unable to decode " << argv[1] << " completely (see sandbox.log)" << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+    Convert JPEG/PNG images to cooked '.sbtex' texture files.
+
+    Usage: texture_cooker [--flip] [--no-mipmaps] [--bc | --bc1 | --bc3 | --bc5] <image or folder>...
+
+    Each image is written next to the source file, with the '.sbtex' extension.
+    Folders are scanned recursively for '.jpg', '.jpeg' and '.png' files.
+
+    Compression options:
+    --bc   pick the format for each image: BC5 for normal maps (file name containing "normal"),
+           BC3 for images with alpha, BC1 otherwise
+    --bc1  RGB, 4 bits per pixel
+    --bc3  RGBA, 8 bits per pixel
+    --bc5  two channels (red and green), 8 bits per pixel
+*/
+#include <sandbox/graphics/TextureFile.hpp>
+#include <sandbox/graphics/BlockCompression.hpp>
+#include <sandbox/core/opengl.hpp>
+#include <externals/stb_image.h>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace sb;
+
+bool isImage(const filesystem::path& path)
+{
+    string ext = path.extension().string();
+    for (char& c : ext)
+        c = tolower(c);
+    return ext == ".jpg" || ext == ".jpeg" || ext == ".png";
+}
+
+// compression formats selectable from command line, 0 = uncompressed, 1 = automatic
+const uint AUTO_COMPRESSION = 1;
+
+string formatName(uint format)
+{
+    if (format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT)
+        return "BC1";
+    if (format == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT)
+        return "BC3";
+    if (format == GL_COMPRESSED_RG_RGTC2)
+        return "BC5";
+    return "uncompressed";
+}
+
+bool cook(const filesystem::path& path, bool flip, bool mipmaps, uint format)
+{
+    int x, y, comp;
+    stbi_set_flip_vertically_on_load(flip);
+
+    // query the number of channels first: images with alpha are stored as RGBA, all the others as RGB
+    if (!stbi_info(path.c_str(), &x, &y, &comp))
+    {
+        cerr << "Unable to read " << path << ": " << stbi_failure_reason() << endl;
+        return false;
+    }
+    int channels = (comp == 2 || comp == 4) ? 4 : 3;
+
+    if (format == AUTO_COMPRESSION)
+    {
+        if (path.filename().string().find("normal") != string::npos)
+            format = GL_COMPRESSED_RG_RGTC2;
+        else if (channels == 4)
+            format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        else
+            format = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    }
+
+    uchar* pixels = stbi_load(path.c_str(), &x, &y, &comp, channels);
+    if (pixels == nullptr)
+    {
+        cerr << "Unable to decode " << path << ": " << stbi_failure_reason() << endl;
+        return false;
+    }
+
+    filesystem::path output = path;
+    output.replace_extension(TextureFile::EXTENSION);
+
+    bool success = TextureFile::write(output.string(), pixels, x, y, channels, mipmaps, format);
+    stbi_image_free(pixels);
+
+    cout << (success ? "[ OK ] " : "[FAIL] ") << path.string() << " -> " << output.string() << " (" << x << "x" << y << "x" << channels << ", " << formatName(format) << ")" << endl;
+
+    return success;
+}
+
+int main(int argc, char* argv[])
+{
+    bool flip = false;
+    bool mipmaps = true;
+    uint format = 0;
+    vector<filesystem::path> inputs;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (arg == "--flip")
+            flip = true;
+        else if (arg == "--no-mipmaps")
+            mipmaps = false;
+        else if (arg == "--bc")
+            format = AUTO_COMPRESSION;
+        else if (arg == "--bc1")
+            format = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        else if (arg == "--bc3")
+            format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        else if (arg == "--bc5")
+            format = GL_COMPRESSED_RG_RGTC2;
+        else
+            inputs.push_back(arg);
+    }
+
+    if (inputs.empty())
+    {
+        cout << "Usage: " << argv[0] << " [--flip] [--no-mipmaps] [--bc | --bc1 | --bc3 | --bc5] <image or folder>..." << endl;
+        return 1;
+    }
+
+    int failures = 0;
+
+    for (const filesystem::path& input : inputs)
+    {
+        if (filesystem::is_directory(input))
+        {
+            for (const filesystem::directory_entry& entry : filesystem::recursive_directory_iterator(input))
+                if (entry.is_regular_file() && isImage(entry.path()))
+                    failures += cook(entry.path(), flip, mipmaps, format) ? 0 : 1;
+        }
+        else
+        {
+            failures += cook(input, flip, mipmaps, format) ? 0 : 1;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}